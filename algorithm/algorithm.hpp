@@ -0,0 +1,100 @@
+#ifndef ALGORITHM_H
+#define ALGORITHM_H
+
+#include "../iterator/iterator.hpp"
+#include "../utility.hpp"
+#include "simd.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ----------------------- FT::ALGORITHM ----------------------- *
+    *
+    * equal:                    Test whether the elements in two ranges are equal
+    * lexicographical_compare:  Lexicographical less-than comparison
+    * find:                     Find value in range
+    * count:                    Count appearances of value in range
+    *
+    * Each has a generic version and an overload for ft::iterator
+    * ranges (contiguous storage) that forwards to the ft::simd kernels.
+    * ------------------------------------------------------------- *
+    */
+
+template <class InputIterator1, class InputIterator2>
+bool equal(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2)
+{
+    for (; first1 != last1; ++first1, ++first2)
+        if (!(*first1 == *first2))
+            return false;
+    return true;
+}
+
+template <class T, bool B1, bool B2>
+bool equal(ft::iterator<std::random_access_iterator_tag, T, B1> first1,
+           ft::iterator<std::random_access_iterator_tag, T, B1> last1,
+           ft::iterator<std::random_access_iterator_tag, T, B2> first2)
+{
+    return simd::equal(first1.getPtr(), first2.getPtr(), last1 - first1);
+}
+
+template <class InputIterator1, class InputIterator2>
+bool lexicographical_compare(InputIterator1 first1, InputIterator1 last1, InputIterator2 first2, InputIterator2 last2)
+{
+    for (; first1 != last1 && first2 != last2; ++first1, ++first2)
+    {
+        if (*first1 < *first2)
+            return true;
+        if (*first2 < *first1)
+            return false;
+    }
+    return first1 == last1 && first2 != last2;
+}
+
+template <class T, bool B1, bool B2>
+bool lexicographical_compare(ft::iterator<std::random_access_iterator_tag, T, B1> first1,
+                             ft::iterator<std::random_access_iterator_tag, T, B1> last1,
+                             ft::iterator<std::random_access_iterator_tag, T, B2> first2,
+                             ft::iterator<std::random_access_iterator_tag, T, B2> last2)
+{
+    return simd::lexicographicalCompare(first1.getPtr(), last1 - first1, first2.getPtr(), last2 - first2);
+}
+
+template <class InputIterator, class T>
+InputIterator find(InputIterator first, InputIterator last, const T& val)
+{
+    for (; first != last; ++first)
+        if (*first == val)
+            break;
+    return first;
+}
+
+template <class T, bool B>
+ft::iterator<std::random_access_iterator_tag, T, B> find(ft::iterator<std::random_access_iterator_tag, T, B> first,
+                                                         ft::iterator<std::random_access_iterator_tag, T, B> last,
+                                                         const T& val)
+{
+    return ft::iterator<std::random_access_iterator_tag, T, B>(first.getPtr() + simd::find(first.getPtr(), last - first, val));
+}
+
+template <class InputIterator, class T>
+typename iterator_traits<InputIterator>::difference_type count(InputIterator first, InputIterator last, const T& val)
+{
+    typename iterator_traits<InputIterator>::difference_type res = 0;
+    for (; first != last; ++first)
+        if (*first == val)
+            ++res;
+    return res;
+}
+
+template <class T, bool B>
+typename ft::iterator<std::random_access_iterator_tag, T, B>::difference_type
+    count(ft::iterator<std::random_access_iterator_tag, T, B> first,
+          ft::iterator<std::random_access_iterator_tag, T, B> last,
+          const T& val)
+{
+    return simd::count(first.getPtr(), last - first, val);
+}
+
+}
+
+#endif
@@ -0,0 +1,156 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include "../concurrency/thread_pool.hpp"
+#include "../containers/vector.hpp"
+#include "../utility.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ----------------------- FT::PARALLEL ------------------------ *
+    *
+    * parallel_for:     Call body(first, last) on pieces of the range
+    *                   of at most grain elements, spread over the
+    *                   workers of a thread_pool
+    * parallel_reduce:  op-fold of the range, each piece folded on its
+    *                   own then the partial results combined left to
+    *                   right, so op only has to be associative
+    *
+    * The range is split in halves by the tasks themselves: each task
+    * spawns its right half and keeps the left one, so idle workers
+    * steal the largest pieces left and load balances on its own.
+    * Ranges are random access iterators or plain integer indices.
+    * body and op are shared by every piece, called concurrently on
+    * disjoint pieces, and must not throw. Without a pool argument
+    * thread_pool::shared() is used. Needs -pthread.
+    * ------------------------------------------------------------- *
+    */
+
+namespace parallel {
+
+// pieces per worker when no grain is given, enough for stealing to even out uneven pieces
+static const size_t PIECES_PER_THREAD = 8;
+static const size_t MIN_REDUCE_GRAIN = 4096;
+
+template <class RandomIt, class Body>
+class forTask : public task
+{
+public:
+    forTask(RandomIt first, RandomIt last, size_t grain, const Body& body, thread_pool& pool, task_latch& latch)
+        : _first(first), _last(last), _grain(grain), _body(body), _pool(pool), _latch(latch) {}
+
+    void run() {
+        while (static_cast<size_t>(_last - _first) > _grain)
+        {
+            RandomIt mid = _first + (_last - _first) / 2;
+            _latch.add(1);
+            _pool.spawn(new forTask(mid, _last, _grain, _body, _pool, _latch));
+            _last = mid;
+        }
+        _body(_first, _last);
+        _latch.count_down();
+    }
+
+private:
+    RandomIt _first;
+    RandomIt _last;
+    size_t _grain;
+    const Body& _body;
+    thread_pool& _pool;
+    task_latch& _latch;
+};
+
+// folds the pieces [c0, c1) of the range into partials[c0, c1)
+template <class RandomIt, class T, class BinaryOp>
+class reducePieces
+{
+public:
+    reducePieces(RandomIt first, size_t size, size_t grain, T* partials, BinaryOp op)
+        : _first(first), _size(size), _grain(grain), _partials(partials), _op(op) {}
+
+    void operator()(size_t c0, size_t c1) const {
+        for (size_t c = c0; c < c1; ++c)
+        {
+            RandomIt it = _first + c * _grain;
+            RandomIt end = it + std::min(_grain, _size - c * _grain);
+            T acc = *it;
+            for (++it; it != end; ++it)
+                acc = _op(acc, *it);
+            _partials[c] = acc;
+        }
+    }
+
+private:
+    RandomIt _first;
+    size_t _size;
+    size_t _grain;
+    T* _partials;
+    BinaryOp _op;
+};
+
+inline size_t defaultGrain(size_t n, const thread_pool& pool, size_t minimum)
+{
+    return std::max(n / (pool.size() * PIECES_PER_THREAD), minimum);
+}
+}
+
+// grain 0: about PIECES_PER_THREAD pieces per worker
+template <class RandomIt, class Body>
+void parallel_for(thread_pool& pool, RandomIt first, RandomIt last, const Body& body, size_t grain = 0)
+{
+    if (first == last)
+        return;
+    size_t n = last - first;
+    if (!grain)
+        grain = parallel::defaultGrain(n, pool, 1);
+    if (n <= grain)
+    {
+        body(first, last);
+        return;
+    }
+    task_latch latch(1);
+    pool.spawn(new parallel::forTask<RandomIt, Body>(first, last, grain, body, pool, latch));
+    pool.wait(latch);
+}
+
+template <class RandomIt, class Body>
+void parallel_for(RandomIt first, RandomIt last, const Body& body, size_t grain = 0)
+{
+    parallel_for(thread_pool::shared(), first, last, body, grain);
+}
+
+// grain 0: about PIECES_PER_THREAD pieces per worker, never under MIN_REDUCE_GRAIN elements
+template <class RandomIt, class T, class BinaryOp>
+T parallel_reduce(thread_pool& pool, RandomIt first, RandomIt last, T init, BinaryOp op, size_t grain = 0)
+{
+    if (first == last)
+        return init;
+    size_t n = last - first;
+    if (!grain)
+        grain = parallel::defaultGrain(n, pool, parallel::MIN_REDUCE_GRAIN);
+    size_t pieces = (n + grain - 1) / grain;
+    ft::vector<T> partials(pieces, init);
+    parallel_for(pool, size_t(0), pieces, parallel::reducePieces<RandomIt, T, BinaryOp>(first, n, grain, &partials[0], op), 1);
+    for (size_t c = 0; c < pieces; ++c)
+        init = op(init, partials[c]);
+    return init;
+}
+
+template <class RandomIt, class T, class BinaryOp>
+T parallel_reduce(RandomIt first, RandomIt last, T init, BinaryOp op, size_t grain = 0)
+{
+    return parallel_reduce(thread_pool::shared(), first, last, init, op, grain);
+}
+
+// sum, with ft::plus
+template <class RandomIt, class T>
+T parallel_reduce(RandomIt first, RandomIt last, T init)
+{
+    return parallel_reduce(thread_pool::shared(), first, last, init, ft::plus<T>());
+}
+
+}
+
+#endif
@@ -0,0 +1,448 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+#include <cstring>
+#include "../utility.hpp"
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+# define FT_SIMD_X86 1
+# include <immintrin.h>
+#else
+# define FT_SIMD_X86 0
+#endif
+
+namespace ft {
+namespace simd {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::SIMD -------------------------- *
+    *
+    * Kernels behind ft::equal, ft::lexicographical_compare, ft::find
+    * and ft::count on contiguous ranges.
+    *
+    * - Integral elements are compared as raw bytes: two integers are
+    *   equal iff their bytes are. equal goes through memcmp, mismatch,
+    *   find and count use AVX2 when the cpu has it (checked once at
+    *   runtime) and the scalar loops otherwise.
+    * - search finds a substring (basic_string::find); on bytes with AVX2 it keeps the
+    *   positions whose first and last bytes both match, 32 at a time,
+    *   and memcmp checks the middle.
+    * - float and double equality use SSE2 lanes (ieee semantics kept:
+    *   NaN != NaN, 0.0 == -0.0).
+    * - Any other element type falls back to the scalar loops.
+    * - popcount over 64 bits words uses the popcnt instruction when
+    *   available, a SWAR fallback otherwise.
+    * ------------------------------------------------------------- *
+    */
+
+inline bool hasAvx2()
+{
+#if FT_SIMD_X86
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+inline bool hasPopcnt()
+{
+#if FT_SIMD_X86
+    static const bool supported = __builtin_cpu_supports("popcnt");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+// word kernels, used by the bit-packed vector<bool>
+
+inline size_t popcountWord(unsigned long long x)
+{
+    x = x - ((x >> 1) & 0x5555555555555555ULL);
+    x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+    x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+    return static_cast<size_t>((x * 0x0101010101010101ULL) >> 56);
+}
+
+// x must not be 0
+inline size_t countTrailingZeros(unsigned long long x)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    size_t n = 0;
+    for (; !(x & 1); x >>= 1)
+        ++n;
+    return n;
+#endif
+}
+
+#if FT_SIMD_X86
+__attribute__((target("popcnt")))
+inline size_t hwPopcount(const unsigned long long* words, size_t n)
+{
+    size_t res = 0;
+    for (size_t i = 0; i < n; ++i)
+        res += __builtin_popcountll(words[i]);
+    return res;
+}
+#endif
+
+inline size_t popcount(const unsigned long long* words, size_t n)
+{
+#if FT_SIMD_X86
+    if (hasPopcnt())
+        return hwPopcount(words, n);
+#endif
+    size_t res = 0;
+    for (size_t i = 0; i < n; ++i)
+        res += popcountWord(words[i]);
+    return res;
+}
+
+// scalar kernels, valid for any element type
+
+template <class T>
+bool scalarEqual(const T* a, const T* b, size_t n)
+{
+    for (size_t i = 0; i < n; ++i)
+        if (!(a[i] == b[i]))
+            return false;
+    return true;
+}
+
+template <class T>
+size_t scalarMismatch(const T* a, const T* b, size_t n)
+{
+    size_t i = 0;
+    while (i < n && a[i] == b[i])
+        ++i;
+    return i;
+}
+
+template <class T>
+size_t scalarFind(const T* p, size_t n, const T& val)
+{
+    size_t i = 0;
+    while (i < n && !(p[i] == val))
+        ++i;
+    return i;
+}
+
+template <class T>
+size_t scalarCount(const T* p, size_t n, const T& val)
+{
+    size_t res = 0;
+    for (size_t i = 0; i < n; ++i)
+        if (p[i] == val)
+            ++res;
+    return res;
+}
+
+// first i with p[i, i + m) == s[0, m), n when there is none; 0 < m <= n
+template <class T>
+size_t scalarSearch(const T* p, size_t n, const T* s, size_t m)
+{
+    for (size_t i = 0; i + m <= n; ++i)
+        if (p[i] == s[0] && scalarEqual(p + i + 1, s + 1, m - 1))
+            return i;
+    return n;
+}
+
+template <class T>
+bool scalarLexicographicalCompare(const T* a, size_t na, const T* b, size_t nb)
+{
+    size_t n = na < nb ? na : nb;
+    for (size_t i = 0; i < n; ++i)
+    {
+        if (a[i] < b[i])
+            return true;
+        if (b[i] < a[i])
+            return false;
+    }
+    return na < nb;
+}
+
+#if FT_SIMD_X86
+
+// lanes of size bytes set to all ones where a and b are equal
+__attribute__((target("avx2")))
+inline __m256i avx2EqualLanes(__m256i a, __m256i b, size_t size)
+{
+    switch (size)
+    {
+        case 2:     return _mm256_cmpeq_epi16(a, b);
+        case 4:     return _mm256_cmpeq_epi32(a, b);
+        case 8:     return _mm256_cmpeq_epi64(a, b);
+        default:    return _mm256_cmpeq_epi8(a, b);
+    }
+}
+
+// a 1 in the lowest byte of every lane of size bytes
+__attribute__((target("avx2")))
+inline __m256i avx2LaneOnes(size_t size)
+{
+    switch (size)
+    {
+        case 2:     return _mm256_set1_epi16(1);
+        case 4:     return _mm256_set1_epi32(1);
+        case 8:     return _mm256_set1_epi64x(1);
+        default:    return _mm256_set1_epi8(1);
+    }
+}
+
+// bytes must be a multiple of 32; returns the offset of the first differing byte, or bytes
+__attribute__((target("avx2")))
+inline size_t avx2MismatchBytes(const unsigned char* a, const unsigned char* b, size_t bytes)
+{
+    for (size_t i = 0; i < bytes; i += 32)
+    {
+        __m256i va = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+        __m256i vb = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+        unsigned diff = ~static_cast<unsigned>(_mm256_movemask_epi8(_mm256_cmpeq_epi8(va, vb)));
+        if (diff)
+            return i + __builtin_ctz(diff);
+    }
+    return bytes;
+}
+
+// pattern holds the searched value repeated over 32 bytes; returns the byte offset of the first match, or bytes
+__attribute__((target("avx2")))
+inline size_t avx2FindBytes(const unsigned char* p, size_t bytes, const unsigned char* pattern, size_t size)
+{
+    __m256i needle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+    for (size_t i = 0; i < bytes; i += 32)
+    {
+        __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        unsigned hits = static_cast<unsigned>(_mm256_movemask_epi8(avx2EqualLanes(v, needle, size)));
+        if (hits)
+            return i + __builtin_ctz(hits);
+    }
+    return bytes;
+}
+
+// substring search, 2 <= m <= bytes: 32 starting positions at a time are kept when both their first
+// and last bytes match s, then memcmp checks the middle. i is where the scan starts, it is left
+// on the first position the full blocks did not cover; returns the match or bytes
+__attribute__((target("avx2")))
+inline size_t avx2SearchBytes(const unsigned char* p, size_t bytes, const unsigned char* s, size_t m, size_t& i)
+{
+    __m256i first = _mm256_set1_epi8(static_cast<char>(s[0]));
+    __m256i last = _mm256_set1_epi8(static_cast<char>(s[m - 1]));
+    for (; i + m - 1 + 32 <= bytes; i += 32)
+    {
+        __m256i head = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+        __m256i tail = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i + m - 1));
+        unsigned hits = static_cast<unsigned>(_mm256_movemask_epi8(
+            _mm256_and_si256(_mm256_cmpeq_epi8(head, first), _mm256_cmpeq_epi8(tail, last))));
+        for (; hits; hits &= hits - 1)
+        {
+            size_t at = i + __builtin_ctz(hits);
+            if (m < 3 || std::memcmp(p + at + 1, s + 1, m - 2) == 0)
+                return at;
+        }
+    }
+    return bytes;
+}
+
+// every matching lane adds 1 to a byte counter, flushed into 64 bits sums before it can wrap
+__attribute__((target("avx2")))
+inline size_t avx2CountBytes(const unsigned char* p, size_t bytes, const unsigned char* pattern, size_t size)
+{
+    __m256i needle = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pattern));
+    __m256i ones = avx2LaneOnes(size);
+    __m256i zero = _mm256_setzero_si256();
+    __m256i total = zero;
+    size_t i = 0;
+    while (i < bytes)
+    {
+        size_t end = (bytes - i > 255 * 32) ? i + 255 * 32 : bytes;
+        __m256i acc = zero;
+        for (; i < end; i += 32)
+        {
+            __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+            acc = _mm256_add_epi8(acc, _mm256_and_si256(avx2EqualLanes(v, needle, size), ones));
+        }
+        total = _mm256_add_epi64(total, _mm256_sad_epu8(acc, zero));
+    }
+    return static_cast<size_t>(_mm256_extract_epi64(total, 0) + _mm256_extract_epi64(total, 1)
+        + _mm256_extract_epi64(total, 2) + _mm256_extract_epi64(total, 3));
+}
+
+template <class T>
+void splat(unsigned char* pattern, const T& val)
+{
+    for (size_t i = 0; i < 32; i += sizeof(T))
+        std::memcpy(pattern + i, &val, sizeof(T));
+}
+
+#endif
+
+// integral kernels
+
+template <class T>
+typename ft::enable_if<ft::is_integral<T>::value, bool>::type
+    equal(const T* a, const T* b, size_t n)
+{
+    return !n || std::memcmp(a, b, n * sizeof(T)) == 0;
+}
+
+template <class T>
+typename ft::enable_if<ft::is_integral<T>::value, size_t>::type
+    mismatch(const T* a, const T* b, size_t n)
+{
+    size_t i = 0;
+#if FT_SIMD_X86
+    if (hasAvx2())
+    {
+        size_t bytes = n * sizeof(T) / 32 * 32;
+        size_t at = avx2MismatchBytes(reinterpret_cast<const unsigned char*>(a), reinterpret_cast<const unsigned char*>(b), bytes);
+        if (at != bytes)
+            return at / sizeof(T);
+        i = bytes / sizeof(T);
+    }
+#endif
+    return i + scalarMismatch(a + i, b + i, n - i);
+}
+
+template <class T>
+typename ft::enable_if<ft::is_integral<T>::value, size_t>::type
+    find(const T* p, size_t n, const T& val)
+{
+    size_t i = 0;
+#if FT_SIMD_X86
+    if (hasAvx2())
+    {
+        unsigned char pattern[32];
+        splat(pattern, val);
+        size_t bytes = n * sizeof(T) / 32 * 32;
+        size_t at = avx2FindBytes(reinterpret_cast<const unsigned char*>(p), bytes, pattern, sizeof(T));
+        if (at != bytes)
+            return at / sizeof(T);
+        i = bytes / sizeof(T);
+    }
+#endif
+    return i + scalarFind(p + i, n - i, val);
+}
+
+template <class T>
+typename ft::enable_if<ft::is_integral<T>::value, size_t>::type
+    count(const T* p, size_t n, const T& val)
+{
+    size_t i = 0;
+    size_t res = 0;
+#if FT_SIMD_X86
+    if (hasAvx2())
+    {
+        unsigned char pattern[32];
+        splat(pattern, val);
+        size_t bytes = n * sizeof(T) / 32 * 32;
+        res = avx2CountBytes(reinterpret_cast<const unsigned char*>(p), bytes, pattern, sizeof(T));
+        i = bytes / sizeof(T);
+    }
+#endif
+    return res + scalarCount(p + i, n - i, val);
+}
+
+template <class T>
+typename ft::enable_if<ft::is_integral<T>::value, bool>::type
+    lexicographicalCompare(const T* a, size_t na, const T* b, size_t nb)
+{
+    size_t n = na < nb ? na : nb;
+    size_t i = mismatch(a, b, n);
+    if (i != n)
+        return a[i] < b[i];
+    return na < nb;
+}
+
+// first i with p[i, i + m) == s[0, m), n when there is none
+template <class T>
+typename ft::enable_if<ft::is_integral<T>::value, size_t>::type
+    search(const T* p, size_t n, const T* s, size_t m)
+{
+    if (m > n)
+        return n;
+    if (!m)
+        return 0;
+    size_t i = 0;
+#if FT_SIMD_X86
+    if (sizeof(T) == 1 && m > 1 && hasAvx2())
+    {
+        size_t at = avx2SearchBytes(reinterpret_cast<const unsigned char*>(p), n, reinterpret_cast<const unsigned char*>(s), m, i);
+        if (at != n)
+            return at;
+    }
+#endif
+    size_t at = scalarSearch(p + i, n - i, s, m);
+    return at == n - i ? n : i + at;
+}
+
+// generic kernels
+
+template <class T>
+typename ft::enable_if<!ft::is_integral<T>::value, bool>::type
+    equal(const T* a, const T* b, size_t n)
+{
+    return scalarEqual(a, b, n);
+}
+
+template <class T>
+typename ft::enable_if<!ft::is_integral<T>::value, size_t>::type
+    find(const T* p, size_t n, const T& val)
+{
+    return scalarFind(p, n, val);
+}
+
+template <class T>
+typename ft::enable_if<!ft::is_integral<T>::value, size_t>::type
+    count(const T* p, size_t n, const T& val)
+{
+    return scalarCount(p, n, val);
+}
+
+template <class T>
+typename ft::enable_if<!ft::is_integral<T>::value, size_t>::type
+    search(const T* p, size_t n, const T* s, size_t m)
+{
+    if (m > n)
+        return n;
+    return m ? scalarSearch(p, n, s, m) : 0;
+}
+
+template <class T>
+typename ft::enable_if<!ft::is_integral<T>::value, bool>::type
+    lexicographicalCompare(const T* a, size_t na, const T* b, size_t nb)
+{
+    return scalarLexicographicalCompare(a, na, b, nb);
+}
+
+// floating point equality
+
+inline bool equal(const float* a, const float* b, size_t n)
+{
+    size_t i = 0;
+#if FT_SIMD_X86 && defined(__SSE2__)
+    for (; i + 4 <= n; i += 4)
+        if (_mm_movemask_ps(_mm_cmpeq_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i))) != 0xF)
+            return false;
+#endif
+    return scalarEqual(a + i, b + i, n - i);
+}
+
+inline bool equal(const double* a, const double* b, size_t n)
+{
+    size_t i = 0;
+#if FT_SIMD_X86 && defined(__SSE2__)
+    for (; i + 2 <= n; i += 2)
+        if (_mm_movemask_pd(_mm_cmpeq_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i))) != 0x3)
+            return false;
+#endif
+    return scalarEqual(a + i, b + i, n - i);
+}
+
+}
+}
+
+#endif
@@ -0,0 +1,500 @@
+#ifndef SORT_H
+#define SORT_H
+
+#include <pthread.h>
+#include <unistd.h>
+#include <algorithm>
+#include "../iterator/iterator.hpp"
+#include "../containers/vector.hpp"
+#include "../utility.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::SORT -------------------------- *
+    *
+    * sort:             Introsort: median of three quicksort, heapsort
+    *                   once the recursion gets too deep, insertion sort
+    *                   for the small partitions. Not stable.
+    * stable_sort:      Bottom-up merge sort through a buffer of n elements
+    * partial_sort:     Heap select, the smallest middle - first elements
+    *                   end up sorted in [first, middle)
+    * radix_sort:       LSD radix sort, one byte per pass, for integers and
+    *                   ft::pair<integer, U> (by first only). Stable.
+    * parallel_sort:    sort on one chunk per core, then merge rounds with
+    *                   one thread per merge. Not stable.
+    *
+    * All of them take any random access iterator and an optional
+    * comparison (ft::less by default). sort and parallel_sort on an
+    * ft::iterator range of integers with ft::less pick radix_sort at
+    * compile time once the range is over RADIX_THRESHOLD elements.
+    * parallel_sort needs -pthread.
+    * ------------------------------------------------------------- *
+    */
+
+namespace sorting {
+
+static const long INSERTION_THRESHOLD = 16;
+static const long STABLE_RUN = 32;
+static const size_t RADIX_THRESHOLD = 1024;
+static const size_t PARALLEL_THRESHOLD = 1 << 16;
+static const size_t MAX_THREADS = 64;
+
+template <class RandomIt>
+void iterSwap(RandomIt a, RandomIt b)
+{
+    typename ft::iterator_traits<RandomIt>::value_type tmp = *a;
+    *a = *b;
+    *b = tmp;
+}
+
+template <class RandomIt, class Compare>
+void insertionSort(RandomIt first, RandomIt last, Compare comp)
+{
+    if (first == last)
+        return;
+    for (RandomIt i = first + 1; i != last; ++i)
+    {
+        typename ft::iterator_traits<RandomIt>::value_type val = *i;
+        RandomIt hole = i;
+        for (; hole != first && comp(val, *(hole - 1)); --hole)
+            *hole = *(hole - 1);
+        *hole = val;
+    }
+}
+
+// max-heap on first[0, len), val goes down from hole
+template <class RandomIt, class Distance, class T, class Compare>
+void siftDown(RandomIt first, Distance hole, Distance len, T val, Compare comp)
+{
+    Distance child;
+    while ((child = 2 * hole + 1) < len)
+    {
+        if (child + 1 < len && comp(first[child], first[child + 1]))
+            ++child;
+        if (!comp(val, first[child]))
+            break;
+        first[hole] = first[child];
+        hole = child;
+    }
+    first[hole] = val;
+}
+
+template <class RandomIt, class Compare>
+void makeHeap(RandomIt first, RandomIt last, Compare comp)
+{
+    typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+    typedef typename ft::iterator_traits<RandomIt>::value_type T;
+    Distance len = last - first;
+    for (Distance i = len / 2 - 1; i >= 0; --i)
+        siftDown(first, i, len, T(first[i]), comp);
+}
+
+template <class RandomIt, class Compare>
+void sortHeap(RandomIt first, RandomIt last, Compare comp)
+{
+    typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+    typedef typename ft::iterator_traits<RandomIt>::value_type T;
+    for (Distance len = last - first; len > 1; --len)
+    {
+        T val = first[len - 1];
+        first[len - 1] = *first;
+        siftDown(first, Distance(0), len - 1, val, comp);
+    }
+}
+
+// the median of three goes to *first and is the pivot; it also
+// guarantees both scans stop before leaving the range
+template <class RandomIt, class Compare>
+RandomIt partitionPivot(RandomIt first, RandomIt last, Compare comp)
+{
+    RandomIt a = first + 1;
+    RandomIt b = first + (last - first) / 2;
+    RandomIt c = last - 1;
+    if (comp(*a, *b))
+    {
+        if (comp(*b, *c))
+            iterSwap(first, b);
+        else if (comp(*a, *c))
+            iterSwap(first, c);
+        else
+            iterSwap(first, a);
+    }
+    else if (comp(*a, *c))
+        iterSwap(first, a);
+    else if (comp(*b, *c))
+        iterSwap(first, c);
+    else
+        iterSwap(first, b);
+
+    RandomIt lo = first + 1;
+    RandomIt hi = last;
+    while (true)
+    {
+        while (comp(*lo, *first))
+            ++lo;
+        --hi;
+        while (comp(*first, *hi))
+            --hi;
+        if (!(lo < hi))
+            return lo;
+        iterSwap(lo, hi);
+        ++lo;
+    }
+}
+
+template <class RandomIt, class Compare>
+void introsortLoop(RandomIt first, RandomIt last, size_t depth, Compare comp)
+{
+    while (last - first > INSERTION_THRESHOLD)
+    {
+        if (!depth)
+        {
+            makeHeap(first, last, comp);
+            sortHeap(first, last, comp);
+            return;
+        }
+        --depth;
+        RandomIt cut = partitionPivot(first, last, comp);
+        introsortLoop(cut, last, depth, comp);
+        last = cut;
+    }
+}
+
+template <class RandomIt, class Compare>
+void introsort(RandomIt first, RandomIt last, Compare comp)
+{
+    size_t depth = 0;
+    for (size_t n = last - first; n > 1; n >>= 1)
+        depth += 2;
+    introsortLoop(first, last, depth, comp);
+    insertionSort(first, last, comp);
+}
+
+// stable: on ties the left run wins
+template <class InputIt, class OutputIt, class Compare>
+void mergeInto(InputIt first, InputIt middle, InputIt last, OutputIt out, Compare comp)
+{
+    InputIt left = first;
+    InputIt right = middle;
+    while (left != middle && right != last)
+    {
+        if (comp(*right, *left))
+            *out++ = *right++;
+        else
+            *out++ = *left++;
+    }
+    while (left != middle)
+        *out++ = *left++;
+    while (right != last)
+        *out++ = *right++;
+}
+
+// merges every pair of width long runs of src into dst
+template <class InputIt, class OutputIt, class Compare>
+void mergePass(InputIt src, OutputIt dst, size_t n, size_t width, Compare comp)
+{
+    for (size_t i = 0; i < n; i += 2 * width)
+    {
+        size_t middle = std::min(i + width, n);
+        size_t end = std::min(i + 2 * width, n);
+        mergeInto(src + i, src + middle, src + end, dst + i, comp);
+    }
+}
+
+// ---- radix ----
+
+// order preserving map to an unsigned key: flip the sign bit of signed types
+template <class T>
+typename ft::enable_if<ft::is_integral<T>::value, unsigned long long>::type radixKey(const T& x)
+{
+    unsigned long long key = static_cast<unsigned long long>(x);
+    if (T(-1) < T(0))
+        key ^= 1ULL << (sizeof(T) * 8 - 1);
+    return key;
+}
+
+template <class K, class V>
+unsigned long long radixKey(const ft::pair<K, V>& x) { return radixKey(x.first); }
+
+template <class T>
+struct radixBytes { static const size_t value = sizeof(T); };
+
+template <class K, class V>
+struct radixBytes<ft::pair<K, V> > { static const size_t value = sizeof(K); };
+
+template <class T>
+void radixSort(T* data, size_t n)
+{
+    const size_t passes = radixBytes<T>::value;
+    ft::vector<size_t> counts(passes * 256, 0);
+    for (size_t i = 0; i < n; ++i)
+    {
+        unsigned long long key = radixKey(data[i]);
+        for (size_t p = 0; p < passes; ++p)
+            ++counts[p * 256 + ((key >> (8 * p)) & 0xff)];
+    }
+
+    ft::vector<T> buffer(data, data + n);
+    T* src = data;
+    T* dst = &buffer[0];
+    for (size_t p = 0; p < passes; ++p)
+    {
+        size_t* count = &counts[p * 256];
+        // every key has the same byte here: the pass would not move anything
+        if (count[(radixKey(src[0]) >> (8 * p)) & 0xff] == n)
+            continue;
+        size_t offset = 0;
+        for (size_t b = 0; b < 256; ++b)
+        {
+            size_t c = count[b];
+            count[b] = offset;
+            offset += c;
+        }
+        for (size_t i = 0; i < n; ++i)
+            dst[count[(radixKey(src[i]) >> (8 * p)) & 0xff]++] = src[i];
+        std::swap(src, dst);
+    }
+    if (src != data)
+        for (size_t i = 0; i < n; ++i)
+            data[i] = src[i];
+}
+
+template <class T>
+typename ft::enable_if<ft::is_integral<T>::value, void>::type sortContiguous(T* first, T* last)
+{
+    if (static_cast<size_t>(last - first) >= RADIX_THRESHOLD)
+        radixSort(first, last - first);
+    else
+        introsort(first, last, ft::less<T>());
+}
+
+template <class T>
+typename ft::enable_if<!ft::is_integral<T>::value, void>::type sortContiguous(T* first, T* last)
+{
+    introsort(first, last, ft::less<T>());
+}
+
+// ---- threads ----
+
+template <class RandomIt, class Compare>
+struct sortJob {
+    RandomIt first;
+    RandomIt last;
+    Compare comp;
+
+    static void* run(void* arg);
+};
+
+template <class InputIt, class OutputIt, class Compare>
+struct mergeJob {
+    InputIt first;
+    InputIt middle;
+    InputIt last;
+    OutputIt out;
+    Compare comp;
+
+    static void* run(void* arg) {
+        mergeJob* job = static_cast<mergeJob*>(arg);
+        mergeInto(job->first, job->middle, job->last, job->out, job->comp);
+        return NULL;
+    }
+};
+
+// runs job->run(job) for every job, all but the last one on their own thread
+template <class Job>
+void runJobs(Job* jobs, size_t count)
+{
+    pthread_t threads[MAX_THREADS];
+    bool started[MAX_THREADS];
+    for (size_t i = 0; i + 1 < count; ++i)
+    {
+        started[i] = pthread_create(&threads[i], NULL, &Job::run, &jobs[i]) == 0;
+        if (!started[i])
+            Job::run(&jobs[i]);
+    }
+    if (count)
+        Job::run(&jobs[count - 1]);
+    for (size_t i = 0; i + 1 < count; ++i)
+        if (started[i])
+            pthread_join(threads[i], NULL);
+}
+
+template <class InputIt, class OutputIt, class Compare>
+void parallelMergePass(InputIt src, OutputIt dst, size_t n, size_t width, Compare comp)
+{
+    mergeJob<InputIt, OutputIt, Compare> jobs[MAX_THREADS];
+    size_t count = 0;
+    for (size_t i = 0; i < n; i += 2 * width, ++count)
+    {
+        jobs[count].first = src + i;
+        jobs[count].middle = src + std::min(i + width, n);
+        jobs[count].last = src + std::min(i + 2 * width, n);
+        jobs[count].out = dst + i;
+        jobs[count].comp = comp;
+    }
+    runJobs(jobs, count);
+}
+
+inline size_t hardwareThreads()
+{
+    long n = sysconf(_SC_NPROCESSORS_ONLN);
+    if (n < 1)
+        return 1;
+    return std::min(static_cast<size_t>(n), MAX_THREADS);
+}
+
+}
+
+template <class RandomIt, class Compare>
+void sort(RandomIt first, RandomIt last, Compare comp)
+{
+    sorting::introsort(first, last, comp);
+}
+
+template <class T>
+void sort(ft::iterator<std::random_access_iterator_tag, T, false> first,
+          ft::iterator<std::random_access_iterator_tag, T, false> last,
+          ft::less<T>)
+{
+    sorting::sortContiguous(first.getPtr(), last.getPtr());
+}
+
+template <class T>
+void sort(T* first, T* last, ft::less<T>)
+{
+    sorting::sortContiguous(first, last);
+}
+
+template <class RandomIt>
+void sort(RandomIt first, RandomIt last)
+{
+    ft::sort(first, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>());
+}
+
+template <class RandomIt, class Compare>
+void stable_sort(RandomIt first, RandomIt last, Compare comp)
+{
+    typedef typename ft::iterator_traits<RandomIt>::value_type T;
+    size_t n = last - first;
+    for (size_t i = 0; i < n; i += sorting::STABLE_RUN)
+        sorting::insertionSort(first + i, first + std::min(i + sorting::STABLE_RUN, n), comp);
+    if (n <= static_cast<size_t>(sorting::STABLE_RUN))
+        return;
+
+    ft::vector<T> buffer(first, last);
+    bool inBuffer = false;
+    for (size_t width = sorting::STABLE_RUN; width < n; width *= 2)
+    {
+        if (inBuffer)
+            sorting::mergePass(buffer.begin(), first, n, width, comp);
+        else
+            sorting::mergePass(first, buffer.begin(), n, width, comp);
+        inBuffer = !inBuffer;
+    }
+    if (inBuffer)
+        for (size_t i = 0; i < n; ++i)
+            first[i] = buffer[i];
+}
+
+template <class RandomIt>
+void stable_sort(RandomIt first, RandomIt last)
+{
+    ft::stable_sort(first, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>());
+}
+
+template <class RandomIt, class Compare>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last, Compare comp)
+{
+    typedef typename ft::iterator_traits<RandomIt>::difference_type Distance;
+    typedef typename ft::iterator_traits<RandomIt>::value_type T;
+    sorting::makeHeap(first, middle, comp);
+    for (RandomIt it = middle; it < last; ++it)
+    {
+        if (comp(*it, *first))
+        {
+            T val = *it;
+            *it = *first;
+            sorting::siftDown(first, Distance(0), Distance(middle - first), val, comp);
+        }
+    }
+    sorting::sortHeap(first, middle, comp);
+}
+
+template <class RandomIt>
+void partial_sort(RandomIt first, RandomIt middle, RandomIt last)
+{
+    ft::partial_sort(first, middle, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>());
+}
+
+template <class T>
+void radix_sort(T* first, T* last)
+{
+    if (last - first > 1)
+        sorting::radixSort(first, last - first);
+}
+
+template <class T>
+void radix_sort(ft::iterator<std::random_access_iterator_tag, T, false> first,
+                ft::iterator<std::random_access_iterator_tag, T, false> last)
+{
+    ft::radix_sort(first.getPtr(), last.getPtr());
+}
+
+template <class RandomIt, class Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp, size_t threads = 0)
+{
+    typedef typename ft::iterator_traits<RandomIt>::value_type T;
+    size_t n = last - first;
+    if (!threads)
+        threads = sorting::hardwareThreads();
+    threads = std::min(std::min(threads, sorting::MAX_THREADS), n / sorting::PARALLEL_THRESHOLD);
+    if (threads <= 1)
+    {
+        ft::sort(first, last, comp);
+        return;
+    }
+
+    sorting::sortJob<RandomIt, Compare> jobs[sorting::MAX_THREADS];
+    size_t chunk = (n + threads - 1) / threads;
+    for (size_t i = 0; i < threads; ++i)
+    {
+        jobs[i].first = first + std::min(i * chunk, n);
+        jobs[i].last = first + std::min((i + 1) * chunk, n);
+        jobs[i].comp = comp;
+    }
+    sorting::runJobs(jobs, threads);
+
+    ft::vector<T> buffer(first, last);
+    bool inBuffer = false;
+    for (size_t width = chunk; width < n; width *= 2)
+    {
+        if (inBuffer)
+            sorting::parallelMergePass(buffer.begin(), first, n, width, comp);
+        else
+            sorting::parallelMergePass(first, buffer.begin(), n, width, comp);
+        inBuffer = !inBuffer;
+    }
+    if (inBuffer)
+        for (size_t i = 0; i < n; ++i)
+            first[i] = buffer[i];
+}
+
+template <class RandomIt>
+void parallel_sort(RandomIt first, RandomIt last)
+{
+    ft::parallel_sort(first, last, ft::less<typename ft::iterator_traits<RandomIt>::value_type>());
+}
+
+// defined after ft::sort so the chunks get the radix overloads too
+template <class RandomIt, class Compare>
+void* sorting::sortJob<RandomIt, Compare>::run(void* arg)
+{
+    sortJob* job = static_cast<sortJob*>(arg);
+    ft::sort(job->first, job->last, job->comp);
+    return NULL;
+}
+
+}
+
+#endif
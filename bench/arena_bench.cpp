@@ -0,0 +1,61 @@
+#include <iostream>
+#include <time.h>
+#include "../containers/vector.hpp"
+#include "../containers/map.hpp"
+#include "../containers/stack.hpp"
+#include "../memory/arena.hpp"
+
+#define CYCLES 200
+#define COUNT 20000
+
+typedef ft::pair<const int, int> value;
+typedef ft::vector<int, ft::arena_allocator<int> > arena_vector;
+typedef ft::map<int, int, ft::less<int>, ft::arena_allocator<value> > arena_map;
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+// one batch: build a vector, a map and a stack, then drop them all
+template <typename Vector, typename Map, typename Stack>
+long batch(const Vector& emptyVector, const Map& emptyMap, const Stack& emptyStack)
+{
+	Vector vector(emptyVector);
+	Map map(emptyMap);
+	Stack stack(emptyStack);
+	for (int i = 0; i < COUNT; ++i)
+	{
+		vector.push_back(i);
+		map[(i * 7919) % COUNT] = i;
+		stack.push(i);
+	}
+	return vector.back() + map.size() + stack.top();
+}
+
+int main()
+{
+	long sum = 0;
+	std::cout << "---- " << CYCLES << " cycles of build and drop, " << COUNT << " elements ----" << std::endl;
+
+	long start = nowNs();
+	for (int i = 0; i < CYCLES; ++i)
+		sum += batch(ft::vector<int>(), ft::map<int, int>(), ft::stack<int>());
+	std::cout << "std::allocator\tms: " << (nowNs() - start) / 1000000 << std::endl;
+
+	ft::arena arena;
+	start = nowNs();
+	for (int i = 0; i < CYCLES; ++i)
+	{
+		ft::arena_allocator<int> alloc(arena);
+		sum += batch(arena_vector(alloc), arena_map(ft::less<int>(), ft::arena_allocator<value>(alloc)),
+			ft::stack<int, arena_vector>(arena_vector(alloc)));
+		arena.reset();
+	}
+	std::cout << "arena         \tms: " << (nowNs() - start) / 1000000
+		<< "\treserved KiB: " << arena.bytes_reserved() / 1024
+		<< "\t(ignore: " << sum << ")" << std::endl;
+	return (0);
+}
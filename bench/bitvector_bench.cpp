@@ -0,0 +1,84 @@
+#include <iostream>
+#include <stdlib.h>
+#include <ctime>
+#include "../containers/vector.hpp"
+
+#define COUNT (1 << 27)
+#define ROUNDS 10
+
+// what ft::vector<bool> used to be: one byte per flag
+typedef ft::vector<unsigned char> byte_flags;
+
+int main()
+{
+	srand(42);
+	ft::vector<bool> bits;
+	byte_flags bytes;
+	ft::vector<bool> other;
+	byte_flags otherBytes;
+	for (int i = 0; i < COUNT; ++i)
+	{
+		bool member = (rand() % 100) == 0;
+		bool tombstone = (rand() % 2) == 0;
+		bits.push_back(member);
+		bytes.push_back(member);
+		other.push_back(tombstone);
+		otherBytes.push_back(tombstone);
+	}
+	size_t sink = 0;
+
+	std::cout << "---- " << COUNT << " flags, " << ROUNDS << " rounds ----" << std::endl;
+	std::cout << "memory bytes   bytes: " << bytes.capacity() << "\tbits: " << bits.capacity() / 8 << std::endl;
+
+	time_t start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += ft::count(bytes.begin(), bytes.end(), static_cast<unsigned char>(1));
+	time_t generic = clock() - start;
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += bits.count();
+	std::cout << "count          bytes: " << generic << "\tbits: " << (clock() - start) << std::endl;
+
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (size_t i = 0; i < bytes.size(); ++i)
+			if (bytes[i])
+				sink += i;
+	generic = clock() - start;
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (size_t i = bits.find_first(); i != bits.size(); i = bits.find_next(i))
+			sink += i;
+	std::cout << "scan set bits  bytes: " << generic << "\tbits: " << (clock() - start) << std::endl;
+
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		byte_flags res(bytes);
+		for (size_t i = 0; i < res.size(); ++i)
+			res[i] &= otherBytes[i];
+		sink += res[r];
+	}
+	generic = clock() - start;
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		ft::vector<bool> res(bits);
+		res &= other;
+		sink += res[r];
+	}
+	std::cout << "copy and &     bytes: " << generic << "\tbits: " << (clock() - start) << std::endl;
+
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (size_t i = r; i < bytes.size(); ++i)
+			bytes[i] = 1;
+	generic = clock() - start;
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		bits.set(r, bits.size());
+	std::cout << "set range      bytes: " << generic << "\tbits: " << (clock() - start) << std::endl;
+
+	std::cout << "(ignore: " << sink << ")" << std::endl;
+	return (0);
+}
@@ -0,0 +1,87 @@
+#include <iostream>
+#include <pthread.h>
+#include <time.h>
+#include "../containers/stack.hpp"
+#include "../containers/concurrent_stack.hpp"
+
+#define PAIRS_PER_THREAD 200000
+#define MAX_THREADS 64
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+struct locked_stack
+{
+	pthread_mutex_t lock;
+	ft::stack<int> stack;
+
+	locked_stack() { pthread_mutex_init(&lock, NULL); }
+	~locked_stack() { pthread_mutex_destroy(&lock); }
+
+	void push(int val)
+	{
+		pthread_mutex_lock(&lock);
+		stack.push(val);
+		pthread_mutex_unlock(&lock);
+	}
+
+	bool try_pop(int& out)
+	{
+		pthread_mutex_lock(&lock);
+		bool found = !stack.empty();
+		if (found)
+		{
+			out = stack.top();
+			stack.pop();
+		}
+		pthread_mutex_unlock(&lock);
+		return found;
+	}
+};
+
+// free list pattern: take a slot, put it back
+template <typename Stack>
+void* worker(void* arg)
+{
+	Stack* stack = static_cast<Stack*>(arg);
+	int val;
+	for (int i = 0; i < PAIRS_PER_THREAD; ++i)
+	{
+		stack->push(i);
+		stack->try_pop(val);
+	}
+	return NULL;
+}
+
+template <typename Stack>
+double run(int threads)
+{
+	Stack stack;
+	pthread_t ids[MAX_THREADS];
+	long start = nowNs();
+	for (int t = 0; t < threads; ++t)
+		pthread_create(&ids[t], NULL, &worker<Stack>, &stack);
+	for (int t = 0; t < threads; ++t)
+		pthread_join(ids[t], NULL);
+	long ns = nowNs() - start;
+	return 2.0 * PAIRS_PER_THREAD * threads / ns * 1000;
+}
+
+int main()
+{
+	std::cout << "---- push + try_pop pairs, " << PAIRS_PER_THREAD << " per thread, Mops/s ----" << std::endl;
+	for (int threads = 1; threads <= MAX_THREADS; threads *= 2)
+	{
+		double locked = run<locked_stack>(threads);
+		double lockFree = run<ft::concurrent_stack<int> >(threads);
+		std::cout << threads << " threads"
+			<< "\tmutex + ft::stack: " << locked
+			<< "\tft::concurrent_stack: " << lockFree
+			<< "\tratio: " << lockFree / locked << std::endl;
+	}
+	return (0);
+}
@@ -0,0 +1,621 @@
+#include <vector>
+#include <map>
+#include <stack>
+#include <cstdlib>
+#include "harness.hpp"
+#include "../containers/vector.hpp"
+#include "../containers/map.hpp"
+#include "../containers/stack.hpp"
+
+// ./container_bench.out [harness options], see harness.hpp; --n is the element count
+#define DEFAULT_N 100000
+// operations that are linear in ft::map run on fewer queries
+#define SLOW_QUERIES 100
+#define MIDDLE_INSERTS 100
+#define SMALL_CALLS 1000
+
+typedef ft::vector<int>			ft_vector;
+typedef std::vector<int>		std_vector;
+typedef ft::map<int, int>		ft_map;
+typedef std::map<int, int>		std_map;
+// each stack on its library's default container, what a user gets
+typedef ft::stack<int>			ft_stack;
+typedef std::stack<int>			std_stack;
+
+static std::vector<int> randomInts(size_t n, unsigned seed)
+{
+	srand(seed);
+	std::vector<int> v(n);
+	for (size_t i = 0; i < n; ++i)
+		v[i] = rand();
+	return v;
+}
+
+// distinct keys in random order: ft::map is not balanced, sorted keys would build a list
+static std::vector<int> shuffledKeys(size_t n, unsigned seed)
+{
+	std::vector<int> v(n);
+	for (size_t i = 0; i < n; ++i)
+		v[i] = static_cast<int>(i * 2);
+	srand(seed);
+	for (size_t i = n; i > 1; --i)
+		std::swap(v[i - 1], v[rand() % i]);
+	return v;
+}
+
+/* -------------------------------- vector -------------------------------- */
+
+template <class V>
+struct vectorCase
+{
+	std::vector<int> input;
+	V src;
+	V v;
+
+	explicit vectorCase(size_t n) : input(randomInts(n, 1)), src(input.begin(), input.end()) {}
+
+	size_t n() const { return input.size(); }
+	void setup() { v = src; }
+	size_t ops() const { return n(); }
+};
+
+template <class V> struct vecCtorFill : vectorCase<V> {
+	explicit vecCtorFill(size_t n) : vectorCase<V>(n) {}
+	void run() { V v(this->n(), 7); bench::keep(v); }
+};
+template <class V> struct vecCtorRange : vectorCase<V> {
+	explicit vecCtorRange(size_t n) : vectorCase<V>(n) {}
+	void run() { V v(this->input.begin(), this->input.end()); bench::keep(v); }
+};
+template <class V> struct vecCopy : vectorCase<V> {
+	explicit vecCopy(size_t n) : vectorCase<V>(n) {}
+	void run() { V v(this->src); bench::keep(v); }
+};
+template <class V> struct vecAssignOp : vectorCase<V> {
+	explicit vecAssignOp(size_t n) : vectorCase<V>(n) {}
+	void setup() { V().swap(this->v); }
+	void run() { this->v = this->src; bench::keep(this->v); }
+};
+template <class V> struct vecIterate : vectorCase<V> {
+	explicit vecIterate(size_t n) : vectorCase<V>(n) {}
+	void run() {
+		long sum = 0;
+		for (typename V::iterator it = this->v.begin(); it != this->v.end(); ++it)
+			sum += *it;
+		bench::keep(sum);
+	}
+};
+template <class V> struct vecReverseIterate : vectorCase<V> {
+	explicit vecReverseIterate(size_t n) : vectorCase<V>(n) {}
+	void run() {
+		long sum = 0;
+		for (typename V::reverse_iterator it = this->v.rbegin(); it != this->v.rend(); ++it)
+			sum += *it;
+		bench::keep(sum);
+	}
+};
+// size, max_size, capacity and empty together: each alone is below the clock resolution
+template <class V> struct vecObservers : vectorCase<V> {
+	explicit vecObservers(size_t n) : vectorCase<V>(n) {}
+	void run() {
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+		{
+			size_t s = this->v.size() + this->v.max_size() + this->v.capacity() + this->v.empty();
+			bench::keep(s);
+		}
+	}
+	size_t ops() const { return SMALL_CALLS; }
+};
+template <class V> struct vecResize : vectorCase<V> {
+	explicit vecResize(size_t n) : vectorCase<V>(n) {}
+	void setup() { V().swap(this->v); }
+	void run() { this->v.resize(this->n()); bench::keep(this->v); }
+};
+template <class V> struct vecReserve : vectorCase<V> {
+	explicit vecReserve(size_t n) : vectorCase<V>(n) {}
+	void setup() { V().swap(this->v); }
+	void run() { this->v.reserve(this->n()); bench::keep(this->v); }
+	size_t ops() const { return 1; }
+};
+template <class V> struct vecIndex : vectorCase<V> {
+	std::vector<int> where;
+	explicit vecIndex(size_t n) : vectorCase<V>(n), where(randomInts(n, 2)) {}
+	void run() {
+		long sum = 0;
+		for (size_t i = 0; i < this->n(); ++i)
+			sum += this->v[this->where[i] % this->n()];
+		bench::keep(sum);
+	}
+};
+template <class V> struct vecAt : vectorCase<V> {
+	std::vector<int> where;
+	explicit vecAt(size_t n) : vectorCase<V>(n), where(randomInts(n, 2)) {}
+	void run() {
+		long sum = 0;
+		for (size_t i = 0; i < this->n(); ++i)
+			sum += this->v.at(this->where[i] % this->n());
+		bench::keep(sum);
+	}
+};
+template <class V> struct vecFrontBack : vectorCase<V> {
+	explicit vecFrontBack(size_t n) : vectorCase<V>(n) {}
+	void run() {
+		long sum = 0;
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+		{
+			sum += this->v.front() + this->v.back();
+			bench::keep(sum);
+		}
+	}
+	size_t ops() const { return SMALL_CALLS; }
+};
+template <class V> struct vecAssignFill : vectorCase<V> {
+	explicit vecAssignFill(size_t n) : vectorCase<V>(n) {}
+	void run() { this->v.assign(this->n(), 3); bench::keep(this->v); }
+};
+template <class V> struct vecAssignRange : vectorCase<V> {
+	explicit vecAssignRange(size_t n) : vectorCase<V>(n) {}
+	void run() { this->v.assign(this->input.begin(), this->input.end()); bench::keep(this->v); }
+};
+template <class V> struct vecPushBack : vectorCase<V> {
+	explicit vecPushBack(size_t n) : vectorCase<V>(n) {}
+	void setup() { V().swap(this->v); }
+	void run() {
+		for (size_t i = 0; i < this->n(); ++i)
+			this->v.push_back(static_cast<int>(i));
+		bench::keep(this->v);
+	}
+};
+template <class V> struct vecPopBack : vectorCase<V> {
+	explicit vecPopBack(size_t n) : vectorCase<V>(n) {}
+	void run() {
+		for (size_t i = 0; i < this->n(); ++i)
+			this->v.pop_back();
+		bench::keep(this->v);
+	}
+};
+template <class V> struct vecInsertOne : vectorCase<V> {
+	explicit vecInsertOne(size_t n) : vectorCase<V>(n) {}
+	void run() {
+		for (size_t i = 0; i < MIDDLE_INSERTS; ++i)
+			this->v.insert(this->v.begin() + this->v.size() / 2, static_cast<int>(i));
+		bench::keep(this->v);
+	}
+	size_t ops() const { return MIDDLE_INSERTS; }
+};
+template <class V> struct vecInsertFill : vectorCase<V> {
+	explicit vecInsertFill(size_t n) : vectorCase<V>(n) {}
+	void run() { this->v.insert(this->v.begin() + this->n() / 2, this->n(), 5); bench::keep(this->v); }
+};
+template <class V> struct vecInsertRange : vectorCase<V> {
+	explicit vecInsertRange(size_t n) : vectorCase<V>(n) {}
+	void run() { this->v.insert(this->v.begin() + this->n() / 2, this->input.begin(), this->input.end()); bench::keep(this->v); }
+};
+template <class V> struct vecEraseOne : vectorCase<V> {
+	explicit vecEraseOne(size_t n) : vectorCase<V>(n) {}
+	void run() {
+		for (size_t i = 0; i < MIDDLE_INSERTS; ++i)
+			this->v.erase(this->v.begin() + this->v.size() / 2);
+		bench::keep(this->v);
+	}
+	size_t ops() const { return MIDDLE_INSERTS; }
+};
+template <class V> struct vecEraseRange : vectorCase<V> {
+	explicit vecEraseRange(size_t n) : vectorCase<V>(n) {}
+	void run() { this->v.erase(this->v.begin() + this->n() / 4, this->v.begin() + 3 * this->n() / 4); bench::keep(this->v); }
+	size_t ops() const { return this->n() / 2; }
+};
+template <class V> struct vecSwap : vectorCase<V> {
+	V other;
+	explicit vecSwap(size_t n) : vectorCase<V>(n), other(n / 2, 1) {}
+	void run() {
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+			this->v.swap(other);
+		bench::keep(this->v);
+	}
+	size_t ops() const { return SMALL_CALLS; }
+};
+template <class V> struct vecSwapNonMember : vecSwap<V> {
+	explicit vecSwapNonMember(size_t n) : vecSwap<V>(n) {}
+	void run() {
+		using std::swap;
+		using ft::swap;
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+			swap(this->v, this->other);
+		bench::keep(this->v);
+	}
+};
+template <class V> struct vecClear : vectorCase<V> {
+	explicit vecClear(size_t n) : vectorCase<V>(n) {}
+	void run() { this->v.clear(); bench::keep(this->v); }
+};
+// equal contents: both operators have to walk the whole vector
+template <class V> struct vecCompare : vectorCase<V> {
+	explicit vecCompare(size_t n) : vectorCase<V>(n) {}
+	void run() {
+		bool r = (this->v == this->src) && !(this->v < this->src) && (this->v <= this->src);
+		bench::keep(r);
+	}
+	size_t ops() const { return 3 * this->n(); }
+};
+
+/* --------------------------------- map ---------------------------------- */
+
+// each map's own pair type, with a non-const key so it can sit in a std::vector
+template <class M> struct pairOf;
+template <> struct pairOf<ft_map> { typedef ft::pair<int, int> type; };
+template <> struct pairOf<std_map> { typedef std::pair<int, int> type; };
+
+template <class M>
+struct mapCase
+{
+	typedef typename pairOf<M>::type pair_type;
+
+	std::vector<int> keys;
+	std::vector<int> queries;
+	// the elements of src in insertion order, the input of the range operations
+	std::vector<pair_type> pairs;
+	M src;
+	M m;
+
+	explicit mapCase(size_t n) : keys(shuffledKeys(n, 3)), queries(shuffledKeys(n, 4)) {
+		for (size_t i = 0; i < n; ++i)
+			pairs.push_back(pair_type(keys[i], static_cast<int>(i)));
+		src.insert(pairs.begin(), pairs.end());
+	}
+
+	size_t n() const { return keys.size(); }
+	void setup() { m = src; }
+	size_t ops() const { return n(); }
+};
+
+template <class M> struct mapCtorRange : mapCase<M> {
+	explicit mapCtorRange(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() { M m(this->pairs.begin(), this->pairs.end()); bench::keep(m); }
+};
+template <class M> struct mapCopy : mapCase<M> {
+	explicit mapCopy(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() { M m(this->src); bench::keep(m); }
+};
+template <class M> struct mapAssignOp : mapCase<M> {
+	explicit mapAssignOp(size_t n) : mapCase<M>(n) {}
+	void setup() { this->m.clear(); }
+	void run() { this->m = this->src; bench::keep(this->m); }
+};
+template <class M> struct mapIterate : mapCase<M> {
+	explicit mapIterate(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		long sum = 0;
+		for (typename M::const_iterator it = this->src.begin(); it != this->src.end(); ++it)
+			sum += it->second;
+		bench::keep(sum);
+	}
+};
+template <class M> struct mapReverseIterate : mapCase<M> {
+	explicit mapReverseIterate(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		long sum = 0;
+		for (typename M::const_reverse_iterator it = this->src.rbegin(); it != this->src.rend(); ++it)
+			sum += it->second;
+		bench::keep(sum);
+	}
+};
+template <class M> struct mapObservers : mapCase<M> {
+	explicit mapObservers(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+		{
+			size_t s = this->src.size() + this->src.max_size() + this->src.empty();
+			bench::keep(s);
+		}
+	}
+	size_t ops() const { return SMALL_CALLS; }
+};
+template <class M> struct mapComparators : mapCase<M> {
+	explicit mapComparators(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		typename M::value_type a(1, 1);
+		typename M::value_type b(2, 2);
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+		{
+			bool r = this->src.key_comp()(a.first, b.first) && this->src.value_comp()(a, b);
+			bench::keep(r);
+		}
+	}
+	size_t ops() const { return SMALL_CALLS; }
+};
+template <class M> struct mapIndexHit : mapCase<M> {
+	explicit mapIndexHit(size_t n) : mapCase<M>(n) {}
+	void run() {
+		long sum = 0;
+		for (size_t i = 0; i < this->n(); ++i)
+			sum += this->m[this->queries[i]];
+		bench::keep(sum);
+	}
+};
+template <class M> struct mapIndexInsert : mapCase<M> {
+	explicit mapIndexInsert(size_t n) : mapCase<M>(n) {}
+	void setup() { this->m.clear(); }
+	void run() {
+		for (size_t i = 0; i < this->n(); ++i)
+			this->m[this->keys[i]] = static_cast<int>(i);
+		bench::keep(this->m);
+	}
+};
+template <class M> struct mapInsert : mapCase<M> {
+	explicit mapInsert(size_t n) : mapCase<M>(n) {}
+	void setup() { this->m.clear(); }
+	void run() {
+		for (size_t i = 0; i < this->n(); ++i)
+			this->m.insert(typename M::value_type(this->keys[i], static_cast<int>(i)));
+		bench::keep(this->m);
+	}
+};
+// odd keys fall between the existing even ones, the hint is their successor
+template <class M> struct mapInsertHint : mapCase<M> {
+	explicit mapInsertHint(size_t n) : mapCase<M>(n) {}
+	void run() {
+		for (size_t i = 0; i < SLOW_QUERIES; ++i)
+		{
+			int key = this->queries[i] + 1;
+			this->m.insert(this->m.find(key + 1), typename M::value_type(key, 0));
+		}
+		bench::keep(this->m);
+	}
+	size_t ops() const { return SLOW_QUERIES; }
+};
+template <class M> struct mapInsertRange : mapCase<M> {
+	explicit mapInsertRange(size_t n) : mapCase<M>(n) {}
+	void setup() { this->m.clear(); }
+	void run() { this->m.insert(this->pairs.begin(), this->pairs.end()); bench::keep(this->m); }
+};
+template <class M> struct mapEraseIter : mapCase<M> {
+	explicit mapEraseIter(size_t n) : mapCase<M>(n) {}
+	void run() {
+		for (size_t i = 0; i < this->n(); ++i)
+			this->m.erase(this->m.begin());
+		bench::keep(this->m);
+	}
+};
+template <class M> struct mapEraseKey : mapCase<M> {
+	explicit mapEraseKey(size_t n) : mapCase<M>(n) {}
+	void run() {
+		for (size_t i = 0; i < this->n(); ++i)
+			this->m.erase(this->queries[i]);
+		bench::keep(this->m);
+	}
+};
+template <class M> struct mapEraseRange : mapCase<M> {
+	explicit mapEraseRange(size_t n) : mapCase<M>(n) {}
+	void run() { this->m.erase(this->m.begin(), this->m.end()); bench::keep(this->m); }
+};
+template <class M> struct mapSwap : mapCase<M> {
+	M other;
+	explicit mapSwap(size_t n) : mapCase<M>(n) { other[1] = 1; }
+	void run() {
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+			this->m.swap(other);
+		bench::keep(this->m);
+	}
+	size_t ops() const { return SMALL_CALLS; }
+};
+template <class M> struct mapSwapNonMember : mapSwap<M> {
+	explicit mapSwapNonMember(size_t n) : mapSwap<M>(n) {}
+	void run() {
+		using std::swap;
+		using ft::swap;
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+			swap(this->m, this->other);
+		bench::keep(this->m);
+	}
+};
+template <class M> struct mapClear : mapCase<M> {
+	explicit mapClear(size_t n) : mapCase<M>(n) {}
+	void run() { this->m.clear(); bench::keep(this->m); }
+};
+template <class M> struct mapFind : mapCase<M> {
+	explicit mapFind(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		long found = 0;
+		for (size_t i = 0; i < this->n(); ++i)
+			found += this->src.find(this->queries[i]) != this->src.end();
+		bench::keep(found);
+	}
+};
+template <class M> struct mapCount : mapCase<M> {
+	explicit mapCount(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		long found = 0;
+		for (size_t i = 0; i < this->n(); ++i)
+			found += this->src.count(this->queries[i] + (i & 1));
+		bench::keep(found);
+	}
+};
+template <class M> struct mapLowerBound : mapCase<M> {
+	explicit mapLowerBound(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		long found = 0;
+		for (size_t i = 0; i < SLOW_QUERIES; ++i)
+			found += this->src.lower_bound(this->queries[i] + 1) != this->src.end();
+		bench::keep(found);
+	}
+	size_t ops() const { return SLOW_QUERIES; }
+};
+template <class M> struct mapUpperBound : mapCase<M> {
+	explicit mapUpperBound(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		long found = 0;
+		for (size_t i = 0; i < SLOW_QUERIES; ++i)
+			found += this->src.upper_bound(this->queries[i]) != this->src.end();
+		bench::keep(found);
+	}
+	size_t ops() const { return SLOW_QUERIES; }
+};
+template <class M> struct mapEqualRange : mapCase<M> {
+	explicit mapEqualRange(size_t n) : mapCase<M>(n) {}
+	void setup() {}
+	void run() {
+		long found = 0;
+		for (size_t i = 0; i < SLOW_QUERIES; ++i)
+			found += this->src.equal_range(this->queries[i]).first != this->src.end();
+		bench::keep(found);
+	}
+	size_t ops() const { return SLOW_QUERIES; }
+};
+template <class M> struct mapCompare : mapCase<M> {
+	explicit mapCompare(size_t n) : mapCase<M>(n) {}
+	void run() {
+		bool r = (this->m == this->src) && !(this->m < this->src) && (this->m <= this->src);
+		bench::keep(r);
+	}
+	size_t ops() const { return 3 * this->n(); }
+};
+
+/* -------------------------------- stack --------------------------------- */
+
+template <class S>
+struct stackCase
+{
+	size_t count;
+	S full;
+	S s;
+
+	explicit stackCase(size_t n) : count(n) {
+		for (size_t i = 0; i < n; ++i)
+			full.push(static_cast<int>(i));
+	}
+
+	void setup() { s = full; }
+	size_t ops() const { return count; }
+};
+
+template <class S> struct stackCtor : stackCase<S> {
+	typename S::container_type c;
+	explicit stackCtor(size_t n) : stackCase<S>(n), c(n, 1) {}
+	void run() { S s(c); bench::keep(s); }
+};
+template <class S> struct stackPush : stackCase<S> {
+	explicit stackPush(size_t n) : stackCase<S>(n) {}
+	void setup() { this->s = S(); }
+	void run() {
+		for (size_t i = 0; i < this->count; ++i)
+			this->s.push(static_cast<int>(i));
+		bench::keep(this->s);
+	}
+};
+template <class S> struct stackTopPop : stackCase<S> {
+	explicit stackTopPop(size_t n) : stackCase<S>(n) {}
+	void run() {
+		long sum = 0;
+		for (size_t i = 0; i < this->count; ++i)
+		{
+			sum += this->s.top();
+			this->s.pop();
+		}
+		bench::keep(sum);
+	}
+};
+template <class S> struct stackObservers : stackCase<S> {
+	explicit stackObservers(size_t n) : stackCase<S>(n) {}
+	void run() {
+		for (size_t i = 0; i < SMALL_CALLS; ++i)
+		{
+			size_t r = this->s.size() + this->s.empty();
+			bench::keep(r);
+		}
+	}
+	size_t ops() const { return SMALL_CALLS; }
+};
+template <class S> struct stackCompare : stackCase<S> {
+	explicit stackCompare(size_t n) : stackCase<S>(n) {}
+	void run() {
+		bool r = (this->s == this->full) && !(this->s < this->full) && (this->s <= this->full);
+		bench::keep(r);
+	}
+	size_t ops() const { return 3 * this->count; }
+};
+
+#define BOTH(suite, op, Case, FtType, StdType) \
+	h.run(suite, op, "ft", Case<FtType>(n)); \
+	h.run(suite, op, "std", Case<StdType>(n))
+
+int main(int argc, char** argv)
+{
+	bench::options opts(DEFAULT_N);
+	if (!opts.parse(argc, argv))
+	{
+		opts.usage(argv[0]);
+		return 2;
+	}
+	bench::harness h(opts);
+	size_t n = opts.n;
+
+	BOTH("vector", "ctor_fill", vecCtorFill, ft_vector, std_vector);
+	BOTH("vector", "ctor_range", vecCtorRange, ft_vector, std_vector);
+	BOTH("vector", "copy_ctor", vecCopy, ft_vector, std_vector);
+	BOTH("vector", "operator=", vecAssignOp, ft_vector, std_vector);
+	BOTH("vector", "begin_end_iterate", vecIterate, ft_vector, std_vector);
+	BOTH("vector", "rbegin_rend_iterate", vecReverseIterate, ft_vector, std_vector);
+	BOTH("vector", "size_capacity_empty", vecObservers, ft_vector, std_vector);
+	BOTH("vector", "resize", vecResize, ft_vector, std_vector);
+	BOTH("vector", "reserve", vecReserve, ft_vector, std_vector);
+	BOTH("vector", "operator[]", vecIndex, ft_vector, std_vector);
+	BOTH("vector", "at", vecAt, ft_vector, std_vector);
+	BOTH("vector", "front_back", vecFrontBack, ft_vector, std_vector);
+	BOTH("vector", "assign_fill", vecAssignFill, ft_vector, std_vector);
+	BOTH("vector", "assign_range", vecAssignRange, ft_vector, std_vector);
+	BOTH("vector", "push_back", vecPushBack, ft_vector, std_vector);
+	BOTH("vector", "pop_back", vecPopBack, ft_vector, std_vector);
+	BOTH("vector", "insert_middle", vecInsertOne, ft_vector, std_vector);
+	BOTH("vector", "insert_fill", vecInsertFill, ft_vector, std_vector);
+	BOTH("vector", "insert_range", vecInsertRange, ft_vector, std_vector);
+	BOTH("vector", "erase_middle", vecEraseOne, ft_vector, std_vector);
+	BOTH("vector", "erase_range", vecEraseRange, ft_vector, std_vector);
+	BOTH("vector", "swap", vecSwap, ft_vector, std_vector);
+	BOTH("vector", "swap_non_member", vecSwapNonMember, ft_vector, std_vector);
+	BOTH("vector", "clear", vecClear, ft_vector, std_vector);
+	BOTH("vector", "relational", vecCompare, ft_vector, std_vector);
+
+	BOTH("map", "ctor_range", mapCtorRange, ft_map, std_map);
+	BOTH("map", "copy_ctor", mapCopy, ft_map, std_map);
+	BOTH("map", "operator=", mapAssignOp, ft_map, std_map);
+	BOTH("map", "begin_end_iterate", mapIterate, ft_map, std_map);
+	BOTH("map", "rbegin_rend_iterate", mapReverseIterate, ft_map, std_map);
+	BOTH("map", "size_empty", mapObservers, ft_map, std_map);
+	BOTH("map", "key_value_comp", mapComparators, ft_map, std_map);
+	BOTH("map", "operator[]_hit", mapIndexHit, ft_map, std_map);
+	BOTH("map", "operator[]_insert", mapIndexInsert, ft_map, std_map);
+	BOTH("map", "insert", mapInsert, ft_map, std_map);
+	BOTH("map", "insert_hint", mapInsertHint, ft_map, std_map);
+	BOTH("map", "insert_range", mapInsertRange, ft_map, std_map);
+	BOTH("map", "erase_iterator", mapEraseIter, ft_map, std_map);
+	BOTH("map", "erase_key", mapEraseKey, ft_map, std_map);
+	BOTH("map", "erase_range", mapEraseRange, ft_map, std_map);
+	BOTH("map", "swap", mapSwap, ft_map, std_map);
+	BOTH("map", "swap_non_member", mapSwapNonMember, ft_map, std_map);
+	BOTH("map", "clear", mapClear, ft_map, std_map);
+	BOTH("map", "find", mapFind, ft_map, std_map);
+	BOTH("map", "count", mapCount, ft_map, std_map);
+	BOTH("map", "lower_bound", mapLowerBound, ft_map, std_map);
+	BOTH("map", "upper_bound", mapUpperBound, ft_map, std_map);
+	BOTH("map", "equal_range", mapEqualRange, ft_map, std_map);
+	BOTH("map", "relational", mapCompare, ft_map, std_map);
+
+	BOTH("stack", "ctor", stackCtor, ft_stack, std_stack);
+	BOTH("stack", "push", stackPush, ft_stack, std_stack);
+	BOTH("stack", "top_pop", stackTopPop, ft_stack, std_stack);
+	BOTH("stack", "size_empty", stackObservers, ft_stack, std_stack);
+	BOTH("stack", "relational", stackCompare, ft_stack, std_stack);
+
+	return h.finish();
+}
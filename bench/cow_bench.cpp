@@ -0,0 +1,139 @@
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include "harness.hpp"
+#include "../containers/vector.hpp"
+#include "../containers/map.hpp"
+#include "../containers/cow_vector.hpp"
+#include "../containers/cow_map.hpp"
+
+/*
+ * ./cow_bench.out [harness options] [--copies C]
+ *
+ * Copy-on-write handoffs against deep copies. One run hands C copies
+ * (8 by default) of an n element container (--n, 100000) to readers,
+ * each copy then
+ *   copy        is dropped
+ *   copy_read   is read through: every element summed
+ *   copy_write  gets one element written: a cow copy detaches there,
+ *               so it costs a deep copy plus the sharing
+ * and reports ns per copy. Impls: cow (ft::cow_vector, ft::cow_map),
+ * ft (ft::vector, ft::map) and std.
+ */
+#define DEFAULT_N 100000
+#define DEFAULT_COPIES "8"
+
+// distinct keys in random order: ft::map is not balanced, sorted keys would build a list
+static std::vector<int> shuffledKeys(size_t n, unsigned seed)
+{
+	std::vector<int> v(n);
+	for (size_t i = 0; i < n; ++i)
+		v[i] = static_cast<int>(i);
+	srand(seed);
+	for (size_t i = n; i > 1; --i)
+		std::swap(v[i - 1], v[rand() % i]);
+	return v;
+}
+
+// how each impl is filled, read and written
+template <class V> void fillVector(V& v, size_t n) {
+	for (size_t i = 0; i < n; ++i)
+		v.push_back(static_cast<int>(i));
+}
+template <class M> void fillMap(M& m, size_t n) {
+	std::vector<int> keys = shuffledKeys(n, 1);
+	for (size_t i = 0; i < n; ++i)
+		m[keys[i]] = keys[i];
+}
+
+inline long value(int x) { return x; }
+template <class P> long value(const P& p) { return p.second; }
+
+template <class C>
+long sum(const C& c) {
+	long s = 0;
+	for (typename C::const_iterator it = c.begin(); it != c.end(); ++it)
+		s += value(*it);
+	return s;
+}
+
+template <class C>
+struct copyCase
+{
+	C src;
+	size_t copies;
+
+	copyCase(size_t n, size_t c, void (*fill)(C&, size_t)) : copies(c) { fill(src, n); }
+
+	void setup() {}
+	size_t ops() const { return copies; }
+};
+
+template <class C> struct copyOnly : copyCase<C> {
+	copyOnly(size_t n, size_t c, void (*fill)(C&, size_t)) : copyCase<C>(n, c, fill) {}
+	void run() {
+		for (size_t i = 0; i < this->copies; ++i)
+		{
+			C copy(this->src);
+			bench::keep(copy);
+		}
+	}
+};
+template <class C> struct copyRead : copyCase<C> {
+	copyRead(size_t n, size_t c, void (*fill)(C&, size_t)) : copyCase<C>(n, c, fill) {}
+	void run() {
+		long total = 0;
+		for (size_t i = 0; i < this->copies; ++i)
+		{
+			const C copy(this->src);
+			total += sum(copy);
+		}
+		bench::keep(total);
+	}
+};
+template <class C> struct copyWrite : copyCase<C> {
+	copyWrite(size_t n, size_t c, void (*fill)(C&, size_t)) : copyCase<C>(n, c, fill) {}
+	void run() {
+		for (size_t i = 0; i < this->copies; ++i)
+		{
+			C copy(this->src);
+			copy[static_cast<int>(i)] = -1;
+			bench::keep(copy);
+		}
+	}
+};
+
+#define ALL(suite, op, Case, Cow, Ft, Std, fill) \
+	h.run(suite, op, "cow", Case<Cow>(n, copies, fill<Cow>)); \
+	h.run(suite, op, "ft", Case<Ft>(n, copies, fill<Ft>)); \
+	h.run(suite, op, "std", Case<Std>(n, copies, fill<Std>))
+
+int main(int argc, char** argv)
+{
+	bench::options opts(DEFAULT_N);
+	opts.declare("--copies", DEFAULT_COPIES);
+	if (!opts.parse(argc, argv) || opts.getNumber("--copies") < 1)
+	{
+		opts.usage(argv[0]);
+		std::cerr << "  --copies C              copies handed off per run (" << DEFAULT_COPIES << ")" << std::endl;
+		return 2;
+	}
+	bench::harness h(opts);
+	size_t n = opts.n;
+	size_t copies = static_cast<size_t>(opts.getNumber("--copies"));
+
+	typedef ft::cow_vector<int> cow_vector;
+	typedef ft::vector<int> ft_vector;
+	typedef std::vector<int> std_vector;
+	typedef ft::cow_map<int, int> cow_map;
+	typedef ft::map<int, int> ft_map;
+	typedef std::map<int, int> std_map;
+
+	ALL("vector", "copy", copyOnly, cow_vector, ft_vector, std_vector, fillVector);
+	ALL("vector", "copy_read", copyRead, cow_vector, ft_vector, std_vector, fillVector);
+	ALL("vector", "copy_write", copyWrite, cow_vector, ft_vector, std_vector, fillVector);
+	ALL("map", "copy", copyOnly, cow_map, ft_map, std_map, fillMap);
+	ALL("map", "copy_read", copyRead, cow_map, ft_map, std_map, fillMap);
+	ALL("map", "copy_write", copyWrite, cow_map, ft_map, std_map, fillMap);
+	return h.finish();
+}
@@ -0,0 +1,47 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <time.h>
+#include "../containers/stack.hpp"
+#include "../containers/deque.hpp"
+
+#define COUNT (1 << 25)
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+template <typename Stack>
+void bench(const char* name)
+{
+	std::vector<long> latencies(COUNT);
+	Stack stack;
+
+	long total = nowNs();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		long start = nowNs();
+		stack.push(i);
+		latencies[i] = nowNs() - start;
+	}
+	total = nowNs() - total;
+
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << name
+		<< "\ttotal ms: " << total / 1000000
+		<< "\tp50 ns: " << latencies[COUNT / 2]
+		<< "\tp99 ns: " << latencies[COUNT / 100 * 99]
+		<< "\tp999 ns: " << latencies[COUNT / 1000 * 999]
+		<< "\tmax ns: " << latencies[COUNT - 1] << std::endl;
+}
+
+int main()
+{
+	std::cout << "---- " << COUNT << " pushes, per push latency ----" << std::endl;
+	bench<ft::stack<int> >("stack<int, vector>");
+	bench<ft::stack<int, ft::deque<int> > >("stack<int, deque> ");
+	return (0);
+}
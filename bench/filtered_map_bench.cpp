@@ -0,0 +1,196 @@
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include "harness.hpp"
+#include "../containers/filtered_map.hpp"
+#include "../containers/map.hpp"
+
+/*
+ * ./filtered_map_bench.out [harness options] [--miss-pct P] [--fpr F]
+ *
+ * Miss-heavy lookups: ft::filtered_map (an ft::map behind a blocked
+ * Bloom filter) against ft::map and std::map, n keys (--n, 1M by
+ * default) inserted in random order.
+ *
+ * suites: int (random 64-bit keys) and string (URL-like keys, 40 odd
+ * chars sharing a long prefix, so a miss compares strings all the way
+ * down the tree).
+ * ops:
+ *   find_mix    n finds, P% of them misses (--miss-pct, 80)
+ *   find_miss   n finds of absent keys
+ *   find_hit    n finds of present keys
+ *   insert      n inserts into an empty map, the filter growing along
+ * Impls: bloom (ft::filtered_map at --fpr, 0.01), ft, std.
+ *
+ * Before the timings, a table of the filter's measured false positive
+ * rate against its target, with its bits per key and probes.
+ */
+#define DEFAULT_N 1000000
+#define DEFAULT_MISS_PCT "80"
+#define DEFAULT_FPR "0.01"
+
+static std::string makeUrl(unsigned long id)
+{
+	char buf[64];
+	std::sprintf(buf, "https://shop.example.com/orders/%010lu", id);
+	return buf;
+}
+
+static unsigned long long random64()
+{
+	unsigned long long r = 0;
+	for (int i = 0; i < 4; ++i)
+		r = (r << 16) ^ static_cast<unsigned long long>(rand() & 0xFFFF);
+	return r;
+}
+
+// odd keys are inserted, even ones miss
+static void makeKeys(size_t n, std::vector<unsigned long long>& hits, std::vector<unsigned long long>& misses)
+{
+	srand(1);
+	for (size_t i = 0; i < n; ++i)
+	{
+		unsigned long long k = random64();
+		hits.push_back(k | 1);
+		misses.push_back(k & ~1ULL);
+	}
+}
+
+static void makeKeys(size_t n, std::vector<std::string>& hits, std::vector<std::string>& misses)
+{
+	std::vector<unsigned long long> ids;
+	std::vector<unsigned long long> unused;
+	makeKeys(n, ids, unused);
+	for (size_t i = 0; i < n; ++i)
+	{
+		unsigned long id = static_cast<unsigned long>(ids[i] % 4000000000ULL) | 1;
+		hits.push_back(makeUrl(id));
+		misses.push_back(makeUrl(id - 1));
+	}
+}
+
+template <class Key>
+struct keySets
+{
+	std::vector<Key> hits;
+	std::vector<Key> misses;
+	std::vector<Key> mix;
+
+	keySets(size_t n, double missPct)
+	{
+		makeKeys(n, hits, misses);
+		srand(2);
+		for (size_t i = 0; i < n; ++i)
+			mix.push_back(rand() % 100 < missPct ? misses[i] : hits[(i * 7919) % n]);
+	}
+};
+
+// every map type built the same way; fpr only reaches filtered_map
+template <class M> void configure(M&, double) {}
+template <class K, class T> void configure(ft::filtered_map<K, T>& m, double fpr) { m.set_false_positive_rate(fpr); }
+
+template <class M>
+struct mapCase
+{
+	typedef typename M::key_type key_type;
+
+	const keySets<key_type>* keys;
+	const std::vector<key_type>* queries;
+	M m;
+	bool built;
+
+	mapCase(const keySets<key_type>& k, const std::vector<key_type>& q, double fpr) : keys(&k), queries(&q), built(false) {
+		configure(m, fpr);
+	}
+
+	void setup()
+	{
+		if (built)
+			return;
+		for (size_t i = 0; i < keys->hits.size(); ++i)
+			m[keys->hits[i]] = static_cast<int>(i);
+		built = true;
+	}
+	void run() {
+		size_t found = 0;
+		for (size_t i = 0; i < queries->size(); ++i)
+			found += m.count((*queries)[i]);
+		bench::keep(found);
+	}
+	size_t ops() const { return queries->size(); }
+};
+
+template <class M> struct mapInsert : mapCase<M> {
+	mapInsert(const keySets<typename M::key_type>& k, double fpr) : mapCase<M>(k, k.hits, fpr) {}
+	void setup() { this->m.clear(); }
+	void run() {
+		for (size_t i = 0; i < this->keys->hits.size(); ++i)
+			this->m[this->keys->hits[i]] = static_cast<int>(i);
+		bench::keep(this->m);
+	}
+};
+
+template <class Key>
+static void fprTable(const keySets<Key>& keys, double fpr)
+{
+	static const double targets[] = {0.1, 0.01, 0.001};
+	std::vector<double> all(targets, targets + 3);
+	if (fpr != 0.1 && fpr != 0.01 && fpr != 0.001)
+		all.push_back(fpr);
+	for (size_t t = 0; t < all.size(); ++t)
+	{
+		ft::bloom_filter<Key> f(keys.hits.size(), all[t]);
+		for (size_t i = 0; i < keys.hits.size(); ++i)
+			f.insert(keys.hits[i]);
+		size_t passed = 0;
+		for (size_t i = 0; i < keys.misses.size(); ++i)
+			passed += f.may_contain(keys.misses[i]);
+		std::printf("  target %-8g measured %-10.5f %5.2f bits/key  %2lu probes\n", all[t],
+			static_cast<double>(passed) / keys.misses.size(), static_cast<double>(f.bit_count()) / keys.hits.size(),
+			static_cast<unsigned long>(f.hash_count()));
+	}
+}
+
+#define ALL(suite, op, Key, keys, queries) \
+	h.run(suite, op, "bloom", mapCase<ft::filtered_map<Key, int> >(keys, queries, fpr)); \
+	h.run(suite, op, "ft", mapCase<ft::map<Key, int> >(keys, queries, fpr)); \
+	h.run(suite, op, "std", mapCase<std::map<Key, int> >(keys, queries, fpr))
+
+#define SUITE(suite, Key, keys) \
+	ALL(suite, "find_mix", Key, keys, keys.mix); \
+	ALL(suite, "find_miss", Key, keys, keys.misses); \
+	ALL(suite, "find_hit", Key, keys, keys.hits); \
+	h.run(suite, "insert", "bloom", mapInsert<ft::filtered_map<Key, int> >(keys, fpr)); \
+	h.run(suite, "insert", "ft", mapInsert<ft::map<Key, int> >(keys, fpr)); \
+	h.run(suite, "insert", "std", mapInsert<std::map<Key, int> >(keys, fpr))
+
+int main(int argc, char** argv)
+{
+	bench::options opts(DEFAULT_N);
+	opts.declare("--miss-pct", DEFAULT_MISS_PCT);
+	opts.declare("--fpr", DEFAULT_FPR);
+	bool parsed = opts.parse(argc, argv);
+	double fpr = opts.getNumber("--fpr");
+	double missPct = opts.getNumber("--miss-pct");
+	if (!parsed || fpr <= 0 || fpr >= 1 || missPct < 0 || missPct > 100)
+	{
+		opts.usage(argv[0]);
+		std::cerr << "  --miss-pct P            share of misses in find_mix (" << DEFAULT_MISS_PCT << ")" << std::endl
+			<< "  --fpr F                 filter false positive rate (" << DEFAULT_FPR << ")" << std::endl;
+		return 2;
+	}
+	bench::harness h(opts);
+
+	keySets<unsigned long long> ints(opts.n, missPct);
+	keySets<std::string> urls(opts.n, missPct);
+	std::printf("---- bloom_filter on %lu keys, int ----\n", static_cast<unsigned long>(opts.n));
+	fprTable(ints, fpr);
+	std::printf("---- bloom_filter on %lu keys, string ----\n", static_cast<unsigned long>(opts.n));
+	fprTable(urls, fpr);
+
+	SUITE("int", unsigned long long, ints);
+	SUITE("string", std::string, urls);
+	return h.finish();
+}
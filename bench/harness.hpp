@@ -0,0 +1,471 @@
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <map>
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <time.h>
+#include "perf_counters.hpp"
+
+/**
+    * ------------------------------------------------------------- *
+    * ----------------------- BENCH::HARNESS ---------------------- *
+    *
+    * Shared timing loop of the benchmarks. A case is a struct with
+    *
+    *     void setup();         untimed, before every run
+    *     void run();           timed
+    *     size_t ops() const;   operations done by one run
+    *
+    * Each case is run warmup times untimed, then reps times timed.
+    * Every run gives one ns per operation sample, reported as min,
+    * median and p99 (nearest rank over the runs), with ops/s from
+    * the median. Rows of the same suite and op are compared: the ft
+    * row, and any other impl but std, gets a ratio column, its median
+    * / std median, over 1 means it is slower.
+    *
+    * Command line (options::parse):
+    *   --reps N --warmup N     runs per case, 31 and 3 by default
+    *   --n N                   size knob each benchmark reads
+    *   --filter TEXT           only cases whose "suite/op" contains TEXT
+    *   --csv FILE --json FILE  write the report
+    *   --baseline FILE         a previous --csv report: every ft row
+    *   --max-regression PCT    slower than it by over PCT percent (10
+    *                           by default) is listed, and finish()
+    *                           returns 1 so a release script can stop
+    *   --counters 1            also count cycles, instructions, L1D,
+    *                           LLC and dTLB misses and branch misses
+    *                           around every run (perf_counters.hpp),
+    *                           reported per operation as the median
+    *                           over the runs; without counters, say
+    *                           in a VM, the columns stay empty
+    *
+    * A benchmark declares its own flags with options::declare before
+    * parse, and reads them back with get.
+    * ------------------------------------------------------------- *
+    */
+namespace bench {
+
+inline long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+// makes the compiler believe x is read, so the work producing it is kept
+template <class T>
+inline void keep(const T& x)
+{
+	__asm__ __volatile__("" : : "r"(&x) : "memory");
+}
+
+/**
+    * Latency of single operations, in ns. Each power of two is split
+    * in 4 buckets, so a percentile is the lower edge of a bucket at
+    * most 25% below the true value; count, mean and max are exact.
+    * Timing one operation adds the cost of a clock read, about 20 ns.
+    */
+class histogram
+{
+public:
+	static const size_t BUCKETS = 4 * 63;
+
+	histogram() : _count(0), _sum(0), _max(0) { std::fill(_buckets, _buckets + BUCKETS, 0UL); }
+
+	void record(unsigned long ns)
+	{
+		++_buckets[bucketOf(ns)];
+		++_count;
+		_sum += ns;
+		_max = std::max(_max, ns);
+	}
+
+	unsigned long count() const { return _count; }
+	unsigned long max() const { return _max; }
+	double mean() const { return _count ? static_cast<double>(_sum) / _count : 0; }
+
+	// q in [0, 1]
+	unsigned long percentile(double q) const
+	{
+		unsigned long rank = static_cast<unsigned long>(q * _count);
+		unsigned long seen = 0;
+		for (size_t i = 0; i < BUCKETS; ++i)
+			if ((seen += _buckets[i]) > rank)
+				return lowerEdge(i);
+		return _max;
+	}
+
+	// one line per non-empty power of two: "[low, high) count bar"
+	void print(std::ostream& os, const std::string& indent) const
+	{
+		unsigned long widest = 0;
+		for (size_t p = 0; p < BUCKETS / 4; ++p)
+			widest = std::max(widest, powerCount(p));
+		for (size_t p = 0; p < BUCKETS / 4; ++p)
+		{
+			unsigned long c = powerCount(p);
+			if (!c)
+				continue;
+			os << indent << "[" << std::setw(9) << lowerEdge(4 * p) << ", " << std::setw(9) << lowerEdge(4 * p + 4)
+				<< ") ns " << std::setw(10) << c << " " << std::string(1 + 39 * c / widest, '#') << std::endl;
+		}
+	}
+
+	// non-empty buckets as "low:count" pairs
+	std::string buckets() const
+	{
+		std::ostringstream os;
+		for (size_t i = 0; i < BUCKETS; ++i)
+			if (_buckets[i])
+				os << (os.tellp() > 0 ? " " : "") << lowerEdge(i) << ":" << _buckets[i];
+		return os.str();
+	}
+
+private:
+	unsigned long _buckets[BUCKETS];
+	unsigned long _count;
+	unsigned long _sum;
+	unsigned long _max;
+
+	// 0..3 as is, then 4 buckets per power of two k >= 2
+	static size_t bucketOf(unsigned long ns)
+	{
+		if (ns < 4)
+			return ns;
+		size_t k = 0;
+		for (unsigned long v = ns; v >>= 1;)
+			++k;
+		return std::min(BUCKETS - 1, 4 * (k - 1) + ((ns >> (k - 2)) & 3));
+	}
+
+	static unsigned long lowerEdge(size_t i)
+	{
+		if (i < 4)
+			return i;
+		return (4UL + i % 4) << (i / 4 - 1);
+	}
+
+	unsigned long powerCount(size_t p) const
+	{
+		return _buckets[4 * p] + _buckets[4 * p + 1] + _buckets[4 * p + 2] + _buckets[4 * p + 3];
+	}
+};
+
+struct options
+{
+	int warmup;
+	int reps;
+	long n;
+	double maxRegression;
+	bool counters;
+	std::string filter;
+	std::string csv;
+	std::string json;
+	std::string baseline;
+	// flags of one benchmark, with their current values
+	std::map<std::string, std::string> extra;
+
+	explicit options(long defaultN) : warmup(3), reps(31), n(defaultN), maxRegression(10), counters(false) {}
+
+	void declare(const std::string& flag, const std::string& defaultValue) { extra[flag] = defaultValue; }
+
+	const std::string& get(const std::string& flag) const { return extra.find(flag)->second; }
+
+	double getNumber(const std::string& flag) const { return atof(get(flag).c_str()); }
+
+	// false on an unknown flag
+	bool parse(int argc, char** argv)
+	{
+		for (int i = 1; i < argc; ++i)
+		{
+			std::string flag = argv[i];
+			if (i + 1 == argc)
+				return false;
+			const char* value = argv[++i];
+			if (flag == "--reps")
+				reps = std::max(1, atoi(value));
+			else if (flag == "--warmup")
+				warmup = std::max(0, atoi(value));
+			else if (flag == "--n")
+				n = std::max(1L, atol(value));
+			else if (flag == "--filter")
+				filter = value;
+			else if (flag == "--csv")
+				csv = value;
+			else if (flag == "--json")
+				json = value;
+			else if (flag == "--baseline")
+				baseline = value;
+			else if (flag == "--max-regression")
+				maxRegression = atof(value);
+			else if (flag == "--counters")
+				counters = atoi(value) != 0;
+			else if (extra.count(flag))
+				extra[flag] = value;
+			else
+				return false;
+		}
+		return true;
+	}
+
+	void usage(const char* name) const
+	{
+		std::cerr << "Usage: " << name << " [--reps N] [--warmup N] [--n N] [--filter TEXT]"
+			" [--csv FILE] [--json FILE] [--baseline FILE] [--max-regression PCT] [--counters 0|1]";
+		for (std::map<std::string, std::string>::const_iterator it = extra.begin(); it != extra.end(); ++it)
+			std::cerr << " [" << it->first << " " << it->second << "]";
+		std::cerr << std::endl;
+	}
+};
+
+struct result
+{
+	std::string suite;
+	std::string op;
+	std::string impl;
+	size_t ops;
+	double minNs;
+	double medianNs;
+	double p99Ns;
+	// median / std median of the same suite and op, 0 when there is none or for std
+	double ratio;
+	// per operation, median over the runs; -1 when not counted
+	double counters[perf_counters::EVENTS];
+
+	std::string key() const { return suite + "/" + op + "/" + impl; }
+	double opsPerSec() const { return medianNs > 0 ? 1e9 / medianNs : 0; }
+};
+
+class harness
+{
+public:
+	explicit harness(const options& opts) : _opts(opts)
+	{
+		if (_opts.counters && !_counters.open())
+			std::cerr << "hardware counters unavailable: " << _counters.status() << ", timing only" << std::endl;
+	}
+
+	template <class Case>
+	void run(const char* suite, const char* op, const char* impl, Case test)
+	{
+		if (!_opts.filter.empty() && (std::string(suite) + "/" + op).find(_opts.filter) == std::string::npos)
+			return;
+		for (int i = 0; i < _opts.warmup; ++i)
+		{
+			test.setup();
+			test.run();
+		}
+		std::vector<double> samples;
+		std::vector<double> counts[perf_counters::EVENTS];
+		for (int i = 0; i < _opts.reps; ++i)
+		{
+			test.setup();
+			_counters.start();
+			long start = nowNs();
+			test.run();
+			long end = nowNs();
+			_counters.stop();
+			size_t ops = std::max<size_t>(test.ops(), 1);
+			samples.push_back(static_cast<double>(end - start) / ops);
+			for (int e = 0; e < perf_counters::EVENTS; ++e)
+				if (_counters.value(e) >= 0)
+					counts[e].push_back(_counters.value(e) / ops);
+		}
+		std::sort(samples.begin(), samples.end());
+		result r;
+		for (int e = 0; e < perf_counters::EVENTS; ++e)
+		{
+			std::sort(counts[e].begin(), counts[e].end());
+			r.counters[e] = counts[e].empty() ? -1 : counts[e][counts[e].size() / 2];
+		}
+		r.suite = suite;
+		r.op = op;
+		r.impl = impl;
+		r.ops = test.ops();
+		r.minNs = samples.front();
+		r.medianNs = samples[samples.size() / 2];
+		r.p99Ns = samples[std::min(samples.size() - 1, (samples.size() * 99 + 99) / 100 - 1)];
+		r.ratio = 0;
+		_results.push_back(r);
+		printRow(r);
+	}
+
+	// fills the ratios, writes the reports, checks the baseline; returns the exit status
+	int finish()
+	{
+		computeRatios();
+		printRatios();
+		if (!_opts.csv.empty())
+			writeCsv(_opts.csv);
+		if (!_opts.json.empty())
+			writeJson(_opts.json);
+		return _opts.baseline.empty() ? 0 : gate(_opts.baseline);
+	}
+
+	const std::vector<result>& results() const { return _results; }
+
+private:
+	options _opts;
+	perf_counters _counters;
+	std::vector<result> _results;
+
+	static void printRow(const result& r)
+	{
+		std::cout << std::left << std::setw(10) << r.suite << std::setw(22) << r.op << std::setw(5) << r.impl
+			<< std::right << std::fixed << std::setprecision(2)
+			<< " min " << std::setw(10) << r.minNs
+			<< " med " << std::setw(10) << r.medianNs
+			<< " p99 " << std::setw(10) << r.p99Ns << " ns/op "
+			<< std::setprecision(0) << std::setw(14) << r.opsPerSec() << " ops/s" << std::endl;
+		bool counted = false;
+		for (int e = 0; e < perf_counters::EVENTS; ++e)
+			if (r.counters[e] >= 0)
+			{
+				std::cout << (counted ? " " : "    per op:") << " " << perf_counters::name(e) << " "
+					<< std::setprecision(2) << r.counters[e];
+				counted = true;
+			}
+		if (r.counters[perf_counters::CYCLES] > 0 && r.counters[perf_counters::INSTRUCTIONS] >= 0)
+			std::cout << " ipc " << r.counters[perf_counters::INSTRUCTIONS] / r.counters[perf_counters::CYCLES];
+		if (counted)
+			std::cout << std::endl;
+	}
+
+	void computeRatios()
+	{
+		std::map<std::string, double> stdMedian;
+		for (size_t i = 0; i < _results.size(); ++i)
+			if (_results[i].impl == "std")
+				stdMedian[_results[i].suite + "/" + _results[i].op] = _results[i].medianNs;
+		for (size_t i = 0; i < _results.size(); ++i)
+		{
+			result& r = _results[i];
+			std::map<std::string, double>::iterator it = stdMedian.find(r.suite + "/" + r.op);
+			if (r.impl != "std" && it != stdMedian.end() && it->second > 0)
+				r.ratio = r.medianNs / it->second;
+		}
+	}
+
+	void printRatios() const
+	{
+		std::cout << "---- impl / std, median ns per op (over 1: slower than std) ----" << std::endl;
+		for (size_t i = 0; i < _results.size(); ++i)
+		{
+			const result& r = _results[i];
+			if (r.ratio > 0)
+				std::cout << std::left << std::setw(10) << r.suite << std::setw(22) << r.op << std::setw(7) << r.impl << std::right
+					<< std::fixed << std::setprecision(3) << std::setw(10) << r.ratio
+					<< (r.ratio > 1 + _opts.maxRegression / 100 ? "  slower" : "") << std::endl;
+		}
+	}
+
+	void writeCsv(const std::string& path) const
+	{
+		std::ofstream out(path.c_str());
+		out << "suite,op,impl,ops,min_ns_op,median_ns_op,p99_ns_op,ops_per_sec,ratio";
+		for (int e = 0; e < perf_counters::EVENTS; ++e)
+			out << ',' << perf_counters::name(e) << "_op";
+		out << '\n';
+		for (size_t i = 0; i < _results.size(); ++i)
+		{
+			const result& r = _results[i];
+			out << r.suite << ',' << r.op << ',' << r.impl << ',' << r.ops << ',' << std::fixed << std::setprecision(3)
+				<< r.minNs << ',' << r.medianNs << ',' << r.p99Ns << ',' << std::setprecision(0) << r.opsPerSec() << ',';
+			if (r.ratio > 0)
+				out << std::setprecision(4) << r.ratio;
+			for (int e = 0; e < perf_counters::EVENTS; ++e)
+			{
+				out << ',';
+				if (r.counters[e] >= 0)
+					out << std::setprecision(3) << r.counters[e];
+			}
+			out << '\n';
+		}
+		if (!out)
+			std::cerr << "could not write " << path << std::endl;
+	}
+
+	void writeJson(const std::string& path) const
+	{
+		std::ofstream out(path.c_str());
+		out << "[\n";
+		for (size_t i = 0; i < _results.size(); ++i)
+		{
+			const result& r = _results[i];
+			out << "  {\"suite\": \"" << r.suite << "\", \"op\": \"" << r.op << "\", \"impl\": \"" << r.impl
+				<< "\", \"ops\": " << r.ops << std::fixed << std::setprecision(3)
+				<< ", \"min_ns_op\": " << r.minNs << ", \"median_ns_op\": " << r.medianNs << ", \"p99_ns_op\": " << r.p99Ns
+				<< ", \"ops_per_sec\": " << std::setprecision(0) << r.opsPerSec() << ", \"ratio\": ";
+			if (r.ratio > 0)
+				out << std::setprecision(4) << r.ratio;
+			else
+				out << "null";
+			for (int e = 0; e < perf_counters::EVENTS; ++e)
+			{
+				out << ", \"" << perf_counters::name(e) << "_op\": ";
+				if (r.counters[e] >= 0)
+					out << std::setprecision(3) << r.counters[e];
+				else
+					out << "null";
+			}
+			out << (i + 1 < _results.size() ? "},\n" : "}\n");
+		}
+		out << "]\n";
+		if (!out)
+			std::cerr << "could not write " << path << std::endl;
+	}
+
+	// compares every non-std row to the median of the same row in a previous csv report
+	int gate(const std::string& path) const
+	{
+		std::ifstream in(path.c_str());
+		if (!in)
+		{
+			std::cerr << "could not read baseline " << path << std::endl;
+			return 1;
+		}
+		std::map<std::string, double> baseline;
+		std::string line;
+		std::getline(in, line);
+		while (std::getline(in, line))
+		{
+			std::vector<std::string> fields;
+			std::stringstream ss(line);
+			std::string field;
+			while (std::getline(ss, field, ','))
+				fields.push_back(field);
+			if (fields.size() >= 6)
+				baseline[fields[0] + "/" + fields[1] + "/" + fields[2]] = atof(fields[5].c_str());
+		}
+		int regressions = 0;
+		std::cout << "---- against " << path << ", limit +" << _opts.maxRegression << "% ----" << std::endl;
+		for (size_t i = 0; i < _results.size(); ++i)
+		{
+			const result& r = _results[i];
+			std::map<std::string, double>::const_iterator it = baseline.find(r.key());
+			if (r.impl == "std" || it == baseline.end() || it->second <= 0)
+				continue;
+			double change = (r.medianNs / it->second - 1) * 100;
+			if (change > _opts.maxRegression)
+			{
+				++regressions;
+				std::cout << "REGRESSION " << r.key() << std::fixed << std::setprecision(1)
+					<< ": " << it->second << " -> " << r.medianNs << " ns/op (+" << change << "%)" << std::endl;
+			}
+		}
+		std::cout << regressions << " regression(s)" << std::endl;
+		return regressions ? 1 : 0;
+	}
+};
+
+}
+
+#endif
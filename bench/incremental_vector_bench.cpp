@@ -0,0 +1,54 @@
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <time.h>
+#include "../containers/vector.hpp"
+#include "../containers/incremental_vector.hpp"
+
+#define COUNT (1 << 26)
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+template <typename Vector>
+void bench(const char* name)
+{
+	std::vector<long> latencies(COUNT);
+	Vector vector;
+
+	long total = nowNs();
+	for (int i = 0; i < COUNT; ++i)
+	{
+		long start = nowNs();
+		vector.push_back(i);
+		latencies[i] = nowNs() - start;
+	}
+	total = nowNs() - total;
+
+	long scan = nowNs();
+	long sum = 0;
+	for (size_t i = 0; i < vector.size(); ++i)
+		sum += vector[i];
+	scan = nowNs() - scan;
+
+	std::sort(latencies.begin(), latencies.end());
+	std::cout << name
+		<< "\ttotal ms: " << total / 1000000
+		<< "\tp99 ns: " << latencies[COUNT / 100 * 99]
+		<< "\tp999 ns: " << latencies[COUNT / 1000 * 999]
+		<< "\tmax ns: " << latencies[COUNT - 1]
+		<< "\tindexed scan ms: " << scan / 1000000
+		<< "\t(ignore: " << sum << ")" << std::endl;
+}
+
+int main()
+{
+	std::cout << "---- " << COUNT << " push_back, per push latency ----" << std::endl;
+	bench<ft::vector<int> >("vector            ");
+	bench<ft::incremental_vector<int> >("incremental_vector");
+	return (0);
+}
@@ -0,0 +1,484 @@
+#include <map>
+#include <vector>
+#include <cmath>
+#include "harness.hpp"
+#include "../containers/map.hpp"
+#include "../memory/tracking_allocator.hpp"
+
+/*
+ * ./map_workload_bench.out [harness options] [workload options]
+ *
+ * Drives ft::map and std::map with the same key streams and times every
+ * operation alone, into one latency histogram per operation. The n keys
+ * of a map are the even numbers 0, 2, .. 2(n-1); a lookup miss asks
+ * for the odd number next to a key.
+ *
+ * Key distributions (--dist, "all" runs each):
+ *   sequential  ascending keys, what turns an unbalanced tree into a list
+ *   reverse     descending keys, the mirror list
+ *   uniform     keys in random order
+ *   zipf        --zipf-s skewed ranks over randomly placed keys: few hot keys
+ *   clustered   runs of --cluster ascending keys, the runs in random order
+ *
+ * Scenarios, each on a fresh map built by inserting the keys in the
+ * order of the distribution:
+ *   build       the inserts themselves; also reports bytes allocated per key
+ *   read        finds, --miss percent of them for absent keys
+ *   mixed       70% find, 20% operator[] write, 10% erase
+ *   scan        lower_bound then --scan-len increments
+ * --mix R:W:E:S replaces read, mixed and scan with one "custom" scenario
+ * doing R% finds, W% writes, E% erases and S% scans. Each scenario does
+ * --ops operations (n by default); --reps and --warmup are not used, every
+ * operation is a sample. --histograms 1 prints the histograms, the csv
+ * and json reports always carry the percentiles, the json the buckets.
+ * --counters 1 adds the mean hardware counts of each operation, read
+ * around every single one (bench/perf_counters.hpp): the syscalls cost
+ * microseconds and evict some cache, so leave it off for latencies.
+ */
+#define DEFAULT_N 20000
+
+struct ft_tag {};
+struct std_tag {};
+
+typedef ft::map<int, int, ft::less<int>, ft::tracking_allocator<ft::pair<const int, int>, ft_tag> > ft_map;
+typedef std::map<int, int, std::less<int>, ft::tracking_allocator<std::pair<const int, int>, std_tag> > std_map;
+
+enum { FIND, WRITE, ERASE, SCAN, INSERT, OPS };
+static const char* OP_NAMES[OPS] = { "find", "write", "erase", "scan", "insert" };
+
+// xorshift64*, the same stream for both maps
+struct rng
+{
+	unsigned long state;
+
+	explicit rng(unsigned long seed) : state(seed * 2654435761UL + 1) {}
+
+	unsigned long next()
+	{
+		state ^= state >> 12;
+		state ^= state << 25;
+		state ^= state >> 27;
+		return state * 2685821657736338717UL;
+	}
+
+	size_t below(size_t n) { return next() % n; }
+	double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+struct workload
+{
+	std::string dist;
+	std::string scenario;
+	// percentages of FIND, WRITE, ERASE, SCAN
+	int mix[4];
+	size_t ops;
+	double miss;
+	size_t scanLen;
+};
+
+/* ------------------------------- key streams ------------------------------ */
+
+class key_stream
+{
+public:
+	key_stream(const std::string& dist, size_t n, double zipfS, size_t cluster, unsigned long seed)
+		: _dist(dist), _n(n), _cluster(std::max<size_t>(1, std::min(cluster, n))), _t(0), _clusterStart(0), _rng(seed)
+	{
+		_perm.resize(n);
+		for (size_t i = 0; i < n; ++i)
+			_perm[i] = i;
+		for (size_t i = n; i > 1; --i)
+			std::swap(_perm[i - 1], _perm[_rng.below(i)]);
+		if (dist == "zipf")
+		{
+			double total = 0;
+			_zipfCdf.resize(n);
+			for (size_t r = 0; r < n; ++r)
+				_zipfCdf[r] = total += 1.0 / std::pow(static_cast<double>(r + 1), zipfS);
+			for (size_t r = 0; r < n; ++r)
+				_zipfCdf[r] /= total;
+		}
+	}
+
+	// every slot once, in the insertion order of the distribution
+	std::vector<size_t> buildOrder() const
+	{
+		std::vector<size_t> order;
+		if (_dist == "sequential")
+			for (size_t i = 0; i < _n; ++i)
+				order.push_back(i);
+		else if (_dist == "reverse")
+			for (size_t i = _n; i > 0; --i)
+				order.push_back(i - 1);
+		else if (_dist == "clustered")
+		{
+			for (size_t i = 0; i < _n; ++i)
+				if (_perm[i] % _cluster == 0)
+					for (size_t s = _perm[i]; s < _perm[i] + _cluster && s < _n; ++s)
+						order.push_back(s);
+		}
+		else
+			order = _perm;
+		return order;
+	}
+
+	// the slot of the next access
+	size_t next()
+	{
+		size_t t = _t++;
+		if (_dist == "sequential")
+			return t % _n;
+		if (_dist == "reverse")
+			return _n - 1 - t % _n;
+		if (_dist == "zipf")
+			return _perm[std::min(_n - 1, static_cast<size_t>(
+				std::lower_bound(_zipfCdf.begin(), _zipfCdf.end(), _rng.unit()) - _zipfCdf.begin()))];
+		if (_dist == "clustered")
+		{
+			if (t % _cluster == 0)
+				_clusterStart = _rng.below((_n + _cluster - 1) / _cluster) * _cluster;
+			return std::min(_n - 1, _clusterStart + t % _cluster);
+		}
+		return _rng.below(_n);
+	}
+
+	rng& random() { return _rng; }
+
+private:
+	std::string _dist;
+	size_t _n;
+	size_t _cluster;
+	size_t _t;
+	size_t _clusterStart;
+	rng _rng;
+	std::vector<size_t> _perm;
+	std::vector<double> _zipfCdf;
+};
+
+/* --------------------------------- running -------------------------------- */
+
+struct row
+{
+	workload w;
+	std::string impl;
+	std::string op;
+	bench::histogram latency;
+	// mean per operation, -1 when not counted
+	double counters[bench::perf_counters::EVENTS];
+	// build rows only
+	double bytesPerKey;
+	double peakBytesPerKey;
+	double ratio;
+};
+
+static int keyOf(size_t slot) { return static_cast<int>(slot * 2); }
+
+// sums of the counts of one kind of operation
+struct counter_sums
+{
+	double total[bench::perf_counters::EVENTS];
+	unsigned long samples[bench::perf_counters::EVENTS];
+
+	counter_sums()
+	{
+		std::fill(total, total + bench::perf_counters::EVENTS, 0.0);
+		std::fill(samples, samples + bench::perf_counters::EVENTS, 0UL);
+	}
+
+	void add(const bench::perf_counters& pc)
+	{
+		for (int e = 0; e < bench::perf_counters::EVENTS; ++e)
+			if (pc.value(e) >= 0)
+			{
+				total[e] += pc.value(e);
+				++samples[e];
+			}
+	}
+
+	double mean(int e) const { return samples[e] ? total[e] / samples[e] : -1; }
+};
+
+template <class Map, class Tag>
+void runWorkload(const workload& w, const char* impl, const bench::options& opts, bench::perf_counters& pc,
+	std::vector<row>& rows)
+{
+	size_t n = static_cast<size_t>(opts.n);
+	// same seed for both maps: they see the same keys in the same order
+	key_stream keys(w.dist, n, opts.getNumber("--zipf-s"), static_cast<size_t>(opts.getNumber("--cluster")), 42);
+	std::vector<size_t> order = keys.buildOrder();
+	bench::histogram latency[OPS];
+	counter_sums counts[OPS];
+	ft::memory_telemetry<Tag>::reset();
+	{
+		Map m;
+		for (size_t i = 0; i < order.size(); ++i)
+		{
+			typename Map::value_type value(keyOf(order[i]), static_cast<int>(i));
+			pc.start();
+			long start = bench::nowNs();
+			m.insert(value);
+			long end = bench::nowNs();
+			pc.stop();
+			latency[INSERT].record(end - start);
+			counts[INSERT].add(pc);
+		}
+		double size = static_cast<double>(m.size());
+		double bytes = ft::memory_telemetry<Tag>::stats().live_bytes / size;
+		double peak = ft::memory_telemetry<Tag>::stats().peak_bytes / size;
+		long sum = 0;
+		for (size_t i = 0; w.scenario != "build" && i < w.ops; ++i)
+		{
+			int pick = static_cast<int>(keys.random().below(100));
+			int key = keyOf(keys.next());
+			int op = 0;
+			while (op < SCAN && pick >= w.mix[op])
+				pick -= w.mix[op++];
+			pc.start();
+			long start = bench::nowNs();
+			switch (op)
+			{
+			case FIND:
+				if (keys.random().unit() * 100 < w.miss)
+					++key;
+				sum += m.find(key) != m.end();
+				break;
+			case WRITE:
+				m[key] = static_cast<int>(i);
+				break;
+			case ERASE:
+				sum += m.erase(key);
+				break;
+			default:
+				{
+					typename Map::iterator it = m.lower_bound(key);
+					for (size_t s = 0; s < w.scanLen && it != m.end(); ++s, ++it)
+						sum += it->second;
+				}
+			}
+			long end = bench::nowNs();
+			pc.stop();
+			latency[op].record(end - start);
+			counts[op].add(pc);
+		}
+		bench::keep(sum);
+		for (int op = 0; op < OPS; ++op)
+		{
+			if (!latency[op].count() || (op == INSERT) != (w.scenario == "build"))
+				continue;
+			row r;
+			r.w = w;
+			r.impl = impl;
+			r.op = OP_NAMES[op];
+			r.latency = latency[op];
+			for (int e = 0; e < bench::perf_counters::EVENTS; ++e)
+				r.counters[e] = counts[op].mean(e);
+			r.bytesPerKey = op == INSERT ? bytes : 0;
+			r.peakBytesPerKey = op == INSERT ? peak : 0;
+			r.ratio = 0;
+			rows.push_back(r);
+		}
+	}
+}
+
+/* -------------------------------- reporting ------------------------------- */
+
+static void computeRatios(std::vector<row>& rows)
+{
+	for (size_t i = 0; i < rows.size(); ++i)
+		for (size_t j = 0; j < rows.size(); ++j)
+			if (rows[i].impl == "ft" && rows[j].impl == "std" && rows[i].w.dist == rows[j].w.dist
+				&& rows[i].w.scenario == rows[j].w.scenario && rows[i].op == rows[j].op && rows[j].latency.mean() > 0)
+				rows[i].ratio = rows[i].latency.mean() / rows[j].latency.mean();
+}
+
+static void printRow(const row& r, bool histograms)
+{
+	const bench::histogram& h = r.latency;
+	std::cout << std::left << std::setw(11) << r.w.dist << std::setw(8) << r.w.scenario << std::setw(4) << r.impl
+		<< std::setw(7) << r.op << std::right << std::setw(8) << h.count()
+		<< std::fixed << std::setprecision(0) << " mean " << std::setw(9) << h.mean()
+		<< " p50 " << std::setw(8) << h.percentile(0.5) << " p90 " << std::setw(8) << h.percentile(0.9)
+		<< " p99 " << std::setw(8) << h.percentile(0.99) << " p99.9 " << std::setw(8) << h.percentile(0.999)
+		<< " max " << std::setw(9) << h.max() << " ns";
+	if (r.ratio > 0)
+		std::cout << std::setprecision(2) << "  ft/std " << r.ratio;
+	if (r.bytesPerKey > 0)
+		std::cout << std::setprecision(1) << "  " << r.bytesPerKey << " B/key, peak " << r.peakBytesPerKey;
+	std::cout << std::endl;
+	bool counted = false;
+	for (int e = 0; e < bench::perf_counters::EVENTS; ++e)
+		if (r.counters[e] >= 0)
+		{
+			std::cout << (counted ? " " : "    per op:") << " " << bench::perf_counters::name(e) << " "
+				<< std::setprecision(1) << r.counters[e];
+			counted = true;
+		}
+	if (counted)
+		std::cout << std::endl;
+	if (histograms)
+		h.print(std::cout, "    ");
+}
+
+static void writeCsv(const std::string& path, const std::vector<row>& rows)
+{
+	std::ofstream out(path.c_str());
+	out << "dist,scenario,impl,op,count,mean_ns,p50_ns,p90_ns,p99_ns,p999_ns,max_ns,ratio_mean,bytes_per_key,peak_bytes_per_key";
+	for (int e = 0; e < bench::perf_counters::EVENTS; ++e)
+		out << ',' << bench::perf_counters::name(e) << "_op";
+	out << '\n';
+	for (size_t i = 0; i < rows.size(); ++i)
+	{
+		const row& r = rows[i];
+		const bench::histogram& h = r.latency;
+		out << r.w.dist << ',' << r.w.scenario << ',' << r.impl << ',' << r.op << ',' << h.count() << ','
+			<< std::fixed << std::setprecision(1) << h.mean() << ',' << h.percentile(0.5) << ',' << h.percentile(0.9) << ','
+			<< h.percentile(0.99) << ',' << h.percentile(0.999) << ',' << h.max() << ',';
+		if (r.ratio > 0)
+			out << std::setprecision(4) << r.ratio;
+		out << ',';
+		if (r.bytesPerKey > 0)
+			out << std::setprecision(1) << r.bytesPerKey << ',' << r.peakBytesPerKey;
+		else
+			out << ',';
+		for (int e = 0; e < bench::perf_counters::EVENTS; ++e)
+		{
+			out << ',';
+			if (r.counters[e] >= 0)
+				out << std::setprecision(1) << r.counters[e];
+		}
+		out << '\n';
+	}
+	if (!out)
+		std::cerr << "could not write " << path << std::endl;
+}
+
+static void writeJson(const std::string& path, const std::vector<row>& rows)
+{
+	std::ofstream out(path.c_str());
+	out << "[\n";
+	for (size_t i = 0; i < rows.size(); ++i)
+	{
+		const row& r = rows[i];
+		const bench::histogram& h = r.latency;
+		out << "  {\"dist\": \"" << r.w.dist << "\", \"scenario\": \"" << r.w.scenario << "\", \"impl\": \"" << r.impl
+			<< "\", \"op\": \"" << r.op << "\", \"count\": " << h.count() << std::fixed << std::setprecision(1)
+			<< ", \"mean_ns\": " << h.mean() << ", \"p50_ns\": " << h.percentile(0.5) << ", \"p90_ns\": " << h.percentile(0.9)
+			<< ", \"p99_ns\": " << h.percentile(0.99) << ", \"p999_ns\": " << h.percentile(0.999) << ", \"max_ns\": " << h.max()
+			<< ", \"ratio_mean\": ";
+		if (r.ratio > 0)
+			out << std::setprecision(4) << r.ratio;
+		else
+			out << "null";
+		if (r.bytesPerKey > 0)
+			out << std::setprecision(1) << ", \"bytes_per_key\": " << r.bytesPerKey << ", \"peak_bytes_per_key\": " << r.peakBytesPerKey;
+		for (int e = 0; e < bench::perf_counters::EVENTS; ++e)
+		{
+			out << ", \"" << bench::perf_counters::name(e) << "_op\": ";
+			if (r.counters[e] >= 0)
+				out << std::setprecision(1) << r.counters[e];
+			else
+				out << "null";
+		}
+		out << ", \"buckets\": \"" << h.buckets() << (i + 1 < rows.size() ? "\"},\n" : "\"}\n");
+	}
+	out << "]\n";
+	if (!out)
+		std::cerr << "could not write " << path << std::endl;
+}
+
+/* ---------------------------------- main ---------------------------------- */
+
+static bool parseMix(const std::string& text, int mix[4])
+{
+	std::stringstream ss(text);
+	std::string part;
+	int total = 0;
+	for (int i = 0; i < 4; ++i)
+	{
+		if (!std::getline(ss, part, ':'))
+			return false;
+		total += mix[i] = std::max(0, atoi(part.c_str()));
+	}
+	return total == 100;
+}
+
+int main(int argc, char** argv)
+{
+	bench::options opts(DEFAULT_N);
+	opts.declare("--dist", "all");
+	opts.declare("--mix", "");
+	opts.declare("--ops", "0");
+	opts.declare("--miss", "10");
+	opts.declare("--scan-len", "100");
+	opts.declare("--zipf-s", "0.99");
+	opts.declare("--cluster", "64");
+	opts.declare("--histograms", "0");
+	if (!opts.parse(argc, argv))
+	{
+		opts.usage(argv[0]);
+		return 2;
+	}
+
+	const char* allDists[] = { "sequential", "reverse", "uniform", "zipf", "clustered" };
+	std::vector<std::string> dists;
+	for (size_t i = 0; i < sizeof(allDists) / sizeof(*allDists); ++i)
+		if (opts.get("--dist") == "all" || opts.get("--dist") == allDists[i])
+			dists.push_back(allDists[i]);
+
+	workload base;
+	base.ops = opts.getNumber("--ops") > 0 ? static_cast<size_t>(opts.getNumber("--ops")) : static_cast<size_t>(opts.n);
+	base.miss = opts.getNumber("--miss");
+	base.scanLen = static_cast<size_t>(opts.getNumber("--scan-len"));
+	std::vector<workload> scenarios;
+	const char* names[] = { "build", "read", "mixed", "scan" };
+	const int mixes[][4] = { { 0, 0, 0, 0 }, { 100, 0, 0, 0 }, { 70, 20, 10, 0 }, { 0, 0, 0, 100 } };
+	for (int i = 0; i < 4; ++i)
+	{
+		if (i && !opts.get("--mix").empty())
+			break;
+		base.scenario = names[i];
+		std::copy(mixes[i], mixes[i] + 4, base.mix);
+		scenarios.push_back(base);
+	}
+	if (!opts.get("--mix").empty())
+	{
+		base.scenario = "custom";
+		if (!parseMix(opts.get("--mix"), base.mix))
+		{
+			std::cerr << "--mix wants R:W:E:S percentages adding up to 100" << std::endl;
+			return 2;
+		}
+		scenarios.push_back(base);
+	}
+	if (dists.empty())
+	{
+		opts.usage(argv[0]);
+		return 2;
+	}
+
+	bench::perf_counters pc;
+	if (opts.counters && !pc.open())
+		std::cerr << "hardware counters unavailable: " << pc.status() << ", timing only" << std::endl;
+	std::vector<row> rows;
+	bool histograms = opts.getNumber("--histograms") != 0;
+	std::cout << "n " << opts.n << ", " << base.ops << " operations per scenario" << std::endl;
+	for (size_t d = 0; d < dists.size(); ++d)
+		for (size_t s = 0; s < scenarios.size(); ++s)
+		{
+			workload w = scenarios[s];
+			w.dist = dists[d];
+			if (!opts.filter.empty() && (w.dist + "/" + w.scenario).find(opts.filter) == std::string::npos)
+				continue;
+			size_t first = rows.size();
+			runWorkload<ft_map, ft_tag>(w, "ft", opts, pc, rows);
+			runWorkload<std_map, std_tag>(w, "std", opts, pc, rows);
+			computeRatios(rows);
+			for (size_t i = first; i < rows.size(); ++i)
+				printRow(rows[i], histograms);
+		}
+	if (!opts.csv.empty())
+		writeCsv(opts.csv, rows);
+	if (!opts.json.empty())
+		writeJson(opts.json, rows);
+	return 0;
+}
@@ -0,0 +1,164 @@
+#include <iostream>
+#include "../containers/vector.hpp"
+#include "../containers/map.hpp"
+#include "../containers/deque.hpp"
+#include "../containers/stack.hpp"
+#include "../containers/incremental_vector.hpp"
+#include "../memory/tracking_allocator.hpp"
+
+#define COUNT 100000
+
+struct vector_tag {};
+struct vector_bool_tag {};
+struct map_tag {};
+struct deque_tag {};
+struct stack_tag {};
+struct incremental_vector_tag {};
+
+typedef ft::vector<int, ft::tracking_allocator<int, vector_tag> > tracked_vector;
+typedef ft::vector<bool, ft::tracking_allocator<bool, vector_bool_tag> > tracked_vector_bool;
+typedef ft::map<int, int, ft::less<int>, ft::tracking_allocator<ft::pair<const int, int>, map_tag> > tracked_map;
+typedef ft::deque<int, ft::tracking_allocator<int, deque_tag> > tracked_deque;
+typedef ft::stack<int, ft::deque<int, ft::tracking_allocator<int, stack_tag> > > tracked_stack;
+typedef ft::incremental_vector<int, ft::tracking_allocator<int, incremental_vector_tag> > tracked_incremental_vector;
+
+static int leaks = 0;
+
+template <typename Tag>
+void report(const char* container, const char* operation, size_t elements)
+{
+	const ft::allocation_stats& stats = ft::memory_telemetry<Tag>::stats();
+	std::cout << container << "\t" << operation
+		<< "\tlive B: " << stats.live_bytes
+		<< "\tpeak B: " << stats.peak_bytes
+		<< "\tblocks: " << stats.live_blocks();
+	if (elements)
+		std::cout << "\tB/element: " << static_cast<double>(stats.live_bytes) / elements;
+	std::cout << std::endl;
+}
+
+// everything allocated under Tag must have been given back
+template <typename Tag>
+void checkLeaks(const char* container)
+{
+	const ft::allocation_stats& stats = ft::memory_telemetry<Tag>::stats();
+	if (stats.live_bytes || stats.live_blocks())
+	{
+		std::cout << container << "\tLEAK: " << stats.live_bytes << " B in " << stats.live_blocks() << " blocks" << std::endl;
+		++leaks;
+	}
+	ft::memory_telemetry<Tag>::dump(std::cout, container);
+	std::cout << std::endl;
+}
+
+// fill, copy, assign, erase half, clear: every sequence container answers these
+template <typename Vector, typename Tag>
+void sequence(const char* name)
+{
+	{
+		Vector v;
+		for (int i = 0; i < COUNT; ++i)
+			v.push_back(i);
+		report<Tag>(name, "push_back  ", v.size());
+		{
+			Vector copy(v);
+			report<Tag>(name, "copy       ", 2 * v.size());
+		}
+		Vector small;
+		small.push_back(1);
+		small = v;
+		report<Tag>(name, "assign grow", 2 * v.size());
+		small = Vector();
+		report<Tag>(name, "assign empty", v.size());
+		v.erase(v.begin(), v.begin() + COUNT / 2);
+		report<Tag>(name, "erase half ", v.size());
+		v.clear();
+		report<Tag>(name, "clear      ", 0);
+	}
+	report<Tag>(name, "destroy    ", 0);
+	checkLeaks<Tag>(name);
+}
+
+void map()
+{
+	const char* name = "map";
+	{
+		tracked_map m;
+		// scattered keys: sorted ones would degenerate the unbalanced tree
+		for (int i = 0; i < COUNT; ++i)
+			m[(i * 7919) % COUNT] = i;
+		report<map_tag>(name, "insert     ", m.size());
+		{
+			tracked_map copy(m);
+			report<map_tag>(name, "copy       ", 2 * m.size());
+		}
+		tracked_map small;
+		small[1] = 1;
+		small = m;
+		report<map_tag>(name, "assign     ", 2 * m.size());
+		small = tracked_map();
+		m.erase(m.begin(), m.lower_bound(COUNT / 2));
+		report<map_tag>(name, "erase half ", m.size());
+		m.clear();
+		report<map_tag>(name, "clear      ", 0);
+	}
+	report<map_tag>(name, "destroy    ", 0);
+	checkLeaks<map_tag>(name);
+}
+
+void stack()
+{
+	const char* name = "stack";
+	{
+		tracked_stack s;
+		for (int i = 0; i < COUNT; ++i)
+			s.push(i);
+		report<stack_tag>(name, "push       ", s.size());
+		for (int i = 0; i < COUNT / 2; ++i)
+			s.pop();
+		report<stack_tag>(name, "pop half   ", s.size());
+	}
+	report<stack_tag>(name, "destroy    ", 0);
+	checkLeaks<stack_tag>(name);
+}
+
+void incrementalVector()
+{
+	const char* name = "incremental_vector";
+	{
+		tracked_incremental_vector v;
+		for (int i = 0; i < COUNT; ++i)
+			v.push_back(i);
+		report<incremental_vector_tag>(name, "push_back  ", v.size());
+		tracked_incremental_vector copy(v);
+		report<incremental_vector_tag>(name, "copy       ", 2 * v.size());
+		v.clear();
+		report<incremental_vector_tag>(name, "clear      ", 0);
+	}
+	report<incremental_vector_tag>(name, "destroy    ", 0);
+	checkLeaks<incremental_vector_tag>(name);
+}
+
+int main()
+{
+	std::cout << "---- memory per container, " << COUNT << " ints ----" << std::endl;
+	sequence<tracked_vector, vector_tag>("vector");
+	sequence<tracked_vector_bool, vector_bool_tag>("vector<bool>");
+	sequence<tracked_deque, deque_tag>("deque");
+	map();
+	stack();
+	incrementalVector();
+
+	// periodic dump: every 4 node allocations of a small map
+	ft::memory_telemetry<map_tag>::reset();
+	ft::memory_telemetry<map_tag>::dump_every(4, &std::cout, "map every 4 allocs");
+	{
+		tracked_map m;
+		for (int i = 0; i < 12; ++i)
+			m[i] = i;
+	}
+	ft::memory_telemetry<map_tag>::dump_every(0, NULL);
+
+	std::cout << (leaks ? "LEAKS FOUND" : "no leaks") << std::endl;
+	return (leaks != 0);
+}
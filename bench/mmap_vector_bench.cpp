@@ -0,0 +1,199 @@
+#include <vector>
+#include <string>
+#include <cstdio>
+#include <cstdlib>
+#include <fcntl.h>
+#include <unistd.h>
+#include "harness.hpp"
+#include "../containers/mmap_vector.hpp"
+#include "../containers/vector.hpp"
+
+/*
+ * ./mmap_vector_bench.out [harness options] [--dir D]
+ *
+ * ft::mmap_vector against loading a file into memory with read(2).
+ * The file holds n ints (--n, 50M by default: 200 MB) and sits in the
+ * page cache, so the timings are the copy and the page faults, not
+ * the disk. Files go to --dir (/tmp) and are removed at the end.
+ *
+ * load suite, the vector opened from the file then
+ *   open        left untouched
+ *   open_sum    summed: every page read
+ *   open_probe  read at 1000 random indexes
+ * store suite:
+ *   write       n push_backs then made durable: sync() for mmap,
+ *               write(2) and fsync for the others
+ * Impls: mmap (ft::mmap_vector, read_only to load), ft (ft::vector,
+ * resize_uninitialized then read), std (std::vector, resize then
+ * read). ns per element.
+ */
+#define DEFAULT_N 50000000
+#define DEFAULT_DIR "/tmp"
+#define PROBES 1000
+
+static std::string loadPath;
+static std::string storePath;
+
+// the elements of a file written by mmap_vector, after its header
+static const off_t HEADER = 64;
+
+static void readAll(int fd, char* to, size_t bytes, off_t offset)
+{
+	while (bytes)
+	{
+		ssize_t got = ::pread(fd, to, bytes, offset);
+		if (got <= 0)
+		{
+			std::perror("pread");
+			std::exit(1);
+		}
+		to += got;
+		offset += got;
+		bytes -= got;
+	}
+}
+
+static void writeAll(int fd, const char* from, size_t bytes)
+{
+	while (bytes)
+	{
+		ssize_t put = ::write(fd, from, bytes);
+		if (put <= 0)
+		{
+			std::perror("write");
+			std::exit(1);
+		}
+		from += put;
+		bytes -= put;
+	}
+}
+
+/* --------------------------------- load -------------------------------- */
+
+// what each impl does after opening
+enum use { NOTHING, SUM, PROBE };
+
+template <class V>
+static long useVector(const V& v, use u)
+{
+	long s = 0;
+	if (u == SUM)
+		for (size_t i = 0; i < v.size(); ++i)
+			s += v[i];
+	else if (u == PROBE)
+		for (size_t i = 0; i < PROBES; ++i)
+			s += v[(i * 2654435761UL) % v.size()];
+	return s;
+}
+
+struct loadMmap
+{
+	size_t n;
+	use u;
+
+	loadMmap(size_t count, use what) : n(count), u(what) {}
+	void setup() {}
+	void run() {
+		const ft::mmap_vector<int> v(loadPath.c_str(), ft::mmap_vector<int>::read_only);
+		bench::keep(useVector(v, u));
+	}
+	size_t ops() const { return n; }
+};
+
+// room for the elements read: ft::vector skips zeroing them
+template <class V> void makeRoom(V& v, size_t n) { v.resize(n); }
+void makeRoom(ft::vector<int>& v, size_t n) { v.resize_uninitialized(n); }
+
+template <class V>
+struct loadRead
+{
+	size_t n;
+	use u;
+
+	loadRead(size_t count, use what) : n(count), u(what) {}
+	void setup() {}
+	void run() {
+		int fd = ::open(loadPath.c_str(), O_RDONLY);
+		V v;
+		makeRoom(v, n);
+		readAll(fd, reinterpret_cast<char*>(&v[0]), n * sizeof(int), HEADER);
+		::close(fd);
+		bench::keep(useVector(v, u));
+	}
+	size_t ops() const { return n; }
+};
+
+/* --------------------------------- store ------------------------------- */
+
+struct storeMmap
+{
+	size_t n;
+
+	explicit storeMmap(size_t count) : n(count) {}
+	void setup() {}
+	void run() {
+		ft::mmap_vector<int> v(storePath.c_str(), ft::mmap_vector<int>::truncate);
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(static_cast<int>(i));
+		v.sync();
+	}
+	size_t ops() const { return n; }
+};
+
+template <class V>
+struct storeWrite
+{
+	size_t n;
+
+	explicit storeWrite(size_t count) : n(count) {}
+	void setup() {}
+	void run() {
+		V v;
+		for (size_t i = 0; i < n; ++i)
+			v.push_back(static_cast<int>(i));
+		int fd = ::open(storePath.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		writeAll(fd, reinterpret_cast<const char*>(&v[0]), n * sizeof(int));
+		::fsync(fd);
+		::close(fd);
+	}
+	size_t ops() const { return n; }
+};
+
+#define LOAD(op, u) \
+	h.run("load", op, "mmap", loadMmap(n, u)); \
+	h.run("load", op, "ft", loadRead<ft::vector<int> >(n, u)); \
+	h.run("load", op, "std", loadRead<std::vector<int> >(n, u))
+
+int main(int argc, char** argv)
+{
+	bench::options opts(DEFAULT_N);
+	opts.declare("--dir", DEFAULT_DIR);
+	if (!opts.parse(argc, argv) || !opts.n)
+	{
+		opts.usage(argv[0]);
+		std::cerr << "  --dir D                 where the files go (" << DEFAULT_DIR << ")" << std::endl;
+		return 2;
+	}
+	bench::harness h(opts);
+	size_t n = opts.n;
+	loadPath = opts.get("--dir") + "/ft_mmap_vector_load.bin";
+	storePath = opts.get("--dir") + "/ft_mmap_vector_store.bin";
+
+	{
+		ft::mmap_vector<int> v(loadPath.c_str(), ft::mmap_vector<int>::truncate);
+		v.resize_uninitialized(n);
+		for (size_t i = 0; i < n; ++i)
+			v[i] = static_cast<int>(i);
+		v.sync();
+	}
+	LOAD("open", NOTHING);
+	LOAD("open_sum", SUM);
+	LOAD("open_probe", PROBE);
+	h.run("store", "write", "mmap", storeMmap(n));
+	h.run("store", "write", "ft", storeWrite<ft::vector<int> >(n));
+	h.run("store", "write", "std", storeWrite<std::vector<int> >(n));
+
+	std::remove(loadPath.c_str());
+	std::remove(storePath.c_str());
+	return h.finish();
+}
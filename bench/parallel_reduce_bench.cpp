@@ -0,0 +1,64 @@
+#include <iostream>
+#include <cstdlib>
+#include <time.h>
+#include "../containers/vector.hpp"
+#include "../algorithm/parallel.hpp"
+
+// ./parallel_reduce_bench.out [elements] [max threads]; 1B ints needs 4 GB, 256M by default
+#define DEFAULT_SIZE 256000000L
+#define DEFAULT_MAX_THREADS 8
+#define ROUNDS 5
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+int main(int argc, char** argv)
+{
+	long n = argc > 1 ? atol(argv[1]) : DEFAULT_SIZE;
+	size_t maxThreads = argc > 2 ? atol(argv[2]) : DEFAULT_MAX_THREADS;
+	ft::vector<int> v(n);
+	for (long i = 0; i < n; ++i)
+		v[i] = static_cast<int>(i & 1023);
+	std::cout << "---- sum of " << n << " ints, " << ft::thread_pool::hardwareThreads()
+		<< " cores online, best of " << ROUNDS << " ----" << std::endl;
+
+	long expect = 0;
+	long seqMs = -1;
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		long start = nowNs();
+		long sum = 0;
+		for (ft::vector<int>::iterator it = v.begin(); it != v.end(); ++it)
+			sum += *it;
+		long ms = (nowNs() - start) / 1000000;
+		if (seqMs < 0 || ms < seqMs)
+			seqMs = ms;
+		expect = sum;
+	}
+	std::cout << "sequential loop\t\tms: " << seqMs << std::endl;
+
+	for (size_t threads = 1; threads <= maxThreads; threads *= 2)
+	{
+		ft::thread_pool pool(threads);
+		long best = -1;
+		bool right = true;
+		for (int r = 0; r < ROUNDS; ++r)
+		{
+			long start = nowNs();
+			long sum = ft::parallel_reduce(pool, v.begin(), v.end(), 0L, ft::plus<long>());
+			long ms = (nowNs() - start) / 1000000;
+			if (best < 0 || ms < best)
+				best = ms;
+			right = right && sum == expect;
+		}
+		std::cout << "parallel_reduce x" << threads << "\tms: " << best;
+		if (best)
+			std::cout << "\tspeedup: " << static_cast<double>(seqMs) / best;
+		std::cout << (right ? "" : "\tWRONG SUM") << std::endl;
+	}
+	return (0);
+}
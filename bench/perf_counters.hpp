@@ -0,0 +1,173 @@
+#ifndef BENCH_PERF_COUNTERS_H
+#define BENCH_PERF_COUNTERS_H
+
+#include <string>
+#include <cstring>
+#include <cerrno>
+#ifdef __linux__
+# include <linux/perf_event.h>
+# include <sys/ioctl.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif
+
+/**
+    * ------------------------------------------------------------- *
+    * -------------------- BENCH::PERF_COUNTERS ------------------- *
+    *
+    * Hardware counters of the calling thread through perf_event_open,
+    * user space only. Every event is opened on its own, so one the CPU
+    * or the kernel refuses only leaves that column empty; when the PMU
+    * has fewer counters than events the kernel multiplexes them and
+    * the counts are scaled by enabled / running time.
+    *
+    *     bench::perf_counters pc;
+    *     if (pc.open()) { pc.start(); work(); pc.stop(); pc.value(pc.CYCLES); }
+    *
+    * open() is false when no event could be opened: not Linux, a VM or
+    * container without a virtual PMU, or perf_event_paranoid above 2;
+    * status() says why. Everything else is then a no-op.
+    * ------------------------------------------------------------- *
+    */
+namespace bench {
+
+class perf_counters
+{
+public:
+	enum event { CYCLES, INSTRUCTIONS, L1D_MISSES, LLC_MISSES, DTLB_MISSES, BRANCH_MISSES, EVENTS };
+
+	perf_counters() : _opened(0), _status("not opened")
+	{
+		for (int e = 0; e < EVENTS; ++e)
+		{
+			_fds[e] = -1;
+			_values[e] = -1;
+		}
+	}
+
+	~perf_counters()
+	{
+#ifdef __linux__
+		for (int e = 0; e < EVENTS; ++e)
+			if (_fds[e] >= 0)
+				close(_fds[e]);
+#endif
+	}
+
+	// short column names
+	static const char* name(int e)
+	{
+		static const char* names[EVENTS] = { "cycles", "instructions", "l1d_miss", "llc_miss", "dtlb_miss", "branch_miss" };
+		return names[e];
+	}
+
+	// true when at least one event counts
+	bool open()
+	{
+#ifdef __linux__
+		int error = 0;
+		for (int e = 0; e < EVENTS; ++e)
+		{
+			if (_fds[e] >= 0)
+				continue;
+			struct perf_event_attr attr;
+			std::memset(&attr, 0, sizeof(attr));
+			attr.size = sizeof(attr);
+			configure(e, attr);
+			attr.disabled = 1;
+			attr.exclude_kernel = 1;
+			attr.exclude_hv = 1;
+			attr.read_format = PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+			_fds[e] = static_cast<int>(syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0));
+			if (_fds[e] >= 0)
+				++_opened;
+			else
+				error = errno;
+		}
+		if (_opened)
+			_status = "ok";
+		else if (error == EACCES || error == EPERM)
+			_status = std::string("not permitted (") + std::strerror(error) + "), see /proc/sys/kernel/perf_event_paranoid";
+		else
+			_status = std::string("no hardware counters (") + std::strerror(error) + ")";
+#else
+		_status = "perf_event_open needs Linux";
+#endif
+		return _opened > 0;
+	}
+
+	bool available() const { return _opened > 0; }
+	bool available(int e) const { return _fds[e] >= 0; }
+	const std::string& status() const { return _status; }
+
+	void start()
+	{
+#ifdef __linux__
+		for (int e = 0; e < EVENTS; ++e)
+			if (_fds[e] >= 0)
+			{
+				ioctl(_fds[e], PERF_EVENT_IOC_RESET, 0);
+				ioctl(_fds[e], PERF_EVENT_IOC_ENABLE, 0);
+			}
+#endif
+	}
+
+	void stop()
+	{
+#ifdef __linux__
+		for (int e = 0; e < EVENTS; ++e)
+			if (_fds[e] >= 0)
+				ioctl(_fds[e], PERF_EVENT_IOC_DISABLE, 0);
+		for (int e = 0; e < EVENTS; ++e)
+		{
+			_values[e] = -1;
+			// value, time enabled, time running
+			unsigned long long data[3];
+			if (_fds[e] >= 0 && read(_fds[e], data, sizeof(data)) == static_cast<ssize_t>(sizeof(data)) && data[2])
+				_values[e] = static_cast<double>(data[0]) * data[1] / data[2];
+		}
+#endif
+	}
+
+	// count of the last start / stop, -1 when the event is not available or never ran
+	double value(int e) const { return _values[e]; }
+
+private:
+	int _fds[EVENTS];
+	double _values[EVENTS];
+	int _opened;
+	std::string _status;
+
+	perf_counters(const perf_counters&);
+	perf_counters& operator=(const perf_counters&);
+
+#ifdef __linux__
+	static void configure(int e, struct perf_event_attr& attr)
+	{
+		attr.type = PERF_TYPE_HARDWARE;
+		switch (e)
+		{
+		case CYCLES:
+			attr.config = PERF_COUNT_HW_CPU_CYCLES;
+			break;
+		case INSTRUCTIONS:
+			attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+			break;
+		case LLC_MISSES:
+			attr.config = PERF_COUNT_HW_CACHE_MISSES;
+			break;
+		case BRANCH_MISSES:
+			attr.config = PERF_COUNT_HW_BRANCH_MISSES;
+			break;
+		default:
+			attr.type = PERF_TYPE_HW_CACHE;
+			attr.config = (e == L1D_MISSES ? PERF_COUNT_HW_CACHE_L1D : PERF_COUNT_HW_CACHE_DTLB)
+				| (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+		}
+	}
+#endif
+};
+
+}
+
+#endif
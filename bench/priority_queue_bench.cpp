@@ -0,0 +1,154 @@
+#include <iostream>
+#include <queue>
+#include <vector>
+#include <functional>
+#include <cstdlib>
+#include <time.h>
+#include "../containers/priority_queue.hpp"
+
+// ./priority_queue_bench.out [max elements], 100K up to 10M by default
+#define DEFAULT_MAX 10000000L
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+static void report(const char* name, long ms, long stdMs, long check, long stdCheck)
+{
+	std::cout << name << "\tms: " << ms;
+	if (ms)
+		std::cout << "\tstd / this: " << static_cast<double>(stdMs) / ms;
+	std::cout << (check == stdCheck ? "" : "\tWRONG ORDER") << std::endl;
+}
+
+// push everything one by one, then pop everything; returns an order checksum
+template <class Queue>
+long pushPop(Queue& q, const std::vector<int>& input)
+{
+	for (size_t i = 0; i < input.size(); ++i)
+		q.push(input[i]);
+	long check = 0;
+	for (long i = 1; !q.empty(); ++i, q.pop())
+		check += q.top() * (i & 7);
+	return check;
+}
+
+template <class Queue>
+long drain(Queue& q)
+{
+	long check = 0;
+	for (long i = 1; !q.empty(); ++i, q.pop())
+		check += q.top() * (i & 7);
+	return check;
+}
+
+template <size_t D>
+long ftPushPop(const std::vector<int>& input, long& check)
+{
+	ft::priority_queue<int, ft::vector<int>, ft::less<int>, D> q;
+	long start = nowNs();
+	check = pushPop(q, input);
+	return (nowNs() - start) / 1000000;
+}
+
+template <size_t D>
+long ftHeapify(const std::vector<int>& input, long& check)
+{
+	long start = nowNs();
+	ft::priority_queue<int, ft::vector<int>, ft::less<int>, D> q(input.begin(), input.end());
+	check = drain(q);
+	return (nowNs() - start) / 1000000;
+}
+
+int main(int argc, char** argv)
+{
+	long max = argc > 1 ? atol(argv[1]) : DEFAULT_MAX;
+	srand(42);
+	for (long n = 100000; n <= max; n *= 10)
+	{
+		std::vector<int> input(n);
+		for (long i = 0; i < n; ++i)
+			input[i] = rand();
+		long check;
+		long stdCheck;
+
+		std::cout << "---- push then pop " << n << " random ints ----" << std::endl;
+		long start = nowNs();
+		{
+			std::priority_queue<int> q;
+			stdCheck = pushPop(q, input);
+		}
+		long stdMs = (nowNs() - start) / 1000000;
+		std::cout << "std::priority_queue       \tms: " << stdMs << std::endl;
+		long ms = ftPushPop<2>(input, check);
+		report("ft::priority_queue D=2    ", ms, stdMs, check, stdCheck);
+		ms = ftPushPop<4>(input, check);
+		report("ft::priority_queue D=4    ", ms, stdMs, check, stdCheck);
+		ms = ftPushPop<8>(input, check);
+		report("ft::priority_queue D=8    ", ms, stdMs, check, stdCheck);
+
+		std::cout << "---- heapify then pop " << n << " random ints ----" << std::endl;
+		start = nowNs();
+		{
+			std::priority_queue<int> q(input.begin(), input.end());
+			stdCheck = drain(q);
+		}
+		stdMs = (nowNs() - start) / 1000000;
+		std::cout << "std::priority_queue       \tms: " << stdMs << std::endl;
+		ms = ftHeapify<2>(input, check);
+		report("ft::priority_queue D=2    ", ms, stdMs, check, stdCheck);
+		ms = ftHeapify<4>(input, check);
+		report("ft::priority_queue D=4    ", ms, stdMs, check, stdCheck);
+
+		// timers: n live deadlines, n reschedules to an earlier time, then expire all.
+		// std::priority_queue has no decrease-key: it pushes the new deadline and
+		// skips the stale entries when they surface
+		std::cout << "---- " << n << " timers, " << n << " decrease_key ----" << std::endl;
+		std::vector<int> handles(n);
+		std::vector<int> newer(n);
+		for (long i = 0; i < n; ++i)
+		{
+			handles[i] = rand() % n;
+			newer[i] = rand() % 1000;
+		}
+		start = nowNs();
+		{
+			std::vector<int> deadline(input);
+			std::priority_queue<std::pair<int, int>, std::vector<std::pair<int, int> >, std::greater<std::pair<int, int> > > q;
+			for (long i = 0; i < n; ++i)
+				q.push(std::make_pair(deadline[i], static_cast<int>(i)));
+			for (long i = 0; i < n; ++i)
+			{
+				int h = handles[i];
+				if (newer[i] < deadline[h])
+				{
+					deadline[h] = newer[i];
+					q.push(std::make_pair(newer[i], h));
+				}
+			}
+			stdCheck = 0;
+			for (long i = 1; !q.empty(); q.pop())
+			{
+				if (q.top().first != deadline[q.top().second])
+					continue;
+				stdCheck += q.top().first * (i++ & 7);
+			}
+		}
+		stdMs = (nowNs() - start) / 1000000;
+		std::cout << "std::priority_queue (lazy)\tms: " << stdMs << std::endl;
+		start = nowNs();
+		{
+			ft::indexed_priority_queue<int, ft::greater<int> > q(input.begin(), input.end());
+			for (long i = 0; i < n; ++i)
+				if (newer[i] < q.value(handles[i]))
+					q.decrease_key(handles[i], newer[i]);
+			check = drain(q);
+		}
+		ms = (nowNs() - start) / 1000000;
+		report("ft::indexed_priority_queue", ms, stdMs, check, stdCheck);
+	}
+	return (0);
+}
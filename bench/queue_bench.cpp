@@ -0,0 +1,246 @@
+#include <iostream>
+#include <cstdlib>
+#include <pthread.h>
+#include <time.h>
+#include "../containers/deque.hpp"
+#include "../containers/spsc_queue.hpp"
+#include "../containers/mpmc_queue.hpp"
+
+// ./queue_bench.out [items per producer]
+#define DEFAULT_ITEMS 1000000L
+#define RING 1024
+#define BATCH 64
+#define ROUND_TRIPS 20000
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+// the mutex wrapped container the pipeline stages use today, bounded like the rings
+struct locked_queue
+{
+	pthread_mutex_t lock;
+	ft::deque<long> queue;
+
+	locked_queue() { pthread_mutex_init(&lock, NULL); }
+	~locked_queue() { pthread_mutex_destroy(&lock); }
+
+	bool try_push(long val)
+	{
+		pthread_mutex_lock(&lock);
+		bool room = queue.size() < RING;
+		if (room)
+			queue.push_back(val);
+		pthread_mutex_unlock(&lock);
+		return room;
+	}
+
+	bool try_pop(long& out)
+	{
+		pthread_mutex_lock(&lock);
+		bool found = !queue.empty();
+		if (found)
+		{
+			out = queue.front();
+			queue.pop_front();
+		}
+		pthread_mutex_unlock(&lock);
+		return found;
+	}
+
+	void push(long val)
+	{
+		ft::spin_backoff backoff;
+		while (!try_push(val))
+			backoff.pause();
+	}
+
+	void pop(long& out)
+	{
+		ft::spin_backoff backoff;
+		while (!try_pop(out))
+			backoff.pause();
+	}
+};
+
+struct mpmc_ring : ft::mpmc_queue<long>
+{
+	mpmc_ring() : ft::mpmc_queue<long>(RING) {}
+};
+
+typedef ft::spsc_queue<long, RING> spsc_ring;
+
+template <typename Queue>
+struct job
+{
+	Queue* queue;
+	long items;
+	long sum;
+};
+
+template <typename Queue>
+void* producer(void* arg)
+{
+	job<Queue>& j = *static_cast<job<Queue>*>(arg);
+	for (long i = 0; i < j.items; ++i)
+		j.queue->push(i);
+	return NULL;
+}
+
+template <typename Queue>
+void* consumer(void* arg)
+{
+	job<Queue>& j = *static_cast<job<Queue>*>(arg);
+	long val;
+	for (long i = 0; i < j.items; ++i)
+	{
+		j.queue->pop(val);
+		j.sum += val;
+	}
+	return NULL;
+}
+
+void* batchProducer(void* arg)
+{
+	job<spsc_ring>& j = *static_cast<job<spsc_ring>*>(arg);
+	long batch[BATCH];
+	ft::spin_backoff backoff;
+	for (long i = 0; i < j.items; )
+	{
+		long n = 0;
+		for (; n < BATCH && i + n < j.items; ++n)
+			batch[n] = i + n;
+		long pushed = j.queue->try_push_batch(batch, batch + n);
+		if (!pushed)
+			backoff.pause();
+		i += pushed;
+	}
+	return NULL;
+}
+
+void* batchConsumer(void* arg)
+{
+	job<spsc_ring>& j = *static_cast<job<spsc_ring>*>(arg);
+	long batch[BATCH];
+	ft::spin_backoff backoff;
+	for (long i = 0; i < j.items; )
+	{
+		long popped = j.queue->try_pop_batch(batch, BATCH);
+		if (!popped)
+			backoff.pause();
+		for (long k = 0; k < popped; ++k)
+			j.sum += batch[k];
+		i += popped;
+	}
+	return NULL;
+}
+
+// producers threads push items each, consumers split them evenly; returns Mitems/s
+template <typename Queue>
+double throughput(const char* name, int producers, int consumers, long items,
+				  void* (*produce)(void*) = producer<Queue>, void* (*consume)(void*) = consumer<Queue>)
+{
+	Queue queue;
+	job<Queue> jobs[16];
+	pthread_t threads[16];
+	long total = items * producers;
+	long start = nowNs();
+	for (int i = 0; i < producers; ++i)
+	{
+		jobs[i].queue = &queue;
+		jobs[i].items = items;
+		jobs[i].sum = 0;
+		pthread_create(&threads[i], NULL, produce, &jobs[i]);
+	}
+	for (int i = 0; i < consumers; ++i)
+	{
+		job<Queue>& j = jobs[producers + i];
+		j.queue = &queue;
+		j.items = total / consumers + (i < total % consumers);
+		j.sum = 0;
+		pthread_create(&threads[producers + i], NULL, consume, &j);
+	}
+	long sum = 0;
+	for (int i = 0; i < producers + consumers; ++i)
+	{
+		pthread_join(threads[i], NULL);
+		if (i >= producers)
+			sum += jobs[i].sum;
+	}
+	double ms = (nowNs() - start) / 1000000.0;
+	double rate = total / ms / 1000.0;
+	std::cout << name << "\t" << producers << ":" << consumers << "\tms: " << static_cast<long>(ms)
+		<< "\tMitems/s: " << rate << (sum == producers * (items * (items - 1) / 2) ? "" : "\tLOST ITEMS") << std::endl;
+	return rate;
+}
+
+template <typename Queue>
+struct pingPong
+{
+	Queue there;
+	Queue back;
+};
+
+template <typename Queue>
+void* echo(void* arg)
+{
+	pingPong<Queue>& p = *static_cast<pingPong<Queue>*>(arg);
+	long val;
+	for (long i = 0; i < ROUND_TRIPS; ++i)
+	{
+		p.there.pop(val);
+		p.back.push(val);
+	}
+	return NULL;
+}
+
+// one element bounced between two threads: hand-off latency
+template <typename Queue>
+void latency(const char* name)
+{
+	pingPong<Queue> p;
+	pthread_t thread;
+	pthread_create(&thread, NULL, echo<Queue>, &p);
+	long val;
+	long start = nowNs();
+	for (long i = 0; i < ROUND_TRIPS; ++i)
+	{
+		p.there.push(i);
+		p.back.pop(val);
+	}
+	long ns = nowNs() - start;
+	pthread_join(thread, NULL);
+	std::cout << name << "\tround trip ns: " << ns / ROUND_TRIPS << std::endl;
+}
+
+int main(int argc, char** argv)
+{
+	long items = argc > 1 ? atol(argv[1]) : DEFAULT_ITEMS;
+
+	std::cout << "---- throughput, " << items << " items per producer ----" << std::endl;
+	double base = throughput<locked_queue>("mutex + ft::deque  ", 1, 1, items);
+	double rate = throughput<spsc_ring>("ft::spsc_queue     ", 1, 1, items);
+	std::cout << "\t\t\tvs mutex: " << rate / base << std::endl;
+	rate = throughput<spsc_ring>("ft::spsc_queue batch", 1, 1, items, batchProducer, batchConsumer);
+	std::cout << "\t\t\tvs mutex: " << rate / base << std::endl;
+	rate = throughput<mpmc_ring>("ft::mpmc_queue     ", 1, 1, items);
+	std::cout << "\t\t\tvs mutex: " << rate / base << std::endl;
+	for (int n = 2; n <= 4; n *= 2)
+	{
+		base = throughput<locked_queue>("mutex + ft::deque  ", n, n, items / n);
+		rate = throughput<mpmc_ring>("ft::mpmc_queue     ", n, n, items / n);
+		std::cout << "\t\t\tvs mutex: " << rate / base << std::endl;
+	}
+	base = throughput<locked_queue>("mutex + ft::deque  ", 4, 1, items / 4);
+	rate = throughput<mpmc_ring>("ft::mpmc_queue     ", 4, 1, items / 4);
+	std::cout << "\t\t\tvs mutex: " << rate / base << std::endl;
+
+	std::cout << "---- latency, " << ROUND_TRIPS << " round trips ----" << std::endl;
+	latency<locked_queue>("mutex + ft::deque  ");
+	latency<spsc_ring>("ft::spsc_queue     ");
+	latency<mpmc_ring>("ft::mpmc_queue     ");
+	return (0);
+}
@@ -0,0 +1,184 @@
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdio>
+#include <cstdlib>
+#include "harness.hpp"
+#include "../containers/radix_map.hpp"
+#include "../containers/map.hpp"
+
+/*
+ * ./radix_map_bench.out [harness options]
+ *
+ * ft::radix_map against ft::map and std::map on n keys (--n, 1M by
+ * default), inserted and looked up in random order.
+ *
+ * string suite: URL-like keys, "https://shop.example.com/api/v2/"
+ * then a tenant, a collection and a 10 digits id: long shared
+ * prefixes that a comparison tree compares again on every level.
+ * int suite: random 64-bit keys, 8 bytes apiece for the radix tree.
+ *
+ * ops: insert (into an empty map), find_hit, find_miss, lower_bound
+ * (absent keys, so the bound walks to the next branch) and iterate.
+ * Impls: radix (ft::radix_map), ft (ft::map), std (std::map); ft
+ * sits out lower_bound, which it answers by walking its nodes from
+ * begin().
+ */
+#define DEFAULT_N 1000000
+
+static const char* const tenants[] = {"acme", "globex", "initech", "umbrella", "hooli", "stark"};
+static const char* const collections[] = {"orders", "invoices", "customers", "shipments"};
+
+static std::string makeUrl(unsigned long id)
+{
+	char buf[128];
+	std::sprintf(buf, "https://shop.example.com/api/v2/%s/%s/%010lu", tenants[id % 6], collections[id / 6 % 4], id);
+	return buf;
+}
+
+// odd ids are inserted, even ones miss; random order keeps ft::map about 3 ln n deep
+static void makeKeys(size_t n, std::vector<std::string>& hits, std::vector<std::string>& misses)
+{
+	std::vector<unsigned long> ids(n);
+	for (size_t i = 0; i < n; ++i)
+		ids[i] = (i * 2654435761UL) & 0x7FFFFFFFUL;
+	srand(1);
+	for (size_t i = n; i > 1; --i)
+		std::swap(ids[i - 1], ids[rand() % i]);
+	for (size_t i = 0; i < n; ++i)
+	{
+		hits.push_back(makeUrl(ids[i] * 2 + 1));
+		misses.push_back(makeUrl(ids[i] * 2));
+	}
+}
+
+static unsigned long long random64()
+{
+	unsigned long long r = 0;
+	for (int i = 0; i < 4; ++i)
+		r = (r << 16) ^ static_cast<unsigned long long>(rand() & 0xFFFF);
+	return r;
+}
+
+static void makeKeys(size_t n, std::vector<unsigned long long>& hits, std::vector<unsigned long long>& misses)
+{
+	srand(2);
+	for (size_t i = 0; i < n; ++i)
+	{
+		unsigned long long k = random64();
+		hits.push_back(k | 1);
+		misses.push_back(k & ~1ULL);
+	}
+}
+
+template <class Key>
+struct keySets
+{
+	std::vector<Key> hits;
+	std::vector<Key> misses;
+
+	explicit keySets(size_t n) { makeKeys(n, hits, misses); }
+};
+
+template <class M>
+struct mapCase
+{
+	typedef typename M::key_type key_type;
+
+	const keySets<key_type>* keys;
+	M m;
+	bool built;
+
+	explicit mapCase(const keySets<key_type>& k) : keys(&k), built(false) {}
+
+	void build()
+	{
+		if (built)
+			return;
+		for (size_t i = 0; i < keys->hits.size(); ++i)
+			m[keys->hits[i]] = static_cast<int>(i);
+		built = true;
+	}
+	void setup() { build(); }
+	size_t ops() const { return keys->hits.size(); }
+};
+
+template <class M> struct mapInsert : mapCase<M> {
+	explicit mapInsert(const keySets<typename M::key_type>& k) : mapCase<M>(k) {}
+	void setup() { this->m.clear(); }
+	void run() {
+		for (size_t i = 0; i < this->keys->hits.size(); ++i)
+			this->m[this->keys->hits[i]] = static_cast<int>(i);
+		bench::keep(this->m);
+	}
+};
+template <class M> struct mapFindHit : mapCase<M> {
+	explicit mapFindHit(const keySets<typename M::key_type>& k) : mapCase<M>(k) {}
+	void run() {
+		size_t found = 0;
+		for (size_t i = 0; i < this->keys->hits.size(); ++i)
+			found += this->m.find(this->keys->hits[i]) != this->m.end();
+		bench::keep(found);
+	}
+};
+template <class M> struct mapFindMiss : mapCase<M> {
+	explicit mapFindMiss(const keySets<typename M::key_type>& k) : mapCase<M>(k) {}
+	void run() {
+		size_t found = 0;
+		for (size_t i = 0; i < this->keys->misses.size(); ++i)
+			found += this->m.find(this->keys->misses[i]) != this->m.end();
+		bench::keep(found);
+	}
+};
+template <class M> struct mapLowerBound : mapCase<M> {
+	explicit mapLowerBound(const keySets<typename M::key_type>& k) : mapCase<M>(k) {}
+	void run() {
+		long sum = 0;
+		for (size_t i = 0; i < this->keys->misses.size(); ++i)
+		{
+			typename M::iterator it = this->m.lower_bound(this->keys->misses[i]);
+			if (it != this->m.end())
+				sum += it->second;
+		}
+		bench::keep(sum);
+	}
+};
+template <class M> struct mapIterate : mapCase<M> {
+	explicit mapIterate(const keySets<typename M::key_type>& k) : mapCase<M>(k) {}
+	void run() {
+		long sum = 0;
+		for (typename M::iterator it = this->m.begin(); it != this->m.end(); ++it)
+			sum += it->second;
+		bench::keep(sum);
+	}
+};
+
+#define ALL(suite, op, Case, Key, keys) \
+	h.run(suite, op, "radix", Case<ft::radix_map<Key, int> >(keys)); \
+	h.run(suite, op, "ft", Case<ft::map<Key, int> >(keys)); \
+	h.run(suite, op, "std", Case<std::map<Key, int> >(keys))
+
+#define SUITE(suite, Key, keys) \
+	ALL(suite, "insert", mapInsert, Key, keys); \
+	ALL(suite, "find_hit", mapFindHit, Key, keys); \
+	ALL(suite, "find_miss", mapFindMiss, Key, keys); \
+	h.run(suite, "lower_bound", "radix", mapLowerBound<ft::radix_map<Key, int> >(keys)); \
+	h.run(suite, "lower_bound", "std", mapLowerBound<std::map<Key, int> >(keys)); \
+	ALL(suite, "iterate", mapIterate, Key, keys)
+
+int main(int argc, char** argv)
+{
+	bench::options opts(DEFAULT_N);
+	if (!opts.parse(argc, argv))
+	{
+		opts.usage(argv[0]);
+		return 2;
+	}
+	bench::harness h(opts);
+
+	keySets<std::string> urls(opts.n);
+	SUITE("string", std::string, urls);
+	keySets<unsigned long long> ints(opts.n);
+	SUITE("int", unsigned long long, ints);
+	return h.finish();
+}
@@ -0,0 +1,79 @@
+#include <iostream>
+#include <algorithm>
+#include <cstdlib>
+#include <time.h>
+#include "../containers/vector.hpp"
+#include "../containers/map.hpp"
+#include "../containers/static_search_index.hpp"
+
+#define QUERIES (1 << 22)
+#define MAP_LIMIT (1 << 20)
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+static void print(const char* name, long ns, long sum)
+{
+	std::cout << name << "\tns/query: " << static_cast<double>(ns) / QUERIES << "\t(ignore: " << sum << ")" << std::endl;
+}
+
+void bench(size_t n)
+{
+	ft::vector<int> sorted;
+	for (size_t i = 0; i < n; ++i)
+		sorted.push_back(static_cast<int>(2 * i));
+	ft::vector<int> queries;
+	for (size_t i = 0; i < QUERIES; ++i)
+		queries.push_back(rand() % static_cast<int>(2 * n));
+
+	std::cout << "---- " << n << " keys, " << QUERIES << " random queries ----" << std::endl;
+
+	long sum = 0;
+	const int* begin = &sorted[0];
+	const int* end = begin + n;
+	long start = nowNs();
+	for (size_t i = 0; i < QUERIES; ++i)
+		sum += std::lower_bound(begin, end, queries[i]) - begin;
+	print("binary search      ", nowNs() - start, sum);
+
+	ft::static_search_index<int> index(sorted);
+	sum = 0;
+	start = nowNs();
+	for (size_t i = 0; i < QUERIES; ++i)
+		sum += index.rank(queries[i]);
+	print("eytzinger          ", nowNs() - start, sum);
+
+	ft::vector<size_t> ranks(QUERIES);
+	sum = 0;
+	start = nowNs();
+	index.rank(&queries[0], QUERIES, &ranks[0]);
+	for (size_t i = 0; i < QUERIES; ++i)
+		sum += ranks[i];
+	print("eytzinger, batched ", nowNs() - start, sum);
+
+	if (n > MAP_LIMIT)
+		return;
+	ft::map<int, int> map;
+	ft::vector<int> shuffled(sorted);
+	std::random_shuffle(shuffled.begin(), shuffled.end());
+	for (size_t i = 0; i < n; ++i)
+		map[shuffled[i]] = static_cast<int>(i);
+	sum = 0;
+	start = nowNs();
+	for (size_t i = 0; i < QUERIES; ++i)
+		sum += map.find(queries[i]) != map.end();
+	print("ft::map::find      ", nowNs() - start, sum);
+}
+
+int main()
+{
+	srand(7);
+	bench(1 << 10);
+	bench(1 << 20);
+	bench(1 << 24);
+	return (0);
+}
@@ -0,0 +1,73 @@
+#include <iostream>
+#include <stdlib.h>
+#include <ctime>
+#include "../containers/vector.hpp"
+#include "../algorithm/algorithm.hpp"
+
+#define COUNT (1 << 24)
+#define ROUNDS 20
+
+template <typename T>
+void bench(const char* name)
+{
+	ft::vector<T> a;
+	for (int i = 0; i < COUNT; ++i)
+		a.push_back(static_cast<T>(rand() % 100 + 1));
+	ft::vector<T> b(a);
+	// read back through volatiles every round so the scalar loops cannot be hoisted out of them
+	const T* volatile pa = &a[0];
+	const T* volatile pb = &b[0];
+	const T missing = static_cast<T>(0);
+	size_t sink = 0;
+
+	std::cout << "---- " << name << " (" << COUNT << " elements, " << ROUNDS << " rounds) ----" << std::endl;
+
+	time_t start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += ft::simd::scalarEqual(pa, pb, COUNT);
+	time_t scalar = clock() - start;
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += (a == b);
+	std::cout << "equal      scalar: " << scalar << "\tft: " << (clock() - start) << std::endl;
+
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += ft::simd::scalarLexicographicalCompare(pa, COUNT, pb, COUNT);
+	scalar = clock() - start;
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += (a < b);
+	std::cout << "less       scalar: " << scalar << "\tft: " << (clock() - start) << std::endl;
+
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += ft::simd::scalarFind(pa, COUNT, missing);
+	scalar = clock() - start;
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += ft::find(a.begin(), a.end(), missing) - a.begin();
+	std::cout << "find miss  scalar: " << scalar << "\tft: " << (clock() - start) << std::endl;
+
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += ft::simd::scalarCount(pa, COUNT, a[0]);
+	scalar = clock() - start;
+	start = clock();
+	for (int r = 0; r < ROUNDS; ++r)
+		sink += ft::count(a.begin(), a.end(), a[0]);
+	std::cout << "count      scalar: " << scalar << "\tft: " << (clock() - start) << std::endl;
+
+	std::cout << "(ignore: " << sink << ")" << std::endl;
+}
+
+int main()
+{
+	srand(42);
+	std::cout << "avx2: " << (ft::simd::hasAvx2() ? "yes" : "no") << std::endl;
+	bench<char>("char");
+	bench<int>("int");
+	bench<long>("long");
+	bench<double>("double");
+	return (0);
+}
@@ -0,0 +1,59 @@
+#include <iostream>
+#include <time.h>
+#include "../containers/vector.hpp"
+#include "../containers/soa_vector.hpp"
+#include "../algorithm/algorithm.hpp"
+
+#define COUNT (1 << 22)
+#define ROUNDS 50
+
+typedef ft::pair<int, double> row;
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+int main()
+{
+	ft::vector<row> aos;
+	ft::soa_vector<row> soa;
+	for (int i = 0; i < COUNT; ++i)
+	{
+		aos.push_back(row(i % 1000, i * 0.5));
+		soa.push_back(row(i % 1000, i * 0.5));
+	}
+
+	std::cout << "---- " << ROUNDS << " scans of the int column, " << COUNT << " rows ----" << std::endl;
+
+	long sum = 0;
+	long start = nowNs();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (ft::vector<row>::iterator it = aos.begin(); it != aos.end(); ++it)
+			sum += it->first;
+	std::cout << "sum   vector<pair>\tms: " << (nowNs() - start) / 1000000 << std::endl;
+
+	start = nowNs();
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		ft::span<int> firsts = soa.firsts();
+		for (ft::span<int>::iterator it = firsts.begin(); it != firsts.end(); ++it)
+			sum += *it;
+	}
+	std::cout << "sum   soa_vector  \tms: " << (nowNs() - start) / 1000000 << std::endl;
+
+	start = nowNs();
+	for (int r = 0; r < ROUNDS; ++r)
+		for (ft::vector<row>::iterator it = aos.begin(); it != aos.end(); ++it)
+			sum += (it->first == r);
+	std::cout << "count vector<pair>\tms: " << (nowNs() - start) / 1000000 << std::endl;
+
+	start = nowNs();
+	for (int r = 0; r < ROUNDS; ++r)
+		sum += ft::count(soa.firsts().begin(), soa.firsts().end(), r);
+	std::cout << "count soa_vector  \tms: " << (nowNs() - start) / 1000000
+		<< "\t(ignore: " << sum << ")" << std::endl;
+	return (0);
+}
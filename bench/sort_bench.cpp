@@ -0,0 +1,65 @@
+#include <iostream>
+#include <algorithm>
+#include <vector>
+#include <cstdlib>
+#include <time.h>
+#include "../containers/vector.hpp"
+#include "../algorithm/sort.hpp"
+
+// ./sort_bench.out [max elements], 1M up to 100M by default; 1B needs ~12 GB
+#define DEFAULT_MAX 100000000L
+
+struct intLess { bool operator()(int a, int b) const { return a < b; } };
+
+static long nowNs()
+{
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000L + ts.tv_nsec;
+}
+
+template <typename Sorter>
+void bench(const char* name, const std::vector<int>& input, long stdMs, Sorter sorter)
+{
+	ft::vector<int> v(input.begin(), input.end());
+	long start = nowNs();
+	sorter(v);
+	long ms = (nowNs() - start) / 1000000;
+	bool sorted = true;
+	for (size_t i = 1; i < v.size() && sorted; ++i)
+		sorted = !(v[i] < v[i - 1]);
+	std::cout << name << "\tms: " << ms;
+	if (ms)
+		std::cout << "\tstd::sort / this: " << static_cast<double>(stdMs) / ms;
+	std::cout << (sorted ? "" : "\tNOT SORTED") << std::endl;
+}
+
+struct radixSorter { void operator()(ft::vector<int>& v) const { ft::sort(v.begin(), v.end()); } };
+struct introSorter { void operator()(ft::vector<int>& v) const { ft::sort(v.begin(), v.end(), intLess()); } };
+struct stableSorter { void operator()(ft::vector<int>& v) const { ft::stable_sort(v.begin(), v.end(), intLess()); } };
+struct parallelSorter { void operator()(ft::vector<int>& v) const { ft::parallel_sort(v.begin(), v.end(), intLess()); } };
+
+int main(int argc, char** argv)
+{
+	long max = argc > 1 ? atol(argv[1]) : DEFAULT_MAX;
+	srand(42);
+	for (long n = 1000000; n <= max; n *= 10)
+	{
+		std::vector<int> input(n);
+		for (long i = 0; i < n; ++i)
+			input[i] = rand();
+
+		std::cout << "---- " << n << " random ints ----" << std::endl;
+		std::vector<int> ref(input);
+		long start = nowNs();
+		std::sort(ref.begin(), ref.end());
+		long stdMs = (nowNs() - start) / 1000000;
+		std::cout << "std::sort              \tms: " << stdMs << std::endl;
+
+		bench("ft::sort (radix)       ", input, stdMs, radixSorter());
+		bench("ft::sort (introsort)   ", input, stdMs, introSorter());
+		bench("ft::stable_sort        ", input, stdMs, stableSorter());
+		bench("ft::parallel_sort      ", input, stdMs, parallelSorter());
+	}
+	return (0);
+}
@@ -0,0 +1,284 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <cstdlib>
+#include "harness.hpp"
+#include "../containers/string.hpp"
+#include "../containers/vector.hpp"
+#include "../containers/map.hpp"
+
+/*
+ * ./string_bench.out [harness options] [--key-len L]
+ *
+ * ft::string against std::string, as map keys and on their own. The
+ * n keys (--n, 10M by default) are a common prefix then 10 digits, L
+ * chars in all (19 by default: inline in an ft::string, on the heap in
+ * a libstdc++ std::string, which keeps 15). Each is distinct, inserted
+ * and looked up in random order so the unbalanced ft::map stays about
+ * 3 ln n deep.
+ *
+ * map suite, every impl an ft::map<Key, int> so only the key differs:
+ *   ft       ft::string keys
+ *   hashed   ft::hashed_string keys, compared by their stored hash first
+ *   std      std::string keys
+ * ops: insert (into an empty map), find_hit, find_miss, iterate.
+ *
+ * string suite, ft::string against std::string on the first 100000
+ * keys: copy, compare (neighbours share the prefix), find (8 chars
+ * from a 4 KB text), append and ft::vector push_back, which relocates
+ * ft::strings with memcpy and copies std::strings.
+ *
+ * 10M keys take a few GB and a minute per rep; --reps 3 --warmup 0
+ * keeps a full run short.
+ */
+#define DEFAULT_N 10000000
+#define STRING_N 100000
+#define DEFAULT_KEY_LEN "19"
+#define TEXT_LEN 4096
+#define QUERIES 1000
+
+typedef ft::map<ft::string, int>			ft_map;
+typedef ft::map<ft::hashed_string, int>		hashed_map;
+typedef ft::map<std::string, int>			std_map;
+
+// key i of n: a prefix cut to len - 10 chars, then a 10 digits id; ids are distinct for i < 2^32
+static std::string makeKey(size_t i, size_t len)
+{
+	static const char prefix[] = "tenant/customers/orders/";
+	char id[16];
+	std::sprintf(id, "%010lu", static_cast<unsigned long>((i * 2654435761UL) & 0xFFFFFFFFUL));
+	std::string key;
+	for (size_t j = 0; key.size() + 10 < len; ++j)
+		key += prefix[j % (sizeof(prefix) - 1)];
+	return key + id;
+}
+
+static std::vector<std::string> makeKeys(size_t first, size_t n, size_t len, unsigned seed)
+{
+	std::vector<std::string> keys(n);
+	for (size_t i = 0; i < n; ++i)
+		keys[i] = makeKey(first + i, len);
+	srand(seed);
+	for (size_t i = n; i > 1; --i)
+		keys[i - 1].swap(keys[rand() % i]);
+	return keys;
+}
+
+// the key types, each built from the std::string keys outside the timings
+template <class Key> Key convert(const std::string& s) { return Key(s.c_str(), s.size()); }
+template <> std::string convert<std::string>(const std::string& s) { return s; }
+
+template <class Key>
+static void convertAll(const std::vector<std::string>& from, std::vector<Key>& to)
+{
+	to.clear();
+	to.reserve(from.size());
+	for (size_t i = 0; i < from.size(); ++i)
+		to.push_back(convert<Key>(from[i]));
+}
+
+/* --------------------------------- map --------------------------------- */
+
+struct keySets
+{
+	std::vector<std::string> inserted;		// insertion order
+	std::vector<std::string> hits;			// the same keys in another order
+	std::vector<std::string> misses;		// absent keys
+};
+
+// the keys are converted on the first setup, so filtered out cases cost nothing
+template <class M>
+struct mapCase
+{
+	typedef typename M::key_type key_type;
+
+	const keySets* sets;
+	std::vector<key_type> inserted;
+	std::vector<key_type> queries;
+	M m;
+	bool built;
+
+	explicit mapCase(const keySets& s) : sets(&s), built(false) {}
+
+	void build()
+	{
+		if (built)
+			return;
+		convertAll(sets->inserted, inserted);
+		for (size_t i = 0; i < inserted.size(); ++i)
+			m.insert(ft::make_pair(inserted[i], static_cast<int>(i)));
+		built = true;
+	}
+	size_t ops() const { return inserted.size(); }
+};
+
+template <class M> struct mapInsert : mapCase<M> {
+	explicit mapInsert(const keySets& s) : mapCase<M>(s) {}
+	void setup() {
+		if (this->inserted.empty())
+			convertAll(this->sets->inserted, this->inserted);
+		this->m.clear();
+	}
+	void run() {
+		for (size_t i = 0; i < this->inserted.size(); ++i)
+			this->m.insert(ft::make_pair(this->inserted[i], static_cast<int>(i)));
+		bench::keep(this->m);
+	}
+};
+template <class M> struct mapFindHit : mapCase<M> {
+	explicit mapFindHit(const keySets& s) : mapCase<M>(s) {}
+	void setup() {
+		this->build();
+		if (this->queries.empty())
+			convertAll(this->sets->hits, this->queries);
+	}
+	void run() {
+		size_t found = 0;
+		for (size_t i = 0; i < this->queries.size(); ++i)
+			found += this->m.find(this->queries[i]) != this->m.end();
+		bench::keep(found);
+	}
+};
+template <class M> struct mapFindMiss : mapCase<M> {
+	explicit mapFindMiss(const keySets& s) : mapCase<M>(s) {}
+	void setup() {
+		this->build();
+		if (this->queries.empty())
+			convertAll(this->sets->misses, this->queries);
+	}
+	void run() {
+		size_t found = 0;
+		for (size_t i = 0; i < this->queries.size(); ++i)
+			found += this->m.find(this->queries[i]) != this->m.end();
+		bench::keep(found);
+	}
+	size_t ops() const { return this->queries.size(); }
+};
+template <class M> struct mapIterate : mapCase<M> {
+	explicit mapIterate(const keySets& s) : mapCase<M>(s) {}
+	void setup() { this->build(); }
+	void run() {
+		long sum = 0;
+		for (typename M::iterator it = this->m.begin(); it != this->m.end(); ++it)
+			sum += it->second;
+		bench::keep(sum);
+	}
+};
+
+/* -------------------------------- string ------------------------------- */
+
+template <class S>
+struct stringCase
+{
+	std::vector<S> keys;
+	S text;
+	std::vector<S> needles;
+
+	explicit stringCase(const std::vector<std::string>& from)
+	{
+		convertAll(from, keys);
+		srand(3);
+		std::string t(TEXT_LEN, ' ');
+		for (size_t i = 0; i < TEXT_LEN; ++i)
+			t[i] = static_cast<char>('a' + rand() % 26);
+		text = convert<S>(t);
+		for (size_t i = 0; i < QUERIES; ++i)
+			needles.push_back(convert<S>(t.substr(rand() % (TEXT_LEN - 8), 8)));
+	}
+
+	void setup() {}
+	size_t ops() const { return keys.size(); }
+};
+
+template <class S> struct strCopy : stringCase<S> {
+	explicit strCopy(const std::vector<std::string>& from) : stringCase<S>(from) {}
+	void run() {
+		for (size_t i = 0; i < this->keys.size(); ++i)
+		{
+			S copy(this->keys[i]);
+			bench::keep(copy);
+		}
+	}
+};
+template <class S> struct strCompare : stringCase<S> {
+	explicit strCompare(const std::vector<std::string>& from) : stringCase<S>(from) {}
+	void run() {
+		int sum = 0;
+		for (size_t i = 1; i < this->keys.size(); ++i)
+			sum += this->keys[i - 1].compare(this->keys[i]) < 0;
+		bench::keep(sum);
+	}
+};
+template <class S> struct strFind : stringCase<S> {
+	explicit strFind(const std::vector<std::string>& from) : stringCase<S>(from) {}
+	void run() {
+		size_t sum = 0;
+		for (size_t i = 0; i < this->needles.size(); ++i)
+			sum += this->text.find(this->needles[i]);
+		bench::keep(sum);
+	}
+	size_t ops() const { return this->needles.size(); }
+};
+template <class S> struct strAppend : stringCase<S> {
+	explicit strAppend(const std::vector<std::string>& from) : stringCase<S>(from) {}
+	void run() {
+		S all;
+		for (size_t i = 0; i < this->keys.size(); ++i)
+			all += this->keys[i];
+		bench::keep(all);
+	}
+};
+template <class S> struct strVectorPushBack : stringCase<S> {
+	explicit strVectorPushBack(const std::vector<std::string>& from) : stringCase<S>(from) {}
+	void run() {
+		ft::vector<S> v;
+		for (size_t i = 0; i < this->keys.size(); ++i)
+			v.push_back(this->keys[i]);
+		bench::keep(v);
+	}
+};
+
+#define BOTH(suite, op, Case, from) \
+	h.run(suite, op, "ft", Case<ft::string>(from)); \
+	h.run(suite, op, "std", Case<std::string>(from))
+
+#define ALL_KEYS(op, Case) \
+	h.run("map", op, "ft", Case<ft_map>(sets)); \
+	h.run("map", op, "hashed", Case<hashed_map>(sets)); \
+	h.run("map", op, "std", Case<std_map>(sets))
+
+int main(int argc, char** argv)
+{
+	bench::options opts(DEFAULT_N);
+	opts.declare("--key-len", DEFAULT_KEY_LEN);
+	if (!opts.parse(argc, argv) || opts.getNumber("--key-len") < 10)
+	{
+		opts.usage(argv[0]);
+		std::cerr << "  --key-len L             chars per key, 10 or more (" << DEFAULT_KEY_LEN << ")" << std::endl;
+		return 2;
+	}
+	bench::harness h(opts);
+	size_t n = opts.n;
+	size_t len = static_cast<size_t>(opts.getNumber("--key-len"));
+
+	keySets sets;
+	sets.inserted = makeKeys(0, n, len, 1);
+	sets.hits = sets.inserted;
+	srand(2);
+	for (size_t i = n; i > 1; --i)
+		sets.hits[i - 1].swap(sets.hits[rand() % i]);
+	sets.misses = makeKeys(n, n, len, 3);
+
+	std::vector<std::string> few(sets.inserted.begin(), sets.inserted.begin() + std::min<size_t>(n, STRING_N));
+	BOTH("string", "copy", strCopy, few);
+	BOTH("string", "compare", strCompare, few);
+	BOTH("string", "find", strFind, few);
+	BOTH("string", "append", strAppend, few);
+	BOTH("string", "vector_push_back", strVectorPushBack, few);
+
+	ALL_KEYS("insert", mapInsert);
+	ALL_KEYS("find_hit", mapFindHit);
+	ALL_KEYS("find_miss", mapFindMiss);
+	ALL_KEYS("iterate", mapIterate);
+	return h.finish();
+}
@@ -0,0 +1,99 @@
+#ifndef ATOMIC_H
+#define ATOMIC_H
+
+#include <cstddef>
+#include <sched.h>
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+#endif
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::ATOMIC ------------------------ *
+    *
+    * C++98 has no <atomic>: these wrap the GCC / clang __atomic
+    * builtins for the lock-free containers. T is any integral or
+    * pointer type of at most 8 bytes. Loads acquire, stores release,
+    * read-modify-writes are acq_rel unless the name says otherwise,
+    * atomic_thread_fence is seq_cst.
+    * ------------------------------------------------------------- *
+    */
+
+template <class T>
+inline T atomic_load(const T* p) { return __atomic_load_n(p, __ATOMIC_ACQUIRE); }
+
+template <class T>
+inline T atomic_load_relaxed(const T* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+
+template <class T>
+inline void atomic_store(T* p, T val) { __atomic_store_n(p, val, __ATOMIC_RELEASE); }
+
+template <class T>
+inline void atomic_store_relaxed(T* p, T val) { __atomic_store_n(p, val, __ATOMIC_RELAXED); }
+
+template <class T>
+inline T atomic_exchange(T* p, T val) { return __atomic_exchange_n(p, val, __ATOMIC_ACQ_REL); }
+
+template <class T>
+inline T atomic_fetch_add(T* p, T val) { return __atomic_fetch_add(p, val, __ATOMIC_ACQ_REL); }
+
+template <class T>
+inline T atomic_fetch_add_relaxed(T* p, T val) { return __atomic_fetch_add(p, val, __ATOMIC_RELAXED); }
+
+// on failure expected is updated to the current value
+template <class T>
+inline bool atomic_compare_exchange(T* p, T& expected, T desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+}
+
+// for the algorithms whose proof needs one total order over the CAS and the fences
+template <class T>
+inline bool atomic_compare_exchange_seq_cst(T* p, T& expected, T desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, false, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+
+// padding that keeps fields written by different threads off one cache line (false sharing)
+static const size_t CACHE_LINE = 64;
+
+inline void atomic_thread_fence() { __atomic_thread_fence(__ATOMIC_SEQ_CST); }
+
+// a seqlock's two halves: plain writes after a release fence stay after the stores
+// before it, plain reads before an acquire fence stay before the loads after it
+inline void atomic_thread_fence_release() { __atomic_thread_fence(__ATOMIC_RELEASE); }
+inline void atomic_thread_fence_acquire() { __atomic_thread_fence(__ATOMIC_ACQUIRE); }
+
+// spin-wait hint
+inline void cpu_relax()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    _mm_pause();
+#endif
+}
+
+// steps of a spin-wait loop: pause a few times, then give the core
+// away, in case the thread being waited on needs this very core
+class spin_backoff
+{
+public:
+    spin_backoff() : _spins(0) {}
+
+    void pause() {
+        if (_spins < SPIN_LIMIT)
+        {
+            ++_spins;
+            cpu_relax();
+        }
+        else
+            sched_yield();
+    }
+
+private:
+    static const unsigned SPIN_LIMIT = 64;
+
+    unsigned _spins;
+};
+
+}
+
+#endif
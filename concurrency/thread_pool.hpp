@@ -0,0 +1,292 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <pthread.h>
+#include <unistd.h>
+#include <cstdlib>
+#include "atomic.hpp"
+#include "work_stealing_deque.hpp"
+#include "../containers/deque.hpp"
+
+namespace ft {
+
+// unit of work run by a thread_pool, deleted by the pool once run
+class task
+{
+public:
+    virtual ~task() {}
+    virtual void run() = 0;
+};
+
+// counts the unfinished tasks of one parallel call; the last count_down
+// only touches the latch under its mutex, so a waiter that saw it open
+// may destroy it right away
+class task_latch
+{
+public:
+    explicit task_latch(long count = 0) : _pending(count), _open(count == 0) {
+        pthread_mutex_init(&_lock, NULL);
+        pthread_cond_init(&_done, NULL);
+    }
+
+    ~task_latch() {
+        pthread_cond_destroy(&_done);
+        pthread_mutex_destroy(&_lock);
+    }
+
+    // only before the tasks counted so far can all have finished
+    void add(long count) { atomic_fetch_add(&_pending, count); }
+
+    void count_down() {
+        if (atomic_fetch_add(&_pending, -1L) == 1)
+        {
+            pthread_mutex_lock(&_lock);
+            _open = true;
+            pthread_cond_broadcast(&_done);
+            pthread_mutex_unlock(&_lock);
+        }
+    }
+
+    bool ready() {
+        if (atomic_load(&_pending))
+            return false;
+        pthread_mutex_lock(&_lock);
+        bool open = _open;
+        pthread_mutex_unlock(&_lock);
+        return open;
+    }
+
+    void block() {
+        pthread_mutex_lock(&_lock);
+        while (!_open)
+            pthread_cond_wait(&_done, &_lock);
+        pthread_mutex_unlock(&_lock);
+    }
+
+private:
+    long _pending;
+    bool _open;
+    pthread_mutex_t _lock;
+    pthread_cond_t _done;
+
+    task_latch(const task_latch&);
+    task_latch& operator=(const task_latch&);
+};
+
+/**
+    * ------------------------------------------------------------- *
+    * ----------------------- FT::THREAD_POOL --------------------- *
+    *
+    * Fixed set of worker threads, each owning an ft::work_stealing_deque
+    * of tasks. A worker runs its own tasks newest first, then the ones
+    * submitted from outside the pool, then steals the oldest task of
+    * another worker; idle workers sleep on a condition variable.
+    *
+    * spawn:        Queue a task; from a worker of this pool it goes on
+    *               that worker's own deque, otherwise on the shared queue
+    * wait:         Block until a task_latch opens; a worker of this pool
+    *               keeps running tasks meanwhile, so nested parallel
+    *               loops do not deadlock
+    * shared:       Process wide pool with one worker per core
+    * ------------------------------------------------------------- *
+    */
+class thread_pool
+{
+public:
+    typedef size_t size_type;
+
+    // 0 threads: one per online core
+    explicit thread_pool(size_type threads = 0) : _count(threads ? threads : hardwareThreads()), _sleeping(0), _stop(false) {
+        pthread_mutex_init(&_lock, NULL);
+        pthread_cond_init(&_wake, NULL);
+        _workers = new worker[_count];
+        for (size_type i = 0; i < _count; ++i)
+        {
+            _workers[i].pool = this;
+            _workers[i].seed = static_cast<unsigned>(i * 2654435761u + 1);
+        }
+        for (size_type i = 0; i < _count; ++i)
+            pthread_create(&_workers[i].thread, NULL, &thread_pool::workerMain, &_workers[i]);
+    }
+
+    ~thread_pool() {
+        pthread_mutex_lock(&_lock);
+        _stop = true;
+        pthread_cond_broadcast(&_wake);
+        pthread_mutex_unlock(&_lock);
+        for (size_type i = 0; i < _count; ++i)
+            pthread_join(_workers[i].thread, NULL);
+        task* t;
+        for (size_type i = 0; i < _count; ++i)
+            while (_workers[i].tasks.take(t))
+                delete t;
+        for (; !_injected.empty(); _injected.pop_front())
+            delete _injected.front();
+        delete[] _workers;
+        pthread_cond_destroy(&_wake);
+        pthread_mutex_destroy(&_lock);
+    }
+
+    size_type size() const { return _count; }
+
+    void spawn(task* t) {
+        worker* self = current();
+        if (self && self->pool == this)
+        {
+            self->tasks.push(t);
+            atomic_thread_fence();
+            if (atomic_load(&_sleeping))
+            {
+                pthread_mutex_lock(&_lock);
+                pthread_cond_signal(&_wake);
+                pthread_mutex_unlock(&_lock);
+            }
+            return;
+        }
+        pthread_mutex_lock(&_lock);
+        _injected.push_back(t);
+        pthread_cond_signal(&_wake);
+        pthread_mutex_unlock(&_lock);
+    }
+
+    void wait(task_latch& latch) {
+        worker* self = current();
+        if (!self || self->pool != this)
+        {
+            latch.block();
+            return;
+        }
+        spin_backoff backoff;
+        while (!latch.ready())
+        {
+            task* t = findTask(*self);
+            if (t)
+                runTask(t);
+            else
+                backoff.pause();
+        }
+    }
+
+    static thread_pool& shared() {
+        static thread_pool pool;
+        return pool;
+    }
+
+    static size_type hardwareThreads() {
+        long n = sysconf(_SC_NPROCESSORS_ONLN);
+        return n > 0 ? static_cast<size_type>(n) : 1;
+    }
+
+private:
+    struct worker {
+        pthread_t thread;
+        work_stealing_deque<task*> tasks;
+        thread_pool* pool;
+        unsigned seed;
+    };
+
+    worker* _workers;
+    size_type _count;
+    long _sleeping;
+    bool _stop;
+    ft::deque<task*> _injected;
+    pthread_mutex_t _lock;
+    pthread_cond_t _wake;
+
+    thread_pool(const thread_pool&);
+    thread_pool& operator=(const thread_pool&);
+
+    // the worker running on this thread, NULL outside any pool
+    static pthread_key_t workerKey() {
+        static pthread_key_t key = createKey();
+        return key;
+    }
+
+    static pthread_key_t createKey() {
+        pthread_key_t key;
+        pthread_key_create(&key, NULL);
+        return key;
+    }
+
+    static worker* current() { return static_cast<worker*>(pthread_getspecific(workerKey())); }
+
+    static void runTask(task* t) {
+        t->run();
+        delete t;
+    }
+
+    task* popInjected() {
+        task* t = NULL;
+        pthread_mutex_lock(&_lock);
+        if (!_injected.empty())
+        {
+            t = _injected.front();
+            _injected.pop_front();
+        }
+        pthread_mutex_unlock(&_lock);
+        return t;
+    }
+
+    task* findTask(worker& self) {
+        task* t;
+        if (self.tasks.take(t))
+            return t;
+        if ((t = popInjected()))
+            return t;
+        self.seed = self.seed * 1103515245u + 12345u;
+        size_type start = self.seed % _count;
+        for (size_type i = 0; i < _count; ++i)
+        {
+            worker& victim = _workers[(start + i) % _count];
+            if (&victim != &self && victim.tasks.steal(t))
+                return t;
+        }
+        return NULL;
+    }
+
+    bool workVisible() const {
+        if (!_injected.empty())
+            return true;
+        for (size_type i = 0; i < _count; ++i)
+            if (!_workers[i].tasks.empty())
+                return true;
+        return false;
+    }
+
+    // sleeps unless work showed up; pairs with the fence in spawn so no wake-up is lost
+    void sleep() {
+        pthread_mutex_lock(&_lock);
+        atomic_fetch_add(&_sleeping, 1L);
+        atomic_thread_fence();
+        if (!_stop && !workVisible())
+            pthread_cond_wait(&_wake, &_lock);
+        atomic_fetch_add(&_sleeping, -1L);
+        pthread_mutex_unlock(&_lock);
+    }
+
+    static void* workerMain(void* arg) {
+        worker& self = *static_cast<worker*>(arg);
+        thread_pool& pool = *self.pool;
+        pthread_setspecific(workerKey(), &self);
+        while (true)
+        {
+            task* t = pool.findTask(self);
+            if (t)
+            {
+                runTask(t);
+                continue;
+            }
+            pthread_mutex_lock(&pool._lock);
+            bool stop = pool._stop;
+            pthread_mutex_unlock(&pool._lock);
+            if (stop)
+                break;
+            pool.sleep();
+        }
+        return NULL;
+    }
+};
+
+}
+
+#endif
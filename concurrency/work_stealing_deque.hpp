@@ -0,0 +1,138 @@
+#ifndef WORK_STEALING_DEQUE_H
+#define WORK_STEALING_DEQUE_H
+
+#include <cstddef>
+#include "atomic.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------ FT::WORK_STEALING_DEQUE ------------------ *
+    *
+    * Chase-Lev deque (in the C11 formulation of Le, Pop, Cohen and
+    * Zappa Nardelli, PPoPP 2013). One owner thread pushes and takes
+    * at the bottom, LIFO, without any CAS unless a single element is
+    * left; any other thread steals at the top, FIFO, with one CAS.
+    *
+    * T is moved with plain atomic loads and stores: a pointer or an
+    * integer of at most 8 bytes, usually a task pointer.
+    *
+    * The ring doubles when full. The old ring may still be read by a
+    * thief that loaded it before the switch, so it is kept until the
+    * deque is destroyed (they add up to less than the live ring).
+    *
+    * push, take:   Owner only
+    * steal:        Any thread; false when empty or when it lost a race
+    * empty, size:  Snapshots, may be stale as soon as they return
+    * ------------------------------------------------------------- *
+    */
+template <class T>
+class work_stealing_deque
+{
+public:
+    typedef T value_type;
+    typedef size_t size_type;
+
+    explicit work_stealing_deque(size_type capacity = 64) : _top(0), _bottom(0) {
+        size_type c = 1;
+        while (c < capacity)
+            c <<= 1;
+        _ring = new ring(static_cast<long>(c), NULL);
+    }
+
+    ~work_stealing_deque() {
+        while (_ring)
+        {
+            ring* older = _ring->older;
+            delete _ring;
+            _ring = older;
+        }
+    }
+
+    void push(value_type x) {
+        long b = atomic_load_relaxed(&_bottom);
+        long t = atomic_load(&_top);
+        ring* r = atomic_load_relaxed(&_ring);
+        if (b - t > r->mask)
+            r = grow(r, t, b);
+        r->put(b, x);
+        atomic_store(&_bottom, b + 1);
+    }
+
+    bool take(value_type& out) {
+        long b = atomic_load_relaxed(&_bottom) - 1;
+        ring* r = atomic_load_relaxed(&_ring);
+        atomic_store_relaxed(&_bottom, b);
+        atomic_thread_fence();
+        long t = atomic_load_relaxed(&_top);
+        if (t > b)
+        {
+            atomic_store_relaxed(&_bottom, b + 1);
+            return false;
+        }
+        out = r->get(b);
+        if (t == b)
+        {
+            // last element: race the thieves for it
+            bool won = atomic_compare_exchange_seq_cst(&_top, t, t + 1);
+            atomic_store_relaxed(&_bottom, b + 1);
+            return won;
+        }
+        return true;
+    }
+
+    bool steal(value_type& out) {
+        long t = atomic_load(&_top);
+        atomic_thread_fence();
+        long b = atomic_load(&_bottom);
+        if (t >= b)
+            return false;
+        ring* r = atomic_load(&_ring);
+        out = r->get(t);
+        return atomic_compare_exchange_seq_cst(&_top, t, t + 1);
+    }
+
+    bool empty() const { return size() == 0; }
+
+    size_type size() const {
+        long b = atomic_load(&_bottom);
+        long t = atomic_load(&_top);
+        return b > t ? static_cast<size_type>(b - t) : 0;
+    }
+
+private:
+    struct ring {
+        long mask;
+        T* slots;
+        ring* older;
+
+        ring(long capacity, ring* previous) : mask(capacity - 1), slots(new T[capacity]), older(previous) {}
+        ~ring() { delete[] slots; }
+
+        T get(long i) const { return atomic_load_relaxed(&slots[i & mask]); }
+        void put(long i, T x) { atomic_store_relaxed(&slots[i & mask], x); }
+
+        private:
+            ring(const ring&);
+            ring& operator=(const ring&);
+    };
+
+    long _top;
+    long _bottom;
+    ring* _ring;
+
+    work_stealing_deque(const work_stealing_deque&);
+    work_stealing_deque& operator=(const work_stealing_deque&);
+
+    ring* grow(ring* r, long t, long b) {
+        ring* bigger = new ring(2 * (r->mask + 1), r);
+        for (long i = t; i < b; ++i)
+            bigger->put(i, r->get(i));
+        atomic_store(&_ring, bigger);
+        return bigger;
+    }
+};
+
+}
+
+#endif
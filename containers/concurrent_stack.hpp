@@ -0,0 +1,272 @@
+#ifndef CONCURRENT_STACK_H
+#define CONCURRENT_STACK_H
+
+#include <pthread.h>
+#include <memory>
+#include <new>
+#include "../concurrency/atomic.hpp"
+#include "../utility.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * -------------------- FT::CONCURRENT_STACK ------------------- *
+    *
+    * Lock-free Treiber stack, safe to push and pop from any number of
+    * threads.
+    *
+    * Nodes are named by 32 bit indices into a pool of blocks that is
+    * only given back by the destructor, and the head is one 64 bit
+    * word: node index in the low half, a tag bumped by every update in
+    * the high half. A pop that read a head, slept while the node was
+    * popped and pushed back, then retries its compare-and-swap fails on
+    * the tag (ABA), and reading the next index of a node another
+    * thread just popped is always valid memory (reclamation).
+    *
+    * Popped nodes go to a freelist built the same way, so once the pool
+    * is large enough push and pop never allocate; the pool only grows,
+    * under a mutex, when the freelist is empty. There is no size(): a
+    * shared counter would be one more contended atomic per operation.
+    *
+    * push, push_range:     Add one element, or a whole range with one CAS
+    * try_pop:              Remove the top element into out, false if empty
+    * pop_all:              Detach the whole stack with one CAS and write it
+    *                       to out, top first
+    * empty:                Snapshot, may be stale as soon as it returns
+    * ------------------------------------------------------------- *
+    */
+template < class T, class Alloc = std::allocator<T> >
+class concurrent_stack
+{
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef size_t size_type;
+
+    explicit concurrent_stack(const allocator_type& alloc = allocator_type())
+        : _head(0), _free(0), _blockCount(0), _allocBlock(alloc)
+    {
+        for (size_type b = 0; b < MAX_BLOCKS; ++b)
+            _blocks[b] = NULL;
+        pthread_mutex_init(&_growLock, NULL);
+    }
+
+    ~concurrent_stack() {
+        for (index_type i = headIndex(_head); i; i = node(i).next)
+            node(i).value()->~T();
+        for (size_type b = 0; b < _blockCount; ++b)
+            _allocBlock.deallocate(_blocks[b], blockSize(b));
+        pthread_mutex_destroy(&_growLock);
+    }
+
+    void push(const value_type& val) {
+        index_type i = allocateNode();
+        try
+        {
+            new (node(i).storage) T(val);
+        }
+        catch (...)
+        {
+            pushChain(_free, i, i);
+            throw;
+        }
+        pushChain(_head, i, i);
+    }
+
+    // the range shows up on the stack at once, its last element on top; if a copy
+    // (or the iterator) throws, none of it does
+    template <class InputIterator>
+    void push_range(InputIterator first, InputIterator last) {
+        index_type top = 0;
+        index_type bottom = 0;
+        // taken from the freelist, its element not built yet
+        index_type taken = 0;
+        try
+        {
+            for (; first != last; ++first)
+            {
+                taken = allocateNode();
+                new (node(taken).storage) T(*first);
+                atomic_store_relaxed(&node(taken).next, top);
+                if (!top)
+                    bottom = taken;
+                top = taken;
+                taken = 0;
+            }
+        }
+        catch (...)
+        {
+            if (taken)
+                pushChain(_free, taken, taken);
+            if (top)
+            {
+                for (index_type i = top; i; i = node(i).next)
+                    node(i).value()->~T();
+                pushChain(_free, top, bottom);
+            }
+            throw;
+        }
+        if (!top)
+            return;
+        pushChain(_head, top, bottom);
+    }
+
+    bool try_pop(value_type& out) {
+        index_type i = popNode(_head);
+        if (!i)
+            return false;
+        T* val = node(i).value();
+        out = *val;
+        val->~T();
+        pushChain(_free, i, i);
+        return true;
+    }
+
+    // returns how many elements were written
+    template <class OutputIterator>
+    size_type pop_all(OutputIterator out) {
+        index_type top = headIndex(detachAll(_head));
+        if (!top)
+            return 0;
+        index_type bottom = top;
+        size_type count = 0;
+        for (index_type i = top; i; i = node(i).next, ++count)
+        {
+            T* val = node(i).value();
+            *out++ = *val;
+            val->~T();
+            bottom = i;
+        }
+        pushChain(_free, top, bottom);
+        return count;
+    }
+
+    bool empty() const { return !headIndex(atomic_load(&_head)); }
+
+    // nodes owned by the pool, in use or free
+    size_type capacity() const { return atomic_load(&_blockCount) ? BLOCK_BASE * ((size_type(1) << atomic_load(&_blockCount)) - 1) : 0; }
+
+private:
+    typedef unsigned int index_type;
+    typedef unsigned long long head_type;
+
+    struct node_type {
+        union {
+            unsigned char storage[sizeof(T)];
+            long double alignLongDouble;
+            long long alignLongLong;
+            void* alignPointer;
+        };
+        index_type next;
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    typedef typename Alloc::template rebind<node_type>::other block_allocator;
+
+    // block b holds BLOCK_BASE << b nodes; index 0 is the null node
+    static const size_type BLOCK_BASE = 64;
+    static const size_type MAX_BLOCKS = 26;
+
+    head_type _head;
+    head_type _free;
+    size_type _blockCount;
+    node_type* _blocks[MAX_BLOCKS];
+    block_allocator _allocBlock;
+    pthread_mutex_t _growLock;
+
+    concurrent_stack(const concurrent_stack&);
+    concurrent_stack& operator=(const concurrent_stack&);
+
+    // holds the mutex until the scope is left, by a throw too
+    struct scoped_lock {
+        pthread_mutex_t* mutex;
+
+        explicit scoped_lock(pthread_mutex_t* m) : mutex(m) { pthread_mutex_lock(mutex); }
+        ~scoped_lock() { pthread_mutex_unlock(mutex); }
+    };
+
+    static index_type headIndex(head_type head) { return static_cast<index_type>(head); }
+    static head_type makeHead(index_type i, head_type oldHead) { return (((oldHead >> 32) + 1) << 32) | i; }
+    static size_type blockSize(size_type b) { return BLOCK_BASE << b; }
+
+    static size_type highestBit(size_type x) {
+#if defined(__GNUC__)
+        return 63 - __builtin_clzll(x);
+#else
+        size_type b = 0;
+        while (x >>= 1)
+            ++b;
+        return b;
+#endif
+    }
+
+    node_type& node(index_type i) const {
+        size_type j = i - 1;
+        size_type b = highestBit(j / BLOCK_BASE + 1);
+        return _blocks[b][j - BLOCK_BASE * ((size_type(1) << b) - 1)];
+    }
+
+    index_type loadNext(index_type i) const { return atomic_load_relaxed(&node(i).next); }
+
+    // links bottom to the current head and makes top the head
+    void pushChain(head_type& head, index_type top, index_type bottom) {
+        head_type old = atomic_load(&head);
+        do
+            atomic_store_relaxed(&node(bottom).next, headIndex(old));
+        while (!atomic_compare_exchange(&head, old, makeHead(top, old)));
+    }
+
+    index_type popNode(head_type& head) {
+        head_type old = atomic_load(&head);
+        while (headIndex(old))
+        {
+            if (atomic_compare_exchange(&head, old, makeHead(loadNext(headIndex(old)), old)))
+                return headIndex(old);
+        }
+        return 0;
+    }
+
+    head_type detachAll(head_type& head) {
+        head_type old = atomic_load(&head);
+        while (headIndex(old) && !atomic_compare_exchange(&head, old, makeHead(0, old)))
+            ;
+        return old;
+    }
+
+    index_type allocateNode() {
+        index_type i;
+        while (!(i = popNode(_free)))
+            grow();
+        return i;
+    }
+
+    // adds the next block to the freelist, unless another thread refilled it meanwhile
+    void grow() {
+        scoped_lock lock(&_growLock);
+        if (!headIndex(atomic_load(&_free)))
+        {
+            size_type b = _blockCount;
+            if (b == MAX_BLOCKS)
+                throw std::bad_alloc();
+            node_type* block = _allocBlock.allocate(blockSize(b));
+            index_type first = static_cast<index_type>(BLOCK_BASE * ((size_type(1) << b) - 1) + 1);
+            index_type last = static_cast<index_type>(first + blockSize(b) - 1);
+            for (index_type i = first; i < last; ++i)
+                block[i - first].next = i + 1;
+            atomic_store(&_blocks[b], block);
+            atomic_store(&_blockCount, b + 1);
+            pushChain(_free, first, last);
+        }
+    }
+};
+
+template <class T, class Alloc>
+const typename concurrent_stack<T, Alloc>::size_type concurrent_stack<T, Alloc>::BLOCK_BASE;
+
+template <class T, class Alloc>
+const typename concurrent_stack<T, Alloc>::size_type concurrent_stack<T, Alloc>::MAX_BLOCKS;
+
+}
+
+#endif
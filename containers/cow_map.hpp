@@ -0,0 +1,131 @@
+#ifndef COW_MAP_H
+#define COW_MAP_H
+
+#include "map.hpp"
+#include "../memory/cow_ptr.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::COW_MAP ----------------------- *
+    *
+    * ft::map whose copies share the tree (ft::cow_ptr) until one of
+    * them is written: copying is O(1), the first write to a shared
+    * copy pays the deep copy. Same rules as ft::cow_vector:
+    *
+    * - Const members and read() never copy. On a non-const cow_map,
+    *   read through read(), cbegin() / cend() or a const reference:
+    *   the non-const begin, end, find, lower_bound, upper_bound,
+    *   equal_range, operator[] and insert detach like any write.
+    * - A reference or iterator out of a non-const member may be
+    *   written through until the cow_map is copied, not after: the
+    *   copy shares the tree it points to.
+    * - write() is the whole ft::map, detached; use_count() tells how
+    *   many share the tree.
+    * ------------------------------------------------------------- *
+    */
+template <class Key, class T, class Compare = less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> > >
+class cow_map
+{
+public:
+    typedef ft::map<Key, T, Compare, Alloc> map_type;
+    typedef typename map_type::key_type key_type;
+    typedef typename map_type::mapped_type mapped_type;
+    typedef typename map_type::value_type value_type;
+    typedef typename map_type::key_compare key_compare;
+    typedef typename map_type::value_compare value_compare;
+    typedef typename map_type::allocator_type allocator_type;
+    typedef typename map_type::reference reference;
+    typedef typename map_type::const_reference const_reference;
+    typedef typename map_type::pointer pointer;
+    typedef typename map_type::const_pointer const_pointer;
+    typedef typename map_type::iterator iterator;
+    typedef typename map_type::const_iterator const_iterator;
+    typedef typename map_type::reverse_iterator reverse_iterator;
+    typedef typename map_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename map_type::difference_type difference_type;
+    typedef typename map_type::size_type size_type;
+
+    explicit cow_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : _p(map_type(comp, alloc)) {}
+
+    template <class InputIterator>
+    cow_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : _p(map_type(comp, alloc)) {
+        map_type tmp(first, last, comp, alloc);
+        _p.write().swap(tmp);
+    }
+
+    cow_map(const map_type& x) : _p(x) {}
+
+    const map_type& read() const { return _p.read(); }
+    map_type& write() { return _p.write(); }
+    size_type use_count() const { return _p.use_count(); }
+
+    const_iterator begin() const { return read().begin(); }
+    iterator begin() { return _p.write().begin(); }
+    const_iterator end() const { return read().end(); }
+    iterator end() { return _p.write().end(); }
+    const_iterator cbegin() const { return read().begin(); }
+    const_iterator cend() const { return read().end(); }
+    const_reverse_iterator rbegin() const { return read().rbegin(); }
+    reverse_iterator rbegin() { return _p.write().rbegin(); }
+    const_reverse_iterator rend() const { return read().rend(); }
+    reverse_iterator rend() { return _p.write().rend(); }
+
+    bool empty() const { return read().empty(); }
+    size_type size() const { return read().size(); }
+    size_type max_size() const { return read().max_size(); }
+
+    mapped_type& operator[](const key_type& k) { return _p.write()[k]; }
+
+    ft::pair<iterator, bool> insert(const value_type& val) { return _p.write().insert(val); }
+    // the hint may point into the tree write() just copied away from: dropped
+    iterator insert(const_iterator, const value_type& val) { return _p.write().insert(val).first; }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) { _p.write().insert(first, last); }
+
+    void erase(iterator position) { _p.write().erase(position); }
+    size_type erase(const key_type& k) {
+        // a miss writes nothing: keep sharing
+        if (!count(k))
+            return 0;
+        return _p.write().erase(k);
+    }
+    void erase(iterator first, iterator last) { _p.write().erase(first, last); }
+
+    void swap(cow_map& x) { _p.swap(x._p); }
+
+    void clear() { _p.rewrite(map_type(key_comp(), get_allocator())).clear(); }
+
+    key_compare key_comp() const { return read().key_comp(); }
+    value_compare value_comp() const { return read().value_comp(); }
+    allocator_type get_allocator() const { return read().get_allocator(); }
+
+    const_iterator find(const key_type& k) const { return read().find(k); }
+    iterator find(const key_type& k) { return _p.write().find(k); }
+    size_type count(const key_type& k) const { return read().count(k); }
+    const_iterator lower_bound(const key_type& k) const { return read().lower_bound(k); }
+    iterator lower_bound(const key_type& k) { return _p.write().lower_bound(k); }
+    const_iterator upper_bound(const key_type& k) const { return read().upper_bound(k); }
+    iterator upper_bound(const key_type& k) { return _p.write().upper_bound(k); }
+    ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return read().equal_range(k); }
+    ft::pair<iterator, iterator> equal_range(const key_type& k) { return _p.write().equal_range(k); }
+
+    friend bool operator==(const cow_map& lhs, const cow_map& rhs) { return &lhs.read() == &rhs.read() || lhs.read() == rhs.read(); }
+    friend bool operator!=(const cow_map& lhs, const cow_map& rhs) { return !(lhs == rhs); }
+    friend bool operator<(const cow_map& lhs, const cow_map& rhs) { return lhs.read() < rhs.read(); }
+    friend bool operator<=(const cow_map& lhs, const cow_map& rhs) { return !(rhs < lhs); }
+    friend bool operator>(const cow_map& lhs, const cow_map& rhs) { return rhs < lhs; }
+    friend bool operator>=(const cow_map& lhs, const cow_map& rhs) { return !(lhs < rhs); }
+
+private:
+    cow_ptr<map_type> _p;
+};
+
+template <class Key, class T, class Compare, class Alloc>
+void swap(cow_map<Key, T, Compare, Alloc>& x, cow_map<Key, T, Compare, Alloc>& y) { x.swap(y); }
+
+}
+
+#endif
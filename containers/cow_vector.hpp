@@ -0,0 +1,140 @@
+#ifndef COW_VECTOR_H
+#define COW_VECTOR_H
+
+#include "vector.hpp"
+#include "../memory/cow_ptr.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------ FT::COW_VECTOR --------------------- *
+    *
+    * ft::vector whose copies share the elements (ft::cow_ptr) until
+    * one of them is written: copying is O(1), the first write to a
+    * shared copy pays the deep copy. For vectors handed around to be
+    * read.
+    *
+    * - Const members and read() never copy. On a non-const
+    *   cow_vector, use read(), cbegin() / cend() or a const reference
+    *   to read: the non-const begin, end, operator[], at, front, back,
+    *   insert and erase detach like any write.
+    * - A reference or iterator out of a non-const member may be
+    *   written through until the cow_vector is copied, not after: the
+    *   copy shares the elements it points to.
+    * - write() is the whole ft::vector, detached, for what is not
+    *   forwarded here; use_count() tells how many share the elements.
+    * ------------------------------------------------------------- *
+    */
+template <class T, class Alloc = std::allocator<T> >
+class cow_vector
+{
+public:
+    typedef ft::vector<T, Alloc> vector_type;
+    typedef typename vector_type::value_type value_type;
+    typedef typename vector_type::allocator_type allocator_type;
+    typedef typename vector_type::reference reference;
+    typedef typename vector_type::const_reference const_reference;
+    typedef typename vector_type::pointer pointer;
+    typedef typename vector_type::const_pointer const_pointer;
+    typedef typename vector_type::iterator iterator;
+    typedef typename vector_type::const_iterator const_iterator;
+    typedef typename vector_type::reverse_iterator reverse_iterator;
+    typedef typename vector_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename vector_type::difference_type difference_type;
+    typedef typename vector_type::size_type size_type;
+
+    explicit cow_vector(const allocator_type& alloc = allocator_type()) : _p(vector_type(alloc)) {}
+
+    // built apart then swapped in: cow_ptr copies the vector it is given
+    explicit cow_vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type())
+        : _p(vector_type(alloc)) {
+        vector_type tmp(n, val, alloc);
+        _p.write().swap(tmp);
+    }
+
+    template <class InputIterator>
+    cow_vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
+        typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type* = 0) : _p(vector_type(alloc)) {
+        vector_type tmp(first, last, alloc);
+        _p.write().swap(tmp);
+    }
+
+    cow_vector(const vector_type& x) : _p(x) {}
+
+    const vector_type& read() const { return _p.read(); }
+    vector_type& write() { return _p.write(); }
+    size_type use_count() const { return _p.use_count(); }
+
+    const_iterator begin() const { return read().begin(); }
+    iterator begin() { return _p.write().begin(); }
+    const_iterator end() const { return read().end(); }
+    iterator end() { return _p.write().end(); }
+    const_iterator cbegin() const { return read().begin(); }
+    const_iterator cend() const { return read().end(); }
+    const_reverse_iterator rbegin() const { return read().rbegin(); }
+    reverse_iterator rbegin() { return _p.write().rbegin(); }
+    const_reverse_iterator rend() const { return read().rend(); }
+    reverse_iterator rend() { return _p.write().rend(); }
+
+    size_type size() const { return read().size(); }
+    size_type max_size() const { return read().max_size(); }
+    size_type capacity() const { return read().capacity(); }
+    bool empty() const { return read().empty(); }
+    allocator_type get_allocator() const { return read().get_allocator(); }
+
+    void resize(size_type n, value_type val = value_type()) { _p.write().resize(n, val); }
+    void reserve(size_type n) {
+        if (n > capacity())
+            _p.write().reserve(n);
+    }
+
+    const_reference operator[](size_type n) const { return read()[n]; }
+    reference operator[](size_type n) { return _p.write()[n]; }
+    const_reference at(size_type n) const { return read().at(n); }
+    reference at(size_type n) { return _p.write().at(n); }
+    const_reference front() const { return read().front(); }
+    reference front() { return _p.write().front(); }
+    const_reference back() const { return read().back(); }
+    reference back() { return _p.write().back(); }
+
+    template <class InputIterator>
+    void assign(InputIterator first, InputIterator last, typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type* = 0) {
+        _p.rewrite(vector_type(get_allocator())).assign(first, last);
+    }
+    void assign(size_type n, const value_type& val) { _p.rewrite(vector_type(get_allocator())).assign(n, val); }
+
+    void push_back(const value_type& val) { _p.write().push_back(val); }
+    void pop_back() { _p.write().pop_back(); }
+
+    iterator insert(iterator position, const value_type& val) { return _p.write().insert(position, val); }
+    void insert(iterator position, size_type n, const value_type& val) { _p.write().insert(position, n, val); }
+    template <class InputIterator>
+    void insert(iterator position, InputIterator first, InputIterator last,
+        typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type* = 0) {
+        _p.write().insert(position, first, last);
+    }
+
+    iterator erase(iterator position) { return _p.write().erase(position); }
+    iterator erase(iterator first, iterator last) { return _p.write().erase(first, last); }
+
+    void swap(cow_vector& x) { _p.swap(x._p); }
+
+    void clear() { _p.rewrite(vector_type(get_allocator())).clear(); }
+
+    friend bool operator==(const cow_vector& lhs, const cow_vector& rhs) { return &lhs.read() == &rhs.read() || lhs.read() == rhs.read(); }
+    friend bool operator!=(const cow_vector& lhs, const cow_vector& rhs) { return !(lhs == rhs); }
+    friend bool operator<(const cow_vector& lhs, const cow_vector& rhs) { return lhs.read() < rhs.read(); }
+    friend bool operator<=(const cow_vector& lhs, const cow_vector& rhs) { return !(rhs < lhs); }
+    friend bool operator>(const cow_vector& lhs, const cow_vector& rhs) { return rhs < lhs; }
+    friend bool operator>=(const cow_vector& lhs, const cow_vector& rhs) { return !(lhs < rhs); }
+
+private:
+    cow_ptr<vector_type> _p;
+};
+
+template <class T, class Alloc>
+void swap(cow_vector<T, Alloc>& x, cow_vector<T, Alloc>& y) { x.swap(y); }
+
+}
+
+#endif
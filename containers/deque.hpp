@@ -0,0 +1,382 @@
+#ifndef DEQUE_H
+#define DEQUE_H
+
+#include "../iterator/deque_iterator.hpp"
+#include "../algorithm/algorithm.hpp"
+#include "../utility.hpp"
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+#include <limits>
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::DEQUE ------------------------- *
+    *
+    * Elements live in fixed-size chunks (ft::deque_chunk<T>::size
+    * elements each) reached through a block map of chunk pointers.
+    * Growing at either end allocates at most one chunk and, rarely,
+    * a bigger map of pointers: elements are never copied, so
+    * references to them stay valid until they are erased.
+    *
+    * - Coplien form:
+    * (constructor):        Construct deque
+    * (destructor):         Destruct deque
+    * operator=:            Assign deque
+    *
+    * - Iterators:
+    * begin, end, rbegin, rend
+    *
+    * - Capacity:
+    * size, max_size, resize, empty
+    *
+    * - Element access:
+    * operator[], at, front, back
+    *
+    * - Modifiers:
+    * assign:               Assign deque content
+    * push_back:            Add element at the end, O(1)
+    * push_front:           Insert element at beginning, O(1)
+    * pop_back:             Delete last element, O(1)
+    * pop_front:            Delete first element, O(1)
+    * insert:               Insert elements
+    * erase:                Erase elements, shifting the shorter side
+    * swap:                 Swap content
+    * clear:                Clear content
+    *
+    * - Non-member function overloads:
+    * relational operators, swap
+    * ------------------------------------------------------------- *
+    */
+template < class T, class Alloc = std::allocator<T> >
+class deque
+{
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference  const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef ft::deque_iterator<T, false>            iterator;
+    typedef ft::deque_iterator<T, true>             const_iterator;
+    typedef ft::reverse_deque_iterator<T, false>    reverse_iterator;
+    typedef ft::reverse_deque_iterator<T, true>     const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef typename allocator_type::template rebind<T*>::other map_allocator_type;
+
+    explicit deque(const allocator_type& alloc = allocator_type()) : _alloc(alloc), _allocMap(alloc), _map(NULL), _mapCapacity(0), _begin(0), _end(0), _spare(NULL) {}
+
+    explicit deque (size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type()) : _alloc(alloc), _allocMap(alloc), _map(NULL), _mapCapacity(0), _begin(0), _end(0), _spare(NULL) {
+        resize(n, val);
+    }
+
+    template <class InputIterator>
+    deque (InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(), typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0) : _alloc(alloc), _allocMap(alloc), _map(NULL), _mapCapacity(0), _begin(0), _end(0), _spare(NULL)
+    {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    deque(const deque& x) : _alloc(x._alloc), _allocMap(x._allocMap), _map(NULL), _mapCapacity(0), _begin(0), _end(0), _spare(NULL)
+    {
+        for (const_iterator it = x.begin(); it != x.end(); ++it)
+            push_back(*it);
+    }
+
+    ~deque() {
+        if (ft::allocator_skips_teardown<allocator_type>::value && ft::is_trivially_destructible<value_type>::value)
+            return;
+        clear();
+        if (_spare)
+            _alloc.deallocate(_spare, CHUNK);
+        if (_map)
+            _allocMap.deallocate(_map, _mapCapacity);
+    }
+
+    deque& operator= (const deque& x) {
+        if (this != &x)
+            assign(x.begin(), x.end());
+        return (*this);
+    }
+
+    const_iterator  begin() const   { return const_iterator(_map, _begin); }
+    iterator        begin()         { return iterator(_map, _begin); }
+    const_iterator  end() const     { return const_iterator(_map, _end); }
+    iterator        end()           { return iterator(_map, _end); }
+    const_reverse_iterator rbegin() const   { return const_reverse_iterator(end()); }
+    reverse_iterator rbegin()               { return reverse_iterator(end()); }
+    const_reverse_iterator rend() const     { return const_reverse_iterator(begin()); }
+    reverse_iterator rend()                 { return reverse_iterator(begin()); }
+
+    allocator_type get_allocator() const { return _alloc; }
+
+    template <class InputIterator>
+    void assign (InputIterator first, InputIterator last, typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0)
+    {
+        clear();
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    void assign (size_type n, const value_type& val)
+    {
+        clear();
+        resize(n, val);
+    }
+
+    void push_back (const value_type& val) {
+        if (_end == _mapCapacity * CHUNK)
+            reallocMap();
+        if (_end % CHUNK == 0)
+            _map[_end / CHUNK] = allocateChunk();
+        _alloc.construct(&_map[_end / CHUNK][_end % CHUNK], val);
+        ++_end;
+    }
+
+    void push_front (const value_type& val) {
+        if (_begin == 0)
+            reallocMap();
+        if (_begin % CHUNK == 0)
+            _map[_begin / CHUNK - 1] = allocateChunk();
+        _alloc.construct(&_map[(_begin - 1) / CHUNK][(_begin - 1) % CHUNK], val);
+        --_begin;
+    }
+
+    void pop_back() {
+        if (empty())
+            return;
+        --_end;
+        _alloc.destroy(&_map[_end / CHUNK][_end % CHUNK]);
+        if (_end % CHUNK == 0 || _begin == _end)
+            releaseChunk(_end / CHUNK);
+        if (empty())
+            recenter();
+    }
+
+    void pop_front() {
+        if (empty())
+            return;
+        _alloc.destroy(&_map[_begin / CHUNK][_begin % CHUNK]);
+        ++_begin;
+        if (_begin % CHUNK == 0 || _begin == _end)
+            releaseChunk((_begin - 1) / CHUNK);
+        if (empty())
+            recenter();
+    }
+
+    iterator insert (iterator position, const value_type& val) {
+        difference_type index = position - begin();
+        insert(position, 1, val);
+        return (begin() + index);
+    }
+
+    void insert (iterator position, size_type n, const value_type& val) {
+        size_type index = position - begin();
+        size_type oldSize = size();
+        for (size_type i = 0; i < n; ++i)
+            push_back(val);
+        rotate(index, oldSize, size());
+    }
+
+    template <class InputIterator>
+    void insert (iterator position, InputIterator first, InputIterator last,  typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0) {
+        size_type index = position - begin();
+        size_type oldSize = size();
+        for (; first != last; ++first)
+            push_back(*first);
+        rotate(index, oldSize, size());
+    }
+
+    iterator erase (iterator position) {
+        return erase(position, position + 1);
+    }
+
+    iterator erase (iterator first, iterator last) {
+        size_type index = first - begin();
+        size_type len = last - first;
+        if (index < size() - index - len)
+        {
+            for (size_type i = index; i-- > 0;)
+                elem(i + len) = elem(i);
+            for (size_type i = 0; i < len; ++i)
+                pop_front();
+        }
+        else
+        {
+            for (size_type i = index; i + len < size(); ++i)
+                elem(i) = elem(i + len);
+            for (size_type i = 0; i < len; ++i)
+                pop_back();
+        }
+        return (begin() + index);
+    }
+
+    void clear() {
+        while (!empty())
+            pop_back();
+    }
+
+    void swap (deque& x) {
+        swap(_alloc, x._alloc);
+        swap(_allocMap, x._allocMap);
+        swap(_map, x._map);
+        swap(_mapCapacity, x._mapCapacity);
+        swap(_begin, x._begin);
+        swap(_end, x._end);
+        swap(_spare, x._spare);
+    }
+
+    size_type size() const { return _end - _begin; }
+
+    size_type max_size() const
+    {
+        return std::numeric_limits<size_t>::max() / sizeof(value_type);
+    }
+
+    void resize (size_type n, value_type val = value_type())
+    {
+        while (size() < n)
+            push_back(val);
+        while (size() > n)
+            pop_back();
+    }
+
+    bool empty() const { return _begin == _end; }
+
+    reference operator[] (size_type n) { return elem(n); }
+
+    const_reference operator[] (size_type n) const { return elem(n); }
+
+    reference at (size_type n) {
+        if (n >= size())
+            throw std::out_of_range("deque");
+        return elem(n);
+    }
+
+    const_reference at (size_type n) const {
+        if (n >= size())
+            throw std::out_of_range("deque");
+        return elem(n);
+    }
+
+    reference front() { return elem(0); }
+
+    const_reference front() const { return elem(0); }
+
+    reference back() { return elem(size() - 1); }
+
+    const_reference back() const { return elem(size() - 1); }
+
+    friend bool operator== (const deque& lhs, const deque& rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!= (const deque& lhs, const deque& rhs) { return (!(lhs == rhs)); }
+
+    friend bool operator<  (const deque& lhs, const deque& rhs) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator<= (const deque& lhs, const deque& rhs) { return (!(rhs < lhs)); }
+
+    friend bool operator>  (const deque& lhs, const deque& rhs) { return (rhs < lhs); }
+
+    friend bool operator>= (const deque& lhs, const deque& rhs) { return (!(lhs < rhs)); }
+
+private:
+    static const size_type CHUNK = ft::deque_chunk<T>::size;
+
+    allocator_type _alloc;
+    map_allocator_type _allocMap;
+    T** _map;
+    size_type _mapCapacity;
+    // elements are [_begin, _end), as indexes global to the map: chunk _begin / CHUNK holds the first one
+    size_type _begin;
+    size_type _end;
+    // last released chunk, kept so that push/pop around a chunk boundary does not hit the allocator
+    T* _spare;
+
+    reference elem(size_type n) const { return _map[(_begin + n) / CHUNK][(_begin + n) % CHUNK]; }
+
+    T* allocateChunk() {
+        if (!_spare)
+            return _alloc.allocate(CHUNK);
+        T* chunk = _spare;
+        _spare = NULL;
+        return chunk;
+    }
+
+    void releaseChunk(size_type slot) {
+        if (_spare)
+            _alloc.deallocate(_spare, CHUNK);
+        _spare = _map[slot];
+        _map[slot] = NULL;
+    }
+
+    // an empty deque restarts from the middle of the map so both ends have room
+    void recenter() {
+        _begin = _end = _mapCapacity / 2 * CHUNK;
+    }
+
+    // moves the used chunk pointers to the middle of a map at least twice their number
+    void reallocMap() {
+        size_type first = _begin / CHUNK;
+        size_type used = empty() ? 0 : (_end + CHUNK - 1) / CHUNK - first;
+        size_type newCapacity = _mapCapacity;
+        T** newMap = _map;
+        if ((used + 2) * 2 > _mapCapacity)
+        {
+            newCapacity = (used + 2) * 2 > 8 ? (used + 2) * 2 : 8;
+            newMap = _allocMap.allocate(newCapacity);
+        }
+        size_type newFirst = (newCapacity - used) / 2;
+        if (used)
+            std::memmove(newMap + newFirst, _map + first, used * sizeof(T*));
+        if (newMap != _map && _map)
+            _allocMap.deallocate(_map, _mapCapacity);
+        _begin = _begin - first * CHUNK + newFirst * CHUNK;
+        _end = _end - first * CHUNK + newFirst * CHUNK;
+        _map = newMap;
+        _mapCapacity = newCapacity;
+        if (!used)
+            recenter();
+    }
+
+    void reverse(size_type first, size_type last) {
+        while (first + 1 < last)
+        {
+            --last;
+            value_type tmp = elem(first);
+            elem(first) = elem(last);
+            elem(last) = tmp;
+            ++first;
+        }
+    }
+
+    // [first, middle)[middle, last) becomes [middle, last)[first, middle)
+    void rotate(size_type first, size_type middle, size_type last) {
+        reverse(first, middle);
+        reverse(middle, last);
+        reverse(first, last);
+    }
+
+    template <typename U>
+    void swap(U& a, U&b)
+    {
+        U tmp = a;
+        a = b;
+        b = tmp;
+    }
+};
+
+template <class T, class Alloc>
+const typename deque<T, Alloc>::size_type deque<T, Alloc>::CHUNK;
+
+template <class T, class Alloc>
+  void swap (deque<T,Alloc>& x, deque<T,Alloc>& y) { x.swap(y); }
+}
+
+#endif
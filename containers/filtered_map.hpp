@@ -0,0 +1,211 @@
+#ifndef FILTERED_MAP_H
+#define FILTERED_MAP_H
+
+#include "map.hpp"
+#include "bloom_filter.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ----------------------- FT::FILTERED_MAP -------------------- *
+    *
+    * ft::map behind an ft::bloom_filter of its keys, for lookups that
+    * mostly miss: find, count and erase of an absent key are answered
+    * by one hash and one cache line, without walking the tree. Hits,
+    * and the false_positive_rate share of misses that pass the
+    * filter, pay the filter and the usual search.
+    *
+    * - insert and operator[] add new keys to the filter. Erased keys
+    *   stay in it until the next rebuild, only raising the rate.
+    * - Rebuilds from the map's keys, O(size), sized again for twice
+    *   them: when the filter has taken the keys it was sized for, and
+    *   when the erased keys outnumber the live ones.
+    * - reserve(n) sizes the filter for n keys up front;
+    *   set_false_positive_rate(p) trades memory (-ln(p) / ln(2)^2 bits
+    *   per key, 9.6 for 1%) against the misses let through.
+    * - Everything else is ft::map's, forwarded; base() is the map,
+    *   filter() the filter. Iterators are the map's: writing mapped
+    *   values through them is fine, the filter only holds keys.
+    * ------------------------------------------------------------- *
+    */
+template <class Key, class T, class Compare = less<Key>, class Alloc = std::allocator<ft::pair<const Key, T> >, class Hash = ft::hash<Key> >
+class filtered_map
+{
+public:
+    typedef ft::map<Key, T, Compare, Alloc> map_type;
+    typedef ft::bloom_filter<Key, Hash> filter_type;
+    typedef typename map_type::key_type key_type;
+    typedef typename map_type::mapped_type mapped_type;
+    typedef typename map_type::value_type value_type;
+    typedef typename map_type::key_compare key_compare;
+    typedef typename map_type::value_compare value_compare;
+    typedef typename map_type::allocator_type allocator_type;
+    typedef typename map_type::reference reference;
+    typedef typename map_type::const_reference const_reference;
+    typedef typename map_type::pointer pointer;
+    typedef typename map_type::const_pointer const_pointer;
+    typedef typename map_type::iterator iterator;
+    typedef typename map_type::const_iterator const_iterator;
+    typedef typename map_type::reverse_iterator reverse_iterator;
+    typedef typename map_type::const_reverse_iterator const_reverse_iterator;
+    typedef typename map_type::difference_type difference_type;
+    typedef typename map_type::size_type size_type;
+
+    static const size_type MIN_CAPACITY = 1024;
+
+    explicit filtered_map(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : _map(comp, alloc), _filter(MIN_CAPACITY), _erased(0) {}
+
+    template <class InputIterator>
+    filtered_map(InputIterator first, InputIterator last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : _map(first, last, comp, alloc), _filter(MIN_CAPACITY), _erased(0) {
+        rebuild();
+    }
+
+    filtered_map(const map_type& x) : _map(x), _filter(MIN_CAPACITY), _erased(0) { rebuild(); }
+
+    const map_type& base() const { return _map; }
+    const filter_type& filter() const { return _filter; }
+
+    iterator begin() { return _map.begin(); }
+    const_iterator begin() const { return _map.begin(); }
+    iterator end() { return _map.end(); }
+    const_iterator end() const { return _map.end(); }
+    reverse_iterator rbegin() { return _map.rbegin(); }
+    const_reverse_iterator rbegin() const { return _map.rbegin(); }
+    reverse_iterator rend() { return _map.rend(); }
+    const_reverse_iterator rend() const { return _map.rend(); }
+
+    bool empty() const { return _map.empty(); }
+    size_type size() const { return _map.size(); }
+    size_type max_size() const { return _map.max_size(); }
+
+    mapped_type& operator[](const key_type& k) { return insert(ft::make_pair<const Key, T>(k, mapped_type())).first->second; }
+
+    ft::pair<iterator, bool> insert(const value_type& val) {
+        ft::pair<iterator, bool> res = _map.insert(val);
+        if (res.second)
+            added(_filter.hash_function()(val.first));
+        return res;
+    }
+    iterator insert(const_iterator position, const value_type& val) {
+        size_type before = _map.size();
+        iterator it = _map.insert(position, val);
+        if (_map.size() != before)
+            added(_filter.hash_function()(val.first));
+        return it;
+    }
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    void erase(iterator position) {
+        _map.erase(position);
+        removed(1);
+    }
+    size_type erase(const key_type& k) {
+        if (!_filter.may_contain(k))
+            return 0;
+        size_type n = _map.erase(k);
+        removed(n);
+        return n;
+    }
+    void erase(iterator first, iterator last) {
+        size_type before = _map.size();
+        _map.erase(first, last);
+        removed(before - _map.size());
+    }
+
+    void swap(filtered_map& x) {
+        _map.swap(x._map);
+        _filter.swap(x._filter);
+        swapValues(_erased, x._erased);
+    }
+
+    void clear() {
+        _map.clear();
+        _filter.clear();
+        _erased = 0;
+    }
+
+    key_compare key_comp() const { return _map.key_comp(); }
+    value_compare value_comp() const { return _map.value_comp(); }
+    allocator_type get_allocator() const { return _map.get_allocator(); }
+
+    iterator find(const key_type& k) { return _filter.may_contain(k) ? _map.find(k) : _map.end(); }
+    const_iterator find(const key_type& k) const { return _filter.may_contain(k) ? _map.find(k) : _map.end(); }
+    size_type count(const key_type& k) const { return _filter.may_contain(k) ? _map.count(k) : 0; }
+    iterator lower_bound(const key_type& k) { return _map.lower_bound(k); }
+    const_iterator lower_bound(const key_type& k) const { return _map.lower_bound(k); }
+    iterator upper_bound(const key_type& k) { return _map.upper_bound(k); }
+    const_iterator upper_bound(const key_type& k) const { return _map.upper_bound(k); }
+    ft::pair<iterator, iterator> equal_range(const key_type& k) { return _map.equal_range(k); }
+    ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const { return _map.equal_range(k); }
+
+    // sizes the filter for n keys, rebuilding it if it holds fewer
+    void reserve(size_type n) {
+        if (n > _filter.capacity())
+            rebuild(n, _filter.target_fpr());
+    }
+
+    void set_false_positive_rate(double fpr) { rebuild(_filter.capacity(), fpr); }
+    double false_positive_rate() const { return _filter.target_fpr(); }
+
+    // the filter again from the keys in the map, at the current capacity and rate
+    void rebuild() { rebuild(_filter.capacity(), _filter.target_fpr()); }
+
+    friend bool operator==(const filtered_map& lhs, const filtered_map& rhs) { return lhs._map == rhs._map; }
+    friend bool operator!=(const filtered_map& lhs, const filtered_map& rhs) { return lhs._map != rhs._map; }
+    friend bool operator<(const filtered_map& lhs, const filtered_map& rhs) { return lhs._map < rhs._map; }
+    friend bool operator<=(const filtered_map& lhs, const filtered_map& rhs) { return lhs._map <= rhs._map; }
+    friend bool operator>(const filtered_map& lhs, const filtered_map& rhs) { return lhs._map > rhs._map; }
+    friend bool operator>=(const filtered_map& lhs, const filtered_map& rhs) { return lhs._map >= rhs._map; }
+
+private:
+    map_type _map;
+    filter_type _filter;
+    size_type _erased;      // keys erased since the last rebuild, still in the filter
+
+    template <typename U>
+    static void swapValues(U& a, U& b) {
+        U tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    void rebuild(size_type capacity, double fpr) {
+        if (capacity < MIN_CAPACITY)
+            capacity = MIN_CAPACITY;
+        if (capacity < _map.size())
+            capacity = _map.size();
+        _filter.reset(capacity, fpr);
+        for (const_iterator it = _map.begin(); it != _map.end(); ++it)
+            _filter.insert(it->first);
+        _erased = 0;
+    }
+
+    void added(size_t h) {
+        // the filter holds every key, erased ones included: past capacity it grows
+        if (_filter.size() >= _filter.capacity())
+            return rebuild(2 * _map.size(), _filter.target_fpr());
+        _filter.insert_hash(h);
+    }
+
+    void removed(size_type n) {
+        _erased += n;
+        if (_erased > MIN_CAPACITY && _erased > _map.size())
+            rebuild(2 * _map.size(), _filter.target_fpr());
+    }
+};
+
+template <class Key, class T, class Compare, class Alloc, class Hash>
+const typename filtered_map<Key, T, Compare, Alloc, Hash>::size_type filtered_map<Key, T, Compare, Alloc, Hash>::MIN_CAPACITY;
+
+template <class Key, class T, class Compare, class Alloc, class Hash>
+void swap(filtered_map<Key, T, Compare, Alloc, Hash>& x, filtered_map<Key, T, Compare, Alloc, Hash>& y) { x.swap(y); }
+
+}
+
+#endif
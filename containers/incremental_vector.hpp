@@ -0,0 +1,271 @@
+#ifndef INCREMENTAL_VECTOR_H
+#define INCREMENTAL_VECTOR_H
+
+#include "../iterator/index_iterator.hpp"
+#include "../algorithm/algorithm.hpp"
+#include "../utility.hpp"
+#include <memory>
+#include <stdexcept>
+#include <limits>
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------- FT::INCREMENTAL_VECTOR ------------------ *
+    *
+    * A vector whose growth is spread over time: when push_back finds
+    * the buffer full it allocates one twice as large but does not copy
+    * into it. Every following push_back migrates MIGRATE_STEP elements
+    * of the old buffer, so the copy is finished long before the new
+    * buffer fills up and no push_back ever pays for more than
+    * MIGRATE_STEP + 1 constructions.
+    *
+    * While migrating, element i lives in the old buffer if it is in
+    * [migrated, oldSize), in the new one otherwise: operator[] is one
+    * extra comparison. Elements are not contiguous, iterators are
+    * index based.
+    *
+    * reserve and finish_migration are the bulk operations and complete
+    * any pending migration at once.
+    *
+    * - Coplien form: constructor, destructor, operator=
+    * - Iterators: begin, end
+    * - Capacity: size, max_size, resize, capacity, empty, reserve,
+    *   migrating, finish_migration
+    * - Element access: operator[], at, front, back
+    * - Modifiers: push_back, pop_back, swap, clear
+    * - Non-member function overloads: relational operators, swap
+    * ------------------------------------------------------------- *
+    */
+template < class T, class Alloc = std::allocator<T> >
+class incremental_vector
+{
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference  const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef ft::index_iterator<incremental_vector, T, false>    iterator;
+    typedef ft::index_iterator<incremental_vector, T, true>     const_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    static const size_type MIGRATE_STEP = 2;
+
+    explicit incremental_vector(const allocator_type& alloc = allocator_type()) : _alloc(alloc), _vector(NULL), _size(0), _capacity(0), _old(NULL), _oldCapacity(0), _oldSize(0), _migrated(0) {}
+
+    incremental_vector(const incremental_vector& x) : _alloc(x._alloc), _vector(NULL), _size(0), _capacity(0), _old(NULL), _oldCapacity(0), _oldSize(0), _migrated(0)
+    {
+        *this = x;
+    }
+
+    ~incremental_vector() {
+        clear();
+        if (_vector)
+            _alloc.deallocate(_vector, _capacity);
+    }
+
+    incremental_vector& operator= (const incremental_vector& x) {
+        if (this == &x)
+            return (*this);
+        clear();
+        reserve(x._size);
+        for (size_type i = 0; i < x._size; ++i)
+            _alloc.construct(&_vector[i], x[i]);
+        _size = x._size;
+        return (*this);
+    }
+
+    const_iterator  begin() const   { return const_iterator(this, 0); }
+    iterator        begin()         { return iterator(this, 0); }
+    const_iterator  end() const     { return const_iterator(this, _size); }
+    iterator        end()           { return iterator(this, _size); }
+
+    allocator_type get_allocator() const { return _alloc; }
+
+    void push_back (const value_type& val) {
+        if (_size >= _capacity)
+            grow();
+        _alloc.construct(&_vector[_size++], val);
+        migrate(MIGRATE_STEP);
+    }
+
+    void pop_back() {
+        if (!_size)
+            return;
+        _alloc.destroy(&(*this)[--_size]);
+        if (_size < _oldSize)
+        {
+            _oldSize = _size;
+            if (_migrated >= _oldSize)
+                releaseOld();
+        }
+    }
+
+    void clear() {
+        while (_size)
+            pop_back();
+        releaseOld();
+    }
+
+    void swap (incremental_vector& x) {
+        swap(_alloc, x._alloc);
+        swap(_vector, x._vector);
+        swap(_size, x._size);
+        swap(_capacity, x._capacity);
+        swap(_old, x._old);
+        swap(_oldCapacity, x._oldCapacity);
+        swap(_oldSize, x._oldSize);
+        swap(_migrated, x._migrated);
+    }
+
+    size_type size() const { return _size; }
+
+    size_type max_size() const
+    {
+        return std::numeric_limits<size_t>::max() / sizeof(value_type);
+    }
+
+    void resize (size_type n, value_type val = value_type())
+    {
+        while (_size < n)
+            push_back(val);
+        while (_size > n)
+            pop_back();
+    }
+
+    size_type capacity() const { return _capacity; }
+
+    bool empty() const { return !_size; }
+
+    void reserve(size_type n)
+    {
+        if (n > max_size())
+            throw std::length_error("incremental_vector");
+        if (n <= _capacity)
+            return;
+        finish_migration();
+        pointer tmp = _alloc.allocate(n);
+        for (size_type i = 0; i < _size; ++i)
+        {
+            _alloc.construct(&tmp[i], _vector[i]);
+            _alloc.destroy(&_vector[i]);
+        }
+        if (_vector)
+            _alloc.deallocate(_vector, _capacity);
+        _vector = tmp;
+        _capacity = n;
+    }
+
+    bool migrating() const { return _old != NULL; }
+
+    void finish_migration() { migrate(_oldSize); }
+
+    reference operator[] (size_type n) { return (n >= _migrated && n < _oldSize) ? _old[n] : _vector[n]; }
+
+    const_reference operator[] (size_type n) const { return (n >= _migrated && n < _oldSize) ? _old[n] : _vector[n]; }
+
+    reference at (size_type n) {
+        if (n >= _size)
+            throw std::out_of_range("incremental_vector");
+        return (*this)[n];
+    }
+
+    const_reference at (size_type n) const {
+        if (n >= _size)
+            throw std::out_of_range("incremental_vector");
+        return (*this)[n];
+    }
+
+    reference front() { return (*this)[0]; }
+
+    const_reference front() const { return (*this)[0]; }
+
+    reference back() { return (*this)[_size - 1]; }
+
+    const_reference back() const { return (*this)[_size - 1]; }
+
+    friend bool operator== (const incremental_vector& lhs, const incremental_vector& rhs) {
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
+    }
+
+    friend bool operator!= (const incremental_vector& lhs, const incremental_vector& rhs) { return (!(lhs == rhs)); }
+
+    friend bool operator<  (const incremental_vector& lhs, const incremental_vector& rhs) {
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+    }
+
+    friend bool operator<= (const incremental_vector& lhs, const incremental_vector& rhs) { return (!(rhs < lhs)); }
+
+    friend bool operator>  (const incremental_vector& lhs, const incremental_vector& rhs) { return (rhs < lhs); }
+
+    friend bool operator>= (const incremental_vector& lhs, const incremental_vector& rhs) { return (!(lhs < rhs)); }
+
+private:
+    allocator_type _alloc;
+    pointer _vector;
+    size_type _size;
+    size_type _capacity;
+    // previous buffer, still holding elements [_migrated, _oldSize)
+    pointer _old;
+    size_type _oldCapacity;
+    size_type _oldSize;
+    size_type _migrated;
+
+    // the new buffer is only allocated here, filling it is left to the next push_backs
+    void grow() {
+        finish_migration();
+        size_type newCapacity = !_capacity ? 1 : _capacity * 2;
+        if (_size)
+        {
+            _old = _vector;
+            _oldCapacity = _capacity;
+            _oldSize = _size;
+            _migrated = 0;
+        }
+        else if (_vector)
+            _alloc.deallocate(_vector, _capacity);
+        _vector = _alloc.allocate(newCapacity);
+        _capacity = newCapacity;
+    }
+
+    void migrate(size_type n) {
+        if (!_old)
+            return;
+        for (; n && _migrated < _oldSize; --n, ++_migrated)
+        {
+            _alloc.construct(&_vector[_migrated], _old[_migrated]);
+            _alloc.destroy(&_old[_migrated]);
+        }
+        if (_migrated >= _oldSize)
+            releaseOld();
+    }
+
+    void releaseOld() {
+        if (_old)
+            _alloc.deallocate(_old, _oldCapacity);
+        _old = NULL;
+        _oldCapacity = 0;
+        _oldSize = 0;
+        _migrated = 0;
+    }
+
+    template <typename U>
+    void swap(U& a, U&b)
+    {
+        U tmp = a;
+        a = b;
+        b = tmp;
+    }
+};
+
+template <class T, class Alloc>
+const typename incremental_vector<T, Alloc>::size_type incremental_vector<T, Alloc>::MIGRATE_STEP;
+
+template <class T, class Alloc>
+  void swap (incremental_vector<T,Alloc>& x, incremental_vector<T,Alloc>& y) { x.swap(y); }
+}
+
+#endif
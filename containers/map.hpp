@@ -6,6 +6,8 @@
 #include "../iterator/map_iterator.hpp"
 #include "../iterator/map_reverse_iterator.hpp"
 #include "../utility.hpp"
+#include "vector.hpp"
+#include "../memory/trace.hpp"
 #include <cmath>
 #include <memory>
 #include <cstdio>
@@ -13,7 +15,101 @@
 #include <iostream>
 #include <limits>
 
+// 1 compiles the operation counters of ft::map in; 0, the default, leaves no trace of them
+#ifndef FT_MAP_STATS
+# define FT_MAP_STATS 0
+#endif
+
+#if FT_MAP_STATS
+# define FT_MAP_COUNT(counter, n) (_stats.counter += (n))
+# define FT_MAP_OPERATION(calls, comparisons) stats_scope statsScope(_stats, _stats.calls, _stats.comparisons)
+#else
+# define FT_MAP_COUNT(counter, n) ((void)0)
+# define FT_MAP_OPERATION(calls, comparisons) ((void)0)
+#endif
+
 namespace ft {
+
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::MAP_STATS --------------------- *
+    *
+    * Snapshot returned by map::stats(). The shape is measured when
+    * stats() is called, in O(n), whatever FT_MAP_STATS says:
+    *
+    * height:                   Nodes on the longest root to leaf path
+    * depth_counts:             depth_counts[d] nodes at depth d, the
+    *                           root at 0
+    * average_depth:            Mean depth, the comparisons a find of a
+    *                           present key costs
+    *
+    * The counters only move in a build with FT_MAP_STATS=1 (counting
+    * is then true), since construction or reset_stats():
+    *
+    * finds, inserts, erases:   Public calls (count is a find,
+    *                           operator[] an insert); erasing a range,
+    *                           or clear, is one erase per element
+    * *_comparisons:            Comparator calls made by those calls
+    * searches, search_nodes:   Descents from the root and the nodes
+    *                           they visited
+    * adapt_steps:              Ancestors adaptTree climbed to thread a
+    *                           new node into next / prev
+    * relinks:                  Child pointers rewritten by insertNode
+    *                           and erase; the tree never rotates
+    * ------------------------------------------------------------- *
+    */
+struct map_stats
+{
+    size_t size;
+    size_t height;
+    double average_depth;
+    ft::vector<size_t> depth_counts;
+
+    bool counting;
+    size_t finds;
+    size_t inserts;
+    size_t erases;
+    size_t comparisons;
+    size_t find_comparisons;
+    size_t insert_comparisons;
+    size_t erase_comparisons;
+    size_t searches;
+    size_t search_nodes;
+    size_t adapt_steps;
+    size_t relinks;
+
+    map_stats() : size(0), height(0), average_depth(0), counting(FT_MAP_STATS), finds(0), inserts(0), erases(0),
+        comparisons(0), find_comparisons(0), insert_comparisons(0), erase_comparisons(0), searches(0),
+        search_nodes(0), adapt_steps(0), relinks(0) {}
+
+    double comparisons_per_find() const { return finds ? static_cast<double>(find_comparisons) / finds : 0; }
+    double comparisons_per_insert() const { return inserts ? static_cast<double>(insert_comparisons) / inserts : 0; }
+    double comparisons_per_erase() const { return erases ? static_cast<double>(erase_comparisons) / erases : 0; }
+    double average_search_path() const { return searches ? static_cast<double>(search_nodes) / searches : 0; }
+
+    void dump(std::ostream& os, const char* label = "") const {
+        os << label << (*label ? ": " : "")
+           << "size " << size << ", height " << height << ", average depth " << average_depth;
+        if (counting)
+            os << ", comparisons per find " << comparisons_per_find()
+               << " / insert " << comparisons_per_insert()
+               << " / erase " << comparisons_per_erase()
+               << ", search path " << average_search_path()
+               << ", adapt steps " << adapt_steps
+               << ", relinks " << relinks;
+        // nodes per depth range [2^k - 1, 2^(k+1) - 1), the levels a balanced tree of that height fills
+        os << ", depths";
+        for (size_t low = 0; low < depth_counts.size(); low = 2 * low + 1)
+        {
+            size_t count = 0;
+            for (size_t d = low; d < 2 * low + 1 && d < depth_counts.size(); ++d)
+                count += depth_counts[d];
+            os << " [" << low << "," << 2 * low + 1 << "):" << count;
+        }
+        os << std::endl;
+    }
+};
+
 /**
     * ------------------------------------------------------------- *
     * ------------------------- FT::MAP --------------------------- *
@@ -53,6 +149,12 @@ namespace ft {
     * lower_bound:      Return iterator to lower bound ++++++++++++++++++++++++++++++
     * upper_bound:      Return iterator to upper bound ++++++++++++++++++++++++++++++
     * equal_range       Get range of equal elements ++++++++++++++++++++++++++++++
+    *
+    * - Introspection:
+    * stats:            Shape and operation counters, see ft::map_stats
+    * reset_stats:      Zero the operation counters
+    * validate:         Check the order of the tree and the next / prev
+    *                   threads against it
     * ------------------------------------------------------------- *
     */
 
@@ -95,7 +197,43 @@ private:
     node_allocator_type _allocNode;
     key_compare _comp;
     size_type _size;
+#if FT_MAP_STATS
+    struct live_stats : map_stats {
+        // inside a counted public call
+        bool busy;
+
+        live_stats() : busy(false) {}
+    };
+
+    // counts one public call and its comparisons; the calls it makes itself are part of it
+    struct stats_scope {
+        live_stats& stats;
+        size_t& comparisons;
+        size_t start;
+        bool outer;
+
+        stats_scope(live_stats& s, size_t& calls, size_t& charged)
+            : stats(s), comparisons(charged), start(s.comparisons), outer(!s.busy)
+        {
+            if (outer)
+            {
+                s.busy = true;
+                ++calls;
+            }
+        }
+        ~stats_scope() {
+            if (outer)
+            {
+                comparisons += stats.comparisons - start;
+                stats.busy = false;
+            }
+        }
+    };
 
+    mutable live_stats _stats;
+#endif
+
+public:
     class value_compare  : std::binary_function <value_type, value_type, bool>
     {   
         friend class map;
@@ -112,9 +250,7 @@ private:
             }
     };
 
-public:
-
-    explicit map (const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _root(NULL), _allocPair(alloc), _comp(comp) ,  _size(0) {
+    explicit map (const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type()) : _root(NULL), _allocPair(alloc), _allocNode(alloc), _comp(comp) ,  _size(0) {
         _lastElem = createNode(value_type());        
         _root = _lastElem;
         _root->prev = _lastElem;
@@ -127,7 +263,7 @@ public:
 
     template <class InputIterator>
     map (InputIterator first, InputIterator last, const key_compare& comp = key_compare(),
-       const allocator_type& alloc = allocator_type()) :   _allocPair(alloc), _comp(comp), _size(0)
+       const allocator_type& alloc = allocator_type()) :   _allocPair(alloc), _allocNode(alloc), _comp(comp), _size(0)
     {
         _lastElem = createNode(value_type());
         _root = _lastElem;
@@ -139,18 +275,19 @@ public:
 
     }
 
-    map (const map& x) :  _root(NULL), _allocPair(x.get_allocator()), _comp(x.key_comp()), _size(0) {
+    map (const map& x) :  _root(NULL), _allocPair(x.get_allocator()), _allocNode(x._allocNode), _comp(x.key_comp()), _size(0) {
         _lastElem = createNode(value_type());
         _root = _lastElem;
         _lastElem->left = _lastElem;
         _lastElem->right = _lastElem;
         _lastElem->next = _root;
         _lastElem->prev = _root;
-        insertRangeInEmpty(x.begin(), x.end());
+        copyBalanced(x);
     }
 
     ~map() {
-        clear();
+        if (!(ft::allocator_skips_teardown<allocator_type>::value && ft::is_trivially_destructible<value_type>::value))
+            clear();
         deallocateNode(_lastElem);
     }
 
@@ -179,31 +316,30 @@ public:
     } 
 
     size_type count (const key_type& key) const {
-        for (const_iterator it = begin(); it != end(); ++it)
-            if (it->first == key)
-                return 1;
-        return 0;
+        FT_MAP_OPERATION(finds, find_comparisons);
+        FT_MAP_COUNT(searches, 1);
+        return searchNode(_root, key) ? 1 : 0;
     }
 
     iterator find (const key_type& key)
     {
-        for (iterator it = begin(); it != end(); ++it)
-            if (it->first == key)
-                return it;
-        return end();
+        FT_MAP_OPERATION(finds, find_comparisons);
+        FT_MAP_COUNT(searches, 1);
+        Node* target = searchNode(_root, key);
+        return iterator(target ? target : _lastElem, _lastElem, _comp);
     }
     const_iterator find (const key_type& key) const
     {
-        for (const_iterator it = begin(); it != end(); ++it)
-            if (it->first == key)
-                return it;
-        return end();
+        FT_MAP_OPERATION(finds, find_comparisons);
+        FT_MAP_COUNT(searches, 1);
+        Node* target = searchNode(_root, key);
+        return const_iterator(target ? target : _lastElem, _lastElem, _comp);
     }
 
     iterator lower_bound (const key_type& key)
     {
         Node* current = begin().getNode();
-        while (current != _lastElem && _comp(current->content.first, key))
+        while (current != _lastElem && compare(current->content.first, key))
             current = current->next;
         return (iterator(current));
         
@@ -211,7 +347,7 @@ public:
     const_iterator lower_bound (const key_type& key) const
     {
         Node* current = begin().getNode();
-        while (current != _lastElem && _comp(current->content.first, key))
+        while (current != _lastElem && compare(current->content.first, key))
             current = current->next;
         return (const_iterator(current));
     }
@@ -219,7 +355,7 @@ public:
     iterator upper_bound (const key_type& key)
     {
         Node* current = begin().getNode();
-        while (current != _lastElem && !_comp(key, current->content.first))
+        while (current != _lastElem && !compare(key, current->content.first))
             current = current->next;
         return (iterator(current));
         
@@ -227,7 +363,7 @@ public:
     const_iterator upper_bound (const key_type& key) const
     {
         Node* current = begin().getNode();
-        while (current != _lastElem && !_comp(key, current->content.first))
+        while (current != _lastElem && !compare(key, current->content.first))
             current = current->next;
         return (const_iterator(current));
     }
@@ -242,29 +378,34 @@ public:
     }
 
     ft::pair<iterator,bool> insert (const value_type& pair) {
+        FT_MAP_OPERATION(inserts, insert_comparisons);
+        FT_MAP_COUNT(searches, 1);
         Node* target = searchNode(_root, pair.first);
 
         if (target) 
             return (ft::pair<iterator, bool>(iterator(target, _lastElem, _comp), false));
         _size++;
+        FT_MAP_COUNT(searches, 1);
         return ft::pair<iterator, bool>(iterator(insertNode(_root, pair), _lastElem, _comp), true);
     }
 
     iterator insert (const_iterator position, const value_type& pair)
     {
+        FT_MAP_OPERATION(inserts, insert_comparisons);
         iterator it = _root;
         Node* target = NULL;
         for (const_iterator it = position; it != end(); ++it)
-            if (!_comp(it->first, pair.first) && !_comp(pair.first, it->first))
+            if (!compare(it->first, pair.first) && !compare(pair.first, it->first))
                 target = it.getNode();
         if (!target)
             for (const_iterator it = begin(); it != position; ++it)
-                if (!_comp(it->first, pair.first) && !_comp(pair.first, it->first))
+                if (!compare(it->first, pair.first) && !compare(pair.first, it->first))
                     target = it.getNode();
 
         if (target)
             return (iterator(target, _lastElem, _comp));
         _size++;
+        FT_MAP_COUNT(searches, 1);
         return iterator(insertNode(_root, pair), _lastElem, _comp);
     }
 
@@ -279,125 +420,51 @@ public:
 
     void erase (iterator position)
     {
-        Node* N = position.getNode();        
-        if ((N->left == _lastElem || N->left == NULL) && (N->right == _lastElem || N->right == NULL))
+        FT_MAP_OPERATION(erases, erase_comparisons);
+        Node* N = position.getNode();
+        if (!isNode(N->left) || !isNode(N->right))
+            replaceSubtree(N, isNode(N->left) ? N->left : (isNode(N->right) ? N->right : NULL));
+        else
         {
-            if (N->parent)
+            // two children: the successor, leftmost of the right subtree, takes N's place
+            Node* successor = N->next;
+            if (successor->parent != N)
             {
-                if (N == N->parent->right)
-                    N->parent->right = N->right;
-                else
-                    N->parent->left = N->left;
+                replaceSubtree(successor, isNode(successor->right) ? successor->right : NULL);
+                successor->right = N->right;
+                successor->right->parent = successor;
+                FT_MAP_COUNT(relinks, 1);
             }
-            else
-                _root = _lastElem;
-            N->next->prev = N->prev;
-            N->prev->next = N->next;
-            deallocateNode(N);
+            replaceSubtree(N, successor);
+            successor->left = N->left;
+            successor->left->parent = successor;
+            FT_MAP_COUNT(relinks, 1);
         }
-        else if ((N->left == _lastElem || N->left == NULL))
+        N->next->prev = N->prev;
+        N->prev->next = N->next;
+        // the first and last nodes point at _lastElem, and it at them
+        if (N->prev == _lastElem && N->next != _lastElem)
         {
-            if (N->parent)
-            {
-                if (N == (N->parent)->right)
-                    N->parent->right = N->right;
-                else
-                    N->parent->left = N->right;
-            }
-            else {
-                _root = N->right;
-            }
-            if (N->right && N->right != _lastElem)
-                N->right->parent = N->parent;
-            N->right->left = N->left;
-            N->next->prev = N->prev;
-            N->prev->next = N->next;
-            deallocateNode(N);
+            N->next->left = _lastElem;
+            _lastElem->right = N->next;
         }
-        else if (N->right == _lastElem || N->right == NULL)
+        if (N->next == _lastElem && N->prev != _lastElem)
         {
-            if (N->parent)
-            {
-                if (N == (N->parent)->right)
-                    N->parent->right = N->left;
-                else
-                    N->parent->left = N->left;
-            }
-            else
-                _root = N->left;
-            if (N->left && N->left != _lastElem)
-                N->left->parent = N->parent;
-            N->next->prev = N->prev;
-            N->prev->next = N->next;
-            deallocateNode(N);
+            N->prev->right = _lastElem;
+            _lastElem->left = N->prev;
         }
-        else
+        if (_root == _lastElem)
         {
-            Node* movingUp = N->prev;
-            if (movingUp != _lastElem)
-            {
-                movingUp->next = N->next;
-                N->next->prev = movingUp;
-                if  (movingUp->parent != N)
-                {
-                    if (movingUp->left && movingUp->left != _lastElem)
-                    {
-                        movingUp->parent->right = movingUp->left;
-                        movingUp->left->parent = movingUp->parent;
-                    }
-                }
-                if (movingUp != N->right)
-                {
-                    movingUp->right = N->right;
-                    N->right->parent = movingUp;
-                }
-                if (movingUp != N->left)
-                {
-                    movingUp->left = N->left;
-                    N->left->parent = movingUp;
-                }
-            }
-            else
-            {
-                movingUp = N->next;                
-                movingUp->prev = N->prev;
-                N->prev->next = movingUp;
-                if  (movingUp->parent != N)
-                {
-                    if (movingUp->right && movingUp->right != _lastElem)
-                    {
-                        movingUp->parent->left = movingUp->right;
-                        movingUp->right->parent = movingUp->parent;
-                    }
-                }
-                if (movingUp != N->left)
-                {
-                    movingUp->left = N->left;
-                    N->left->parent = movingUp;
-                }
-                if (movingUp != N->right)
-                {
-                    movingUp->right = N->right;
-                    N->right->parent = movingUp;
-                }
-            }
-            if (N->parent)
-            {
-                if (N == (N->parent)->right)
-                    N->parent->right = movingUp;
-                else
-                    N->parent->left = movingUp;
-            }
-            movingUp->parent = N->parent;
-            if (_root->content.first == N->content.first)
-                _root = movingUp;
-            deallocateNode(N);
+            _lastElem->left = _lastElem;
+            _lastElem->right = _lastElem;
         }
+        deallocateNode(N);
         _size--;
     }
     
     size_type erase (const key_type& k)
     {
+        FT_MAP_OPERATION(erases, erase_comparisons);
         iterator position = find(k);
         if (position.getNode() != _lastElem)
         {
@@ -432,6 +499,7 @@ public:
 
     void clear() 
     {
+        FT_TRACE_EVENT(CLEAR, this, _size, 0, 0);
         erase(begin(), end());
     }
     
@@ -452,6 +520,34 @@ public:
 
     bool empty() const { return _size == 0; }
 
+    map_stats stats() const
+    {
+#if FT_MAP_STATS
+        map_stats s = _stats;
+#else
+        map_stats s;
+#endif
+        s.size = _size;
+        measureShape(s);
+        return s;
+    }
+
+    void reset_stats()
+    {
+#if FT_MAP_STATS
+        _stats = live_stats();
+#endif
+    }
+
+    // false on the first broken invariant, described in *why
+    bool validate(const char** why = NULL) const
+    {
+        const char* problem = checkStructure();
+        if (why)
+            *why = problem;
+        return !problem;
+    }
+
     
 
     friend bool operator== ( const ft::map<Key,T,Compare,Alloc>& lhs,
@@ -513,6 +609,7 @@ private:
     Node* createNode(const value_type& pair)
     {
         Node* newNode = _allocNode.allocate(1);
+        FT_TRACE_EVENT(NODE_ALLOCATE, this, sizeof(Node), 0, 0);
 
         _allocPair.construct(&newNode->content, pair);
         newNode->parent = NULL;
@@ -527,17 +624,26 @@ private:
     {
         _allocPair.destroy(&del->content);
         _allocNode.deallocate(del, 1);
+        FT_TRACE_EVENT(NODE_FREE, this, sizeof(Node), 0, 0);
+    }
+
+    // the comparator, counted in a stats build
+    bool compare(const key_type& a, const key_type& b) const
+    {
+        FT_MAP_COUNT(comparisons, 1);
+        return _comp(a, b);
     }
 
     Node* searchNode(Node* root, const key_type & key) const
     {
         if (!root || root == _lastElem)
             return NULL;
-        if (!_comp(root->content.first, key) && !_comp(key, root->content.first))
+        FT_MAP_COUNT(search_nodes, 1);
+        if (!compare(root->content.first, key) && !compare(key, root->content.first))
             return root;
-        if (_comp(key, root->content.first) && root->left && root->left != _lastElem)
+        if (compare(key, root->content.first) && root->left && root->left != _lastElem)
             return searchNode(root->left, key);
-        if (_comp(root->content.first, key) && root->right && root->right != _lastElem)
+        if (compare(root->content.first, key) && root->right && root->right != _lastElem)
             return searchNode(root->right, key);
         return NULL;
     }
@@ -553,27 +659,30 @@ private:
             _lastElem->prev = _root;
             _root->next = _lastElem;
             _root->prev = _lastElem;
+            FT_MAP_COUNT(relinks, 1);
             return _root;
         }
-        if (!_comp(insertPos->content.first, pair.first) && !_comp(pair.first, insertPos->content.first))
+        FT_MAP_COUNT(search_nodes, 1);
+        if (!compare(insertPos->content.first, pair.first) && !compare(pair.first, insertPos->content.first))
             return NULL;
-        if (_comp(pair.first, insertPos->content.first) && insertPos->left && insertPos->left != _lastElem)
+        if (compare(pair.first, insertPos->content.first) && insertPos->left && insertPos->left != _lastElem)
             return insertNode(insertPos->left, pair);
-        if (_comp(insertPos->content.first, pair.first) && insertPos->right && insertPos->right != _lastElem)
+        if (compare(insertPos->content.first, pair.first) && insertPos->right && insertPos->right != _lastElem)
             return insertNode(insertPos->right, pair);
         Node* newNode = createNode(pair);
         newNode->parent = insertPos;
-        if (_comp(pair.first, insertPos->content.first) && !insertPos->left) 
+        FT_MAP_COUNT(relinks, 1);
+        if (compare(pair.first, insertPos->content.first) && !insertPos->left) 
             insertPos->left = newNode;
-        else if (_comp(insertPos->content.first, pair.first) && !insertPos->right)
+        else if (compare(insertPos->content.first, pair.first) && !insertPos->right)
             insertPos->right = newNode;
-         else if (insertPos->left && _comp(pair.first,insertPos->content.first))
+         else if (insertPos->left && compare(pair.first,insertPos->content.first))
         {
             newNode->left = _lastElem;
             _lastElem->right = newNode;
             insertPos->left = newNode;
         }
-        else if (insertPos->right && _comp(insertPos->content.first, pair.first))
+        else if (insertPos->right && compare(insertPos->content.first, pair.first))
         {
             newNode->right = _lastElem;
             _lastElem->left = newNode;
@@ -590,8 +699,11 @@ private:
         {
             newNode->next = parent;
             parent->prev = newNode;
-            while (parent && _comp(newNode->content.first, parent->content.first))
+            while (parent && compare(newNode->content.first, parent->content.first))
+            {
                 parent = parent->parent;
+                FT_MAP_COUNT(adapt_steps, 1);
+            }
             if (parent)
             {
                 parent->next = newNode;
@@ -607,8 +719,11 @@ private:
         {
             newNode->prev = parent;
             parent->next = newNode;
-            while (parent && _comp(parent->content.first, newNode->content.first))
+            while (parent && compare(parent->content.first, newNode->content.first))
+            {
                 parent = parent->parent;
+                FT_MAP_COUNT(adapt_steps, 1);
+            }
             if (parent)
             {
                 parent->prev = newNode;
@@ -622,29 +737,152 @@ private:
         }
     }
 
-    Node* insertInEmpty (const value_type& pair, Node* prev) {
-        _size++;
+    // a real child, not a missing one nor the _lastElem link of the first and last nodes
+    bool isNode (Node* child) const { return child && child != _lastElem; }
 
-        Node* newNode = createNode(pair);
-        newNode->parent = prev;
-        newNode->right = _lastElem;
-        _lastElem->left = newNode;
-        prev->right = newNode;
-        newNode->prev = prev;
-        prev->next = newNode;
-        _lastElem->prev = newNode;
-        newNode->next = _lastElem;
-        return newNode;
-        
+    // puts child (NULL for none) where the subtree of node hangs
+    void replaceSubtree (Node* node, Node* child)
+    {
+        FT_MAP_COUNT(relinks, 1);
+        if (!node->parent)
+            _root = child ? child : _lastElem;
+        else if (node == node->parent->left)
+            node->parent->left = child;
+        else
+            node->parent->right = child;
+        if (child)
+            child->parent = node->parent;
     }
 
-    template <class InputIterator>
-    void insertRangeInEmpty (InputIterator first, InputIterator last)
+    // x is sorted without duplicates: building in order, middle first, gives a balanced copy in O(n)
+    void copyBalanced (const map& x)
+    {
+        if (x.empty())
+            return;
+        FT_TRACE_EVENT(REBALANCE, this, x.size(), 0, 0);
+        const_iterator it = x.begin();
+        Node* prev = _lastElem;
+        _root = buildBalanced(it, x.size(), NULL, prev);
+        _size = x.size();
+        Node* first = _lastElem->next;
+        first->left = _lastElem;
+        _lastElem->right = first;
+        prev->right = _lastElem;
+        prev->next = _lastElem;
+        _lastElem->left = prev;
+        _lastElem->prev = prev;
+    }
+
+    // copies the next n elements of it as a subtree; prev is the last node created so far
+    Node* buildBalanced (const_iterator& it, size_type n, Node* parent, Node*& prev)
+    {
+        if (!n)
+            return NULL;
+        size_type leftCount = n / 2;
+        Node* left = buildBalanced(it, leftCount, NULL, prev);
+        Node* node = createNode(*it++);
+        node->parent = parent;
+        node->left = left;
+        if (left)
+            left->parent = node;
+        node->prev = prev;
+        prev->next = node;
+        prev = node;
+        node->right = buildBalanced(it, n - leftCount - 1, node, prev);
+        return node;
+    }
+
+    // depth of every node, walking down and back up the parent links: no recursion, no stack
+    void measureShape (map_stats& s) const
     {
-        Node* prev = _root;
-        for (InputIterator it = first; it != last; ++it) {
-            prev = insertInEmpty(*it, prev);
+        if (!isNode(_root))
+            return;
+        Node* node = _root;
+        size_t depth = 0;
+        size_t total = 0;
+        while (true)
+        {
+            if (s.depth_counts.size() <= depth)
+                s.depth_counts.push_back(0);
+            ++s.depth_counts[depth];
+            total += depth;
+            if (isNode(node->left) || isNode(node->right))
+            {
+                node = isNode(node->left) ? node->left : node->right;
+                ++depth;
+                continue;
+            }
+            // up to the first ancestor entered from the left that has a right subtree
+            while (node->parent && (node == node->parent->right || !isNode(node->parent->right)))
+            {
+                node = node->parent;
+                --depth;
+            }
+            if (!node->parent)
+                break;
+            node = node->parent->right;
         }
+        s.height = s.depth_counts.size();
+        s.average_depth = static_cast<double>(total) / _size;
+    }
+
+    Node* leftmost (Node* node) const
+    {
+        while (isNode(node->left))
+            node = node->left;
+        return node;
+    }
+
+    // the in-order successor from the tree links alone, _lastElem after the last node
+    Node* treeSuccessor (Node* node) const
+    {
+        if (isNode(node->right))
+            return leftmost(node->right);
+        while (node->parent && node == node->parent->right)
+            node = node->parent;
+        return node->parent ? node->parent : _lastElem;
+    }
+
+    // walks the tree in order from its links and checks the threads and _lastElem against it
+    const char* checkStructure () const
+    {
+        if (_root == _lastElem)
+        {
+            if (_size)
+                return "empty tree with a non zero size";
+            if (_lastElem->next != _lastElem || _lastElem->prev != _lastElem)
+                return "empty tree with _lastElem threaded to a node";
+            return NULL;
+        }
+        if (!_root || _root->parent)
+            return "root missing or with a parent";
+        Node* first = leftmost(_root);
+        if (_lastElem->next != first || _lastElem->right != first || first->left != _lastElem)
+            return "first node and _lastElem not linked to each other";
+        size_type seen = 0;
+        for (Node* node = first; node != _lastElem; node = node->next)
+        {
+            if (++seen > _size)
+                return "more nodes than size";
+            if (isNode(node->left) && node->left->parent != node)
+                return "left child with a wrong parent";
+            if (isNode(node->right) && node->right->parent != node)
+                return "right child with a wrong parent";
+            Node* successor = treeSuccessor(node);
+            if ((node->left == _lastElem && node != first) || (node->right == _lastElem && successor != _lastElem))
+                return "_lastElem linked as the child of an inner node";
+            if (node->next != successor)
+                return "next does not follow the in-order traversal";
+            if (successor->prev != node)
+                return "prev does not mirror next";
+            if (successor != _lastElem && !_comp(node->content.first, successor->content.first))
+                return "keys out of order";
+            if (successor == _lastElem && (node->right != _lastElem || _lastElem->left != node))
+                return "last node and _lastElem not linked to each other";
+        }
+        if (seen != _size)
+            return "fewer nodes than size";
+        return NULL;
     }
 
     template <typename U>
@@ -660,6 +898,9 @@ template <class Key, class T, class Compare, class Alloc>
 void swap (map<Key,T,Compare,Alloc>& x, map<Key,T,Compare,Alloc>& y) { x.swap(y); }
 }
 
+#undef FT_MAP_COUNT
+#undef FT_MAP_OPERATION
+
 
 
    
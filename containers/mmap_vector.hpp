@@ -0,0 +1,437 @@
+#ifndef MMAP_VECTOR_H
+#define MMAP_VECTOR_H
+
+#include "../iterator/iterator.hpp"
+#include "../iterator/reverse_iterator.hpp"
+#include "../utility.hpp"
+#include "vector.hpp"
+#include "string.hpp"
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <typeinfo>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace ft {
+
+/**
+    * What an mmap_vector file records as its element type, checked on
+    * open: by default a hash of typeid(T).name(), stable for one ABI
+    * (GCC and Clang mangle alike). Specialize it to keep files
+    * readable across a rename of T, or to pin a format version.
+    */
+template <class T>
+struct mmap_type_tag {
+    static unsigned long long value() {
+        const char* name = typeid(T).name();
+        return hash_bytes(name, std::strlen(name));
+    }
+};
+
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------ FT::MMAP_VECTOR -------------------- *
+    *
+    * ft::vector of trivially copyable T stored in a file mapping: the
+    * elements live in the page cache, not on the heap, so the vector
+    * may exceed RAM (the kernel pages it in and out) and is there
+    * again when the file is opened after a restart.
+    *
+    * File: a 64 byte header (magic, format version, sizeof(T), type
+    * tag, size, capacity) then capacity elements. Growing doubles the
+    * capacity, rounded to whole pages: ftruncate, then a new mapping.
+    *
+    * - read_write opens the file, creating it if missing; truncate
+    *   starts it over empty; read_only maps it read-only for
+    *   zero-copy loading: nothing is read until touched. Opening
+    *   throws std::runtime_error on a missing file (read_only), a
+    *   foreign header or a different T.
+    * - sync() writes the header and flushes the mapping to disk
+    *   (msync). The destructor writes the header without waiting: on
+    *   a crash, what is not synced may be lost, size included.
+    * - As for ft::vector, growing invalidates iterators, pointers and
+    *   references. Mutators of a read_only vector throw
+    *   std::logic_error; read it through a const reference, writing
+    *   through the non-const operator[] faults.
+    * - Not copyable: one mapping per open file. swap exchanges two.
+    *   Pointers stored in T do not survive a restart.
+    * ------------------------------------------------------------- *
+    */
+template <class T>
+class mmap_vector
+{
+public:
+    typedef typename ft::enable_if<ft::is_trivially_copyable<T>::value, T>::type value_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef typename ft::iterator<std::random_access_iterator_tag, T, false>      iterator;
+    typedef typename ft::iterator<std::random_access_iterator_tag, T, true>       const_iterator;
+    typedef typename ft::reverse_iterator<std::random_access_iterator_tag, T, false>  reverse_iterator;
+    typedef typename ft::reverse_iterator<std::random_access_iterator_tag, T, true>   const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    enum open_mode { read_write, read_only, truncate };
+
+    static const unsigned FORMAT_VERSION = 1;
+
+    explicit mmap_vector(const char* path, open_mode mode = read_write)
+        : _path(path), _fd(-1), _map(NULL), _mapped(0), _data(NULL), _size(0), _capacity(0), _writable(mode != read_only) {
+        try
+        {
+            open(mode);
+        }
+        catch (...)
+        {
+            // nothing of ours to write back into a file that failed its checks
+            _writable = false;
+            close();
+            throw;
+        }
+    }
+
+    ~mmap_vector() { close(); }
+
+    const_iterator  begin() const   { return const_iterator(_data); }
+    iterator        begin()         { return iterator(_data); }
+    const_iterator  end() const     { return const_iterator(_data + _size); }
+    iterator        end()           { return iterator(_data + _size); }
+    const_reverse_iterator rbegin() const   { return const_reverse_iterator(_data + _size - 1); }
+    reverse_iterator rbegin()               { return reverse_iterator(_data + _size - 1); }
+    const_reverse_iterator rend() const     { return const_reverse_iterator(_data - 1); }
+    reverse_iterator rend()                 { return reverse_iterator(_data - 1); }
+
+    size_type size() const { return _size; }
+    size_type max_size() const { return (std::numeric_limits<size_t>::max() - sizeof(header)) / sizeof(value_type); }
+    size_type capacity() const { return _capacity; }
+    bool empty() const { return !_size; }
+
+    void resize(size_type n, value_type val = value_type()) {
+        writable();
+        if (n > _capacity)
+            grow(n);
+        for (; _size < n; ++_size)
+            _data[_size] = val;
+        _size = n;
+    }
+
+    // new elements keep the bytes the file had there: zeros past its old end
+    void resize_uninitialized(size_type n) {
+        writable();
+        if (n > _capacity)
+            grow(n);
+        _size = n;
+    }
+
+    void reserve(size_type n) {
+        writable();
+        if (n > max_size())
+            throw std::length_error("mmap_vector");
+        if (n > _capacity)
+            remap(n);
+    }
+
+    reference operator[](size_type n) { return _data[n]; }
+    const_reference operator[](size_type n) const { return _data[n]; }
+    reference at(size_type n) {
+        if (n >= _size)
+            throw std::out_of_range("mmap_vector");
+        return _data[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= _size)
+            throw std::out_of_range("mmap_vector");
+        return _data[n];
+    }
+    reference front() { return _data[0]; }
+    const_reference front() const { return _data[0]; }
+    reference back() { return _data[_size - 1]; }
+    const_reference back() const { return _data[_size - 1]; }
+    pointer data() { return _data; }
+    const_pointer data() const { return _data; }
+
+    template <class InputIterator>
+    void assign(InputIterator first, InputIterator last, typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type* = 0) {
+        clear();
+        insert(end(), first, last);
+    }
+    void assign(size_type n, const value_type& val) {
+        value_type copy = val;
+        clear();
+        resize(n, copy);
+    }
+
+    void push_back(const value_type& val) {
+        writable();
+        if (_size == _capacity)
+        {
+            // val may be an element, in the mapping about to move
+            value_type copy = val;
+            grow(_size + 1);
+            _data[_size++] = copy;
+            return;
+        }
+        _data[_size++] = val;
+    }
+
+    void pop_back() {
+        writable();
+        if (_size)
+            --_size;
+    }
+
+    iterator insert(iterator position, const value_type& val) {
+        size_type index = position - begin();
+        insert(position, 1, val);
+        return iterator(_data + index);
+    }
+
+    void insert(iterator position, size_type n, const value_type& val) {
+        value_type copy = val;
+        value_type* at = makeGap(position - begin(), n);
+        for (size_type i = 0; i < n; ++i)
+            at[i] = copy;
+    }
+
+    template <class InputIterator>
+    void insert(iterator position, InputIterator first, InputIterator last, typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type* = 0) {
+        rangeInsert(position, first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    iterator erase(iterator position) { return erase(position, position + 1); }
+    iterator erase(iterator first, iterator last) {
+        writable();
+        size_type index = first - begin();
+        size_type len = last - first;
+        std::memmove(static_cast<void*>(_data + index), static_cast<const void*>(_data + index + len), (_size - index - len) * sizeof(value_type));
+        _size -= len;
+        return iterator(_data + index);
+    }
+
+    void clear() {
+        writable();
+        _size = 0;
+    }
+
+    void swap(mmap_vector& x) {
+        swapValues(_path, x._path);
+        swapValues(_fd, x._fd);
+        swapValues(_map, x._map);
+        swapValues(_mapped, x._mapped);
+        swapValues(_data, x._data);
+        swapValues(_size, x._size);
+        swapValues(_capacity, x._capacity);
+        swapValues(_writable, x._writable);
+    }
+
+    // header and elements on disk when this returns
+    void sync() {
+        if (!_writable)
+            return;
+        writeHeader();
+        if (::msync(_map, _mapped, MS_SYNC) < 0)
+            fail("msync");
+    }
+
+    const std::string& path() const { return _path; }
+    bool is_read_only() const { return !_writable; }
+
+    friend bool operator==(const mmap_vector& lhs, const mmap_vector& rhs) {
+        return lhs._size == rhs._size && !std::memcmp(lhs._data, rhs._data, lhs._size * sizeof(value_type));
+    }
+    friend bool operator!=(const mmap_vector& lhs, const mmap_vector& rhs) { return !(lhs == rhs); }
+
+private:
+    // 64 bytes: the elements start on a cache line and on any alignment T needs up to it
+    struct header {
+        char magic[8];
+        unsigned int version;
+        unsigned int elementSize;
+        unsigned long long typeTag;
+        unsigned long long size;
+        unsigned long long capacity;
+        char reserved[24];
+    };
+
+    std::string _path;
+    int _fd;
+    void* _map;
+    size_t _mapped;
+    value_type* _data;
+    size_type _size;
+    size_type _capacity;
+    bool _writable;
+
+    mmap_vector(const mmap_vector&);
+    mmap_vector& operator=(const mmap_vector&);
+
+    template <typename U>
+    static void swapValues(U& a, U& b) {
+        U tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    static const char* magic() { return "FTMMVEC"; }
+
+    void fail(const char* call) const {
+        throw std::runtime_error("mmap_vector: " + std::string(call) + " " + _path + ": " + std::strerror(errno));
+    }
+    void invalid(const char* why) const { throw std::runtime_error("mmap_vector: " + _path + ": " + why); }
+
+    void writable() const {
+        if (!_writable)
+            throw std::logic_error("mmap_vector: " + _path + " is open read-only");
+    }
+
+    header* head() const { return static_cast<header*>(_map); }
+
+    static size_t pageSize() {
+        static const size_t page = static_cast<size_t>(::sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    // the header and n elements, in whole pages
+    static size_t fileSize(size_type n) {
+        size_t bytes = sizeof(header) + n * sizeof(value_type);
+        return (bytes + pageSize() - 1) / pageSize() * pageSize();
+    }
+    static size_type capacityOf(size_t bytes) { return (bytes - sizeof(header)) / sizeof(value_type); }
+
+    void open(open_mode mode) {
+        int flags = mode == read_only ? O_RDONLY : O_RDWR | O_CREAT | (mode == truncate ? O_TRUNC : 0);
+        _fd = ::open(_path.c_str(), flags, 0644);
+        if (_fd < 0)
+            fail("open");
+        struct stat st;
+        if (::fstat(_fd, &st) < 0)
+            fail("fstat");
+        if (!st.st_size && _writable)
+        {
+            // a new file: the header and the first page of elements
+            if (::ftruncate(_fd, fileSize(0)) < 0)
+                fail("ftruncate");
+            mapFile(fileSize(0));
+            initHeader();
+            _capacity = capacityOf(fileSize(0));
+            return;
+        }
+        if (static_cast<size_t>(st.st_size) < sizeof(header))
+            invalid("file shorter than the header");
+        mapFile(static_cast<size_t>(st.st_size));
+        checkHeader();
+    }
+
+    void mapFile(size_t bytes) {
+        void* p = ::mmap(NULL, bytes, _writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_SHARED, _fd, 0);
+        if (p == MAP_FAILED)
+            fail("mmap");
+        _map = p;
+        _mapped = bytes;
+        _data = reinterpret_cast<value_type*>(static_cast<char*>(p) + sizeof(header));
+    }
+
+    void initHeader() {
+        header* h = head();
+        std::memcpy(h->magic, magic(), sizeof(h->magic));
+        h->version = FORMAT_VERSION;
+        h->elementSize = sizeof(value_type);
+        h->typeTag = mmap_type_tag<T>::value();
+        h->size = 0;
+        h->capacity = capacityOf(_mapped);
+    }
+
+    void checkHeader() {
+        const header* h = head();
+        if (std::memcmp(h->magic, magic(), sizeof(h->magic)))
+            invalid("not an mmap_vector file");
+        if (h->version != FORMAT_VERSION)
+            invalid("unknown format version");
+        if (h->elementSize != sizeof(value_type) || h->typeTag != mmap_type_tag<T>::value())
+            invalid("written for another element type");
+        if (h->size > h->capacity || h->capacity > capacityOf(_mapped))
+            invalid("header does not match the file size");
+        _size = static_cast<size_type>(h->size);
+        // a writer's file may have grown past the capacity it recorded
+        _capacity = _writable ? capacityOf(_mapped) : static_cast<size_type>(h->capacity);
+    }
+
+    void writeHeader() {
+        head()->size = _size;
+        head()->capacity = _capacity;
+    }
+
+    void grow(size_type n) {
+        if (n > max_size())
+            throw std::length_error("mmap_vector");
+        remap(n > 2 * _capacity ? n : 2 * _capacity);
+    }
+
+    // the file grows to n elements and is mapped again, maybe elsewhere
+    void remap(size_type n) {
+        size_t bytes = fileSize(n);
+        if (::ftruncate(_fd, static_cast<off_t>(bytes)) < 0)
+            fail("ftruncate");
+        if (::munmap(_map, _mapped) < 0)
+            fail("munmap");
+        _map = NULL;
+        mapFile(bytes);
+        _capacity = capacityOf(bytes);
+        writeHeader();
+    }
+
+    // room for n elements at index, the ones after moved up; returns where they go
+    value_type* makeGap(size_type index, size_type n) {
+        writable();
+        if (_size + n > _capacity)
+            grow(_size + n);
+        std::memmove(static_cast<void*>(_data + index + n), static_cast<const void*>(_data + index), (_size - index) * sizeof(value_type));
+        _size += n;
+        return _data + index;
+    }
+
+    // single-pass ranges are read once into memory, their length known only at the end
+    template <class InputIterator>
+    void rangeInsert(iterator position, InputIterator first, InputIterator last, std::input_iterator_tag) {
+        ft::vector<value_type> tmp(first, last);
+        insert(position, tmp.begin(), tmp.end());
+    }
+
+    template <class ForwardIterator>
+    void rangeInsert(iterator position, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        size_type len = ft::distance(first, last);
+        value_type* at = makeGap(position - begin(), len);
+        for (; first != last; ++first)
+            *at++ = *first;
+    }
+
+    void close() {
+        if (_map)
+        {
+            if (_writable)
+                writeHeader();
+            ::munmap(_map, _mapped);
+        }
+        if (_fd >= 0)
+            ::close(_fd);
+        _map = NULL;
+        _fd = -1;
+    }
+};
+
+template <class T>
+const unsigned mmap_vector<T>::FORMAT_VERSION;
+
+template <class T>
+void swap(mmap_vector<T>& x, mmap_vector<T>& y) { x.swap(y); }
+
+}
+
+#endif
@@ -0,0 +1,167 @@
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include <memory>
+#include <new>
+#include "../concurrency/atomic.hpp"
+#include "../utility.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ----------------------- FT::MPMC_QUEUE ---------------------- *
+    *
+    * Bounded FIFO ring shared by any number of producer and consumer
+    * threads, without locks. Each slot carries a sequence number that
+    * says whose turn it is: a slot of position p is free for the
+    * producer of ticket p when its sequence is p, and holds an element
+    * for the consumer of ticket p when it is p + 1. A producer claims
+    * a ticket with one CAS on the tail, writes the element, then
+    * publishes it by storing the sequence; consumers mirror this on
+    * the head, handing the slot back with sequence p + capacity.
+    *
+    * Producers and consumers only meet on the slot they hand over, and
+    * head and tail sit on separate cache lines. The capacity given to
+    * the constructor is rounded up to a power of two, at least 2: with
+    * one slot, p + 1 (full for ticket p) would read as free for p + 1.
+    *
+    * try_push, try_pop:    false when full / empty
+    * push, pop:            Wait, spinning then yielding, until there is
+    *                       room / an element
+    * size, empty:          Snapshot, may be stale as soon as it returns
+    * ------------------------------------------------------------- *
+    */
+template < class T, class Alloc = std::allocator<T> >
+class mpmc_queue
+{
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef size_t size_type;
+
+    explicit mpmc_queue(size_type capacity, const allocator_type& alloc = allocator_type())
+        : _mask(roundUp(capacity) - 1), _allocCell(alloc)
+    {
+        _cells = _allocCell.allocate(_mask + 1);
+        for (size_type i = 0; i <= _mask; ++i)
+            _cells[i].sequence = i;
+    }
+
+    ~mpmc_queue() {
+        for (size_type i = _head.ticket; i != _tail.ticket; ++i)
+            _cells[i & _mask].value()->~T();
+        _allocCell.deallocate(_cells, _mask + 1);
+    }
+
+    size_type capacity() const { return _mask + 1; }
+
+    // head first: read the other way round, pops after the tail read could pass it
+    size_type size() const {
+        size_type head = atomic_load(&_head.ticket);
+        size_type tail = atomic_load(&_tail.ticket);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const { return !size(); }
+
+    allocator_type get_allocator() const { return allocator_type(_allocCell); }
+
+    bool try_push(const value_type& val) {
+        size_type ticket;
+        cell_type* cell = claim(_tail.ticket, 0, ticket);
+        if (!cell)
+            return false;
+        new (cell->storage) T(val);
+        atomic_store(&cell->sequence, ticket + 1);
+        return true;
+    }
+
+    void push(const value_type& val) {
+        spin_backoff backoff;
+        while (!try_push(val))
+            backoff.pause();
+    }
+
+    bool try_pop(value_type& out) {
+        size_type ticket;
+        cell_type* cell = claim(_head.ticket, 1, ticket);
+        if (!cell)
+            return false;
+        T* val = cell->value();
+        out = *val;
+        val->~T();
+        atomic_store(&cell->sequence, ticket + _mask + 1);
+        return true;
+    }
+
+    void pop(value_type& out) {
+        spin_backoff backoff;
+        while (!try_pop(out))
+            backoff.pause();
+    }
+
+private:
+    struct cell_type {
+        size_type sequence;
+        union {
+            unsigned char storage[sizeof(T)];
+            long double alignLongDouble;
+            long long alignLongLong;
+            void* alignPointer;
+        };
+
+        T* value() { return reinterpret_cast<T*>(storage); }
+    };
+
+    // a ticket counter alone on its cache line
+    struct counter {
+        char front[CACHE_LINE];
+        size_type ticket;
+        char back[CACHE_LINE - sizeof(size_type)];
+
+        counter() : ticket(0) {}
+    };
+
+    typedef typename Alloc::template rebind<cell_type>::other cell_allocator;
+
+    size_type _mask;
+    cell_type* _cells;
+    cell_allocator _allocCell;
+    counter _tail;
+    counter _head;
+
+    mpmc_queue(const mpmc_queue&);
+    mpmc_queue& operator=(const mpmc_queue&);
+
+    static size_type roundUp(size_type n) {
+        size_type p = 2;
+        while (p < n)
+            p <<= 1;
+        return p;
+    }
+
+    // takes the next ticket of next once its cell is at sequence ticket + lag, NULL if
+    // the ring is full (producers, lag 0) or empty (consumers, lag 1)
+    cell_type* claim(size_type& next, size_type lag, size_type& ticket) {
+        ticket = atomic_load_relaxed(&next);
+        while (true)
+        {
+            cell_type* cell = &_cells[ticket & _mask];
+            size_type sequence = atomic_load(&cell->sequence);
+            long diff = static_cast<long>(sequence - (ticket + lag));
+            if (!diff)
+            {
+                if (atomic_compare_exchange(&next, ticket, ticket + 1))
+                    return cell;
+            }
+            else if (diff < 0)
+                return NULL;
+            else
+                ticket = atomic_load_relaxed(&next);
+        }
+    }
+};
+
+}
+
+#endif
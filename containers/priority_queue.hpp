@@ -0,0 +1,381 @@
+#ifndef PRIORITY_QUEUE_H
+#define PRIORITY_QUEUE_H
+
+#include "vector.hpp"
+#include "../utility.hpp"
+#include <memory>
+#include <stdexcept>
+
+namespace ft {
+
+// index arithmetic of a D-ary heap stored breadth first from slot 0
+namespace heap {
+
+template <size_t D>
+struct dary {
+    static size_t parent(size_t i) { return (i - 1) / D; }
+    static size_t firstChild(size_t i) { return D * i + 1; }
+};
+
+}
+
+/**
+    * ------------------------------------------------------------- *
+    * --------------------- FT::PRIORITY_QUEUE -------------------- *
+    *
+    * Container adapter keeping the element that comes last in Compare
+    * order on top (the largest with ft::less, the smallest with
+    * ft::greater), like std::priority_queue.
+    *
+    * The heap is D-ary, 4 by default: the tree is half as deep as a
+    * binary heap and the D children of a node sit next to each other,
+    * usually in one cache line, so a pop walks through fewer lines for
+    * a few more comparisons. D = 2 is the classic binary heap.
+    *
+    * (constructor):    Empty, from a container, or from a range; the
+    *                   range is heapified bottom up in O(n)
+    * top, push, pop:   O(1), O(log_D n), O(D log_D n)
+    * empty, size
+    * ------------------------------------------------------------- *
+    */
+template < class T, class Container = ft::vector<T>, class Compare = ft::less<T>, size_t D = 4 >
+class priority_queue
+{
+public:
+    typedef T           value_type;
+    typedef Container   container_type;
+    typedef Compare     value_compare;
+    typedef typename container_type::reference          reference;
+    typedef typename container_type::const_reference    const_reference;
+    typedef typename container_type::size_type          size_type;
+
+    static const size_t ARITY = D;
+
+    explicit priority_queue (const value_compare& compare = value_compare(), const container_type& ctnr = container_type())
+        : c(ctnr), comp(compare)
+    {
+        heapify();
+    }
+
+    template <class InputIterator>
+    priority_queue (InputIterator first, InputIterator last, const value_compare& compare = value_compare(), const container_type& ctnr = container_type(),
+                    typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0)
+        : c(ctnr), comp(compare)
+    {
+        for (; first != last; ++first)
+            c.push_back(*first);
+        heapify();
+    }
+
+    bool empty() const { return c.empty(); }
+
+    size_type size() const { return c.size(); }
+
+    const_reference top() const { return c.front(); }
+
+    void push (const value_type& val)
+    {
+        c.push_back(val);
+        siftUp(c.size() - 1);
+    }
+
+    void pop()
+    {
+        if (c.size() > 1)
+        {
+            value_type last = c.back();
+            c.pop_back();
+            popHole(last);
+        }
+        else
+            c.pop_back();
+    }
+
+protected:
+    container_type c;
+    value_compare comp;
+
+private:
+    typedef heap::dary<D> shape;
+
+    // Floyd: sift down every inner node, last one first
+    void heapify()
+    {
+        size_type n = c.size();
+        if (n < 2)
+            return;
+        for (size_type i = shape::parent(n - 1) + 1; i--; )
+        {
+            value_type val = c[i];
+            siftDown(i, val);
+        }
+    }
+
+    // the hole moves up, val is written once at its final slot
+    void siftUp(size_type i)
+    {
+        value_type val = c[i];
+        while (i)
+        {
+            size_type p = shape::parent(i);
+            if (!comp(c[p], val))
+                break;
+            c[i] = c[p];
+            i = p;
+        }
+        c[i] = val;
+    }
+
+    // the bottom element rarely climbs far: walk the hole left at the
+    // top down to a leaf comparing children only, then sift val up from there
+    void popHole(const value_type& val)
+    {
+        size_type n = c.size();
+        size_type i = 0;
+        while (true)
+        {
+            size_type first = shape::firstChild(i);
+            if (first >= n)
+                break;
+            size_type last = first + D < n ? first + D : n;
+            size_type best = first;
+            for (size_type k = first + 1; k < last; ++k)
+                if (comp(c[best], c[k]))
+                    best = k;
+            c[i] = c[best];
+            i = best;
+        }
+        c[i] = val;
+        siftUp(i);
+    }
+
+    // fills the hole at i with val, pulling the best child up until val fits
+    void siftDown(size_type i, const value_type& val)
+    {
+        size_type n = c.size();
+        while (true)
+        {
+            size_type first = shape::firstChild(i);
+            if (first >= n)
+                break;
+            size_type last = first + D < n ? first + D : n;
+            size_type best = first;
+            for (size_type k = first + 1; k < last; ++k)
+                if (comp(c[best], c[k]))
+                    best = k;
+            if (!comp(val, c[best]))
+                break;
+            c[i] = c[best];
+            i = best;
+        }
+        c[i] = val;
+    }
+};
+
+template < class T, class Container, class Compare, size_t D >
+const size_t priority_queue<T, Container, Compare, D>::ARITY;
+
+/**
+    * ------------------------------------------------------------- *
+    * ----------------- FT::INDEXED_PRIORITY_QUEUE ---------------- *
+    *
+    * D-ary heap whose elements can be reached after the push: push
+    * returns a handle, a small integer that stays valid until its
+    * element is popped or erased and is then reused. The heap holds
+    * handles, a position table maps each handle to its heap slot, so
+    * moving an element to its new place is O(log_D n).
+    *
+    * push, top, top_handle, pop
+    * decrease_key:     Give an element a value that moves it towards
+    *                   the top (a smaller one with ft::greater, the
+    *                   usual min-heap of timers and shortest paths)
+    * update:           Give an element any new value
+    * erase:            Remove an element by handle
+    * contains, value:  Test a handle, read its value
+    * (constructor):    From a range, heapified in O(n); the handle of
+    *                   the i-th element is i
+    * ------------------------------------------------------------- *
+    */
+template < class T, class Compare = ft::less<T>, size_t D = 4, class Alloc = std::allocator<T> >
+class indexed_priority_queue
+{
+public:
+    typedef T           value_type;
+    typedef Compare     value_compare;
+    typedef Alloc       allocator_type;
+    typedef size_t      size_type;
+    typedef size_t      handle_type;
+
+    explicit indexed_priority_queue (const value_compare& comp = value_compare(), const allocator_type& alloc = allocator_type())
+        : _values(alloc), _heap(alloc), _pos(alloc), _free(alloc), _comp(comp) {}
+
+    template <class InputIterator>
+    indexed_priority_queue (InputIterator first, InputIterator last, const value_compare& comp = value_compare(), const allocator_type& alloc = allocator_type(),
+                            typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0)
+        : _values(alloc), _heap(alloc), _pos(alloc), _free(alloc), _comp(comp)
+    {
+        for (; first != last; ++first)
+        {
+            _heap.push_back(_values.size());
+            _pos.push_back(_values.size());
+            _values.push_back(*first);
+        }
+        size_type n = _heap.size();
+        if (n < 2)
+            return;
+        for (size_type i = shape::parent(n - 1) + 1; i--; )
+            siftDown(i, _heap[i]);
+    }
+
+    bool empty() const { return _heap.empty(); }
+
+    size_type size() const { return _heap.size(); }
+
+    const value_type& top() const { return _values[_heap[0]]; }
+
+    handle_type top_handle() const { return _heap[0]; }
+
+    bool contains (handle_type h) const { return h < _pos.size() && _pos[h] != NPOS; }
+
+    const value_type& value (handle_type h) const { return _values[h]; }
+
+    handle_type push (const value_type& val)
+    {
+        handle_type h;
+        if (_free.empty())
+        {
+            h = _values.size();
+            _values.push_back(val);
+            _pos.push_back(0);
+        }
+        else
+        {
+            h = _free.back();
+            _free.pop_back();
+            _values[h] = val;
+        }
+        _heap.push_back(h);
+        siftUp(_heap.size() - 1, h);
+        return h;
+    }
+
+    void pop() { removeAt(0); }
+
+    void erase (handle_type h)
+    {
+        checkHandle(h);
+        removeAt(_pos[h]);
+    }
+
+    // val must not come before the current value in Compare order
+    void decrease_key (handle_type h, const value_type& val)
+    {
+        checkHandle(h);
+        if (_comp(val, _values[h]))
+            throw std::invalid_argument("indexed_priority_queue::decrease_key");
+        _values[h] = val;
+        siftUp(_pos[h], h);
+    }
+
+    void update (handle_type h, const value_type& val)
+    {
+        checkHandle(h);
+        bool up = _comp(_values[h], val);
+        _values[h] = val;
+        if (up)
+            siftUp(_pos[h], h);
+        else
+            siftDown(_pos[h], h);
+    }
+
+    void clear()
+    {
+        _values.clear();
+        _heap.clear();
+        _pos.clear();
+        _free.clear();
+    }
+
+private:
+    typedef heap::dary<D> shape;
+    typedef ft::vector<size_type, typename Alloc::template rebind<size_type>::other> index_vector;
+
+    static const size_type NPOS = static_cast<size_type>(-1);
+
+    // indexed by handle; the value of a free handle is stale until reused
+    ft::vector<T, Alloc> _values;
+    index_vector _heap;
+    index_vector _pos;
+    index_vector _free;
+    value_compare _comp;
+
+    void checkHandle (handle_type h) const
+    {
+        if (!contains(h))
+            throw std::out_of_range("indexed_priority_queue");
+    }
+
+    void place (size_type i, handle_type h)
+    {
+        _heap[i] = h;
+        _pos[h] = i;
+    }
+
+    void removeAt (size_type i)
+    {
+        handle_type gone = _heap[i];
+        handle_type last = _heap.back();
+        _heap.pop_back();
+        _pos[gone] = NPOS;
+        _free.push_back(gone);
+        if (i == _heap.size())
+            return;
+        if (i && _comp(_values[_heap[shape::parent(i)]], _values[last]))
+            siftUp(i, last);
+        else
+            siftDown(i, last);
+    }
+
+    void siftUp (size_type i, handle_type h)
+    {
+        const value_type& val = _values[h];
+        while (i)
+        {
+            size_type p = shape::parent(i);
+            if (!_comp(_values[_heap[p]], val))
+                break;
+            place(i, _heap[p]);
+            i = p;
+        }
+        place(i, h);
+    }
+
+    void siftDown (size_type i, handle_type h)
+    {
+        const value_type& val = _values[h];
+        size_type n = _heap.size();
+        while (true)
+        {
+            size_type first = shape::firstChild(i);
+            if (first >= n)
+                break;
+            size_type last = first + D < n ? first + D : n;
+            size_type best = first;
+            for (size_type k = first + 1; k < last; ++k)
+                if (_comp(_values[_heap[best]], _values[_heap[k]]))
+                    best = k;
+            if (!_comp(val, _values[_heap[best]]))
+                break;
+            place(i, _heap[best]);
+            i = best;
+        }
+        place(i, h);
+    }
+};
+
+template < class T, class Compare, size_t D, class Alloc >
+const typename indexed_priority_queue<T, Compare, D, Alloc>::size_type indexed_priority_queue<T, Compare, D, Alloc>::NPOS;
+
+}
+
+#endif
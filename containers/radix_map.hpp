@@ -0,0 +1,908 @@
+#ifndef RADIX_MAP_H
+#define RADIX_MAP_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <limits>
+#include "../iterator/list_iterator.hpp"
+#include "../utility.hpp"
+#include "../algorithm/simd.hpp"
+
+namespace ft {
+
+/**
+    * How a radix_map key becomes the bytes the tree branches on, in
+    * the order of the keys: k1 < k2 iff bytes(k1) < bytes(k2) compared
+    * as unsigned chars, a shorter prefix first.
+    *
+    * - Integral keys (ft::is_integral): big-endian, the sign bit
+    *   flipped for signed types, sizeof(Key) bytes.
+    * - Anything else with data() and size() over chars, std::string
+    *   and ft::string: its bytes as they are.
+    *
+    * Specialize it for other keys; bytes() may return a pointer into
+    * the key or fill buf, at most KEY_BUFFER bytes.
+    */
+template <class Key, class Enable = void>
+struct radix_key {
+    static size_t length(const Key& k) { return k.size(); }
+    static const unsigned char* bytes(const Key& k, unsigned char*) { return reinterpret_cast<const unsigned char*>(k.data()); }
+};
+
+template <class Key>
+struct radix_key<Key, typename ft::enable_if<ft::is_integral<Key>::value>::type> {
+    static size_t length(const Key&) { return sizeof(Key); }
+    static const unsigned char* bytes(const Key& k, unsigned char* buf) {
+        unsigned long long v = static_cast<unsigned long long>(k);
+        if (std::numeric_limits<Key>::is_signed)
+            v ^= 1ULL << (sizeof(Key) * 8 - 1);
+        for (size_t i = 0; i < sizeof(Key); ++i)
+            buf[i] = static_cast<unsigned char>(v >> (8 * (sizeof(Key) - 1 - i)));
+        return buf;
+    }
+};
+
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------ FT::RADIX_MAP ---------------------- *
+    *
+    * Ordered map on an adaptive radix tree (Leis et al., ICDE 2013):
+    * each inner node branches on one byte of the key (radix_key), so
+    * a lookup costs one step per distinct byte, not log n full key
+    * comparisons, and touches the stored key once, at the leaf.
+    *
+    * - Inner nodes grow and shrink with their children: node4 and
+    *   node16 keep sorted keys (node16 searched with one SSE2
+    *   compare), node48 a 256 byte index into 48 slots, node256 a
+    *   direct array.
+    * - Path compression: a node skips the bytes all its keys share,
+    *   storing the first MAX_PREFIX of them; lookups compare those and
+    *   check the full key at the leaf, inserts read the rest from a
+    *   leaf below.
+    * - A key that is a prefix of others ("a/b" and "a/b/c") is the
+    *   terminal leaf of the node where it ends.
+    * - Leaves are also threaded in key order, as ft::map's nodes are:
+    *   iteration is a list walk, lower_bound and upper_bound descend
+    *   once and fall back to the smallest leaf of the next branch.
+    *
+    * Same members as ft::map minus the comparators, the hinted insert
+    * and the reverse iterators. Iterators and references stay valid
+    * until their own element is erased.
+    * ------------------------------------------------------------- *
+    */
+template <class Key, class T, class Alloc = std::allocator<ft::pair<const Key, T> > >
+class radix_map
+{
+private:
+    struct leaf {
+        leaf* prev;
+        leaf* next;
+        ft::pair<const Key, T> content;
+    };
+
+public:
+    typedef Key key_type;
+    typedef T mapped_type;
+    typedef ft::pair<const Key, T> value_type;
+    typedef Alloc allocator_type;
+    typedef typename allocator_type::reference reference;
+    typedef typename allocator_type::const_reference const_reference;
+    typedef typename allocator_type::pointer pointer;
+    typedef typename allocator_type::const_pointer const_pointer;
+    typedef ft::list_iterator<value_type, leaf, false> iterator;
+    typedef ft::list_iterator<value_type, leaf, true> const_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    static const size_t KEY_BUFFER = 16;
+
+private:
+    typedef radix_key<Key> traits;
+
+    enum { NODE4, NODE16, NODE48, NODE256 };
+    enum { MAX_PREFIX = 10 };
+
+    struct inner {
+        unsigned char type;
+        unsigned char prefix[MAX_PREFIX];   // the first bytes of the skipped ones
+        unsigned short count;               // children, the terminal leaf aside
+        size_t prefixLen;                   // bytes skipped before branching
+        leaf* terminal;                     // the key ending at this node
+    };
+    struct node4 : inner {
+        unsigned char keys[4];
+        void* children[4];
+    };
+    struct node16 : inner {
+        unsigned char keys[16];
+        void* children[16];
+    };
+    struct node48 : inner {
+        unsigned char index[256];           // slot + 1, 0 when absent
+        void* children[48];
+    };
+    struct node256 : inner {
+        void* children[256];
+    };
+
+    typedef typename allocator_type::template rebind<leaf>::other leaf_allocator_type;
+
+    // a child is an inner node or a leaf, the low bit set for a leaf
+    void* _root;
+    leaf* _end;
+    allocator_type _alloc;
+    size_type _size;
+
+public:
+    explicit radix_map(const allocator_type& alloc = allocator_type()) : _root(NULL), _alloc(alloc), _size(0) {
+        _end = createEnd();
+    }
+
+    template <class InputIterator>
+    radix_map(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
+        typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type* = 0) : _root(NULL), _alloc(alloc), _size(0) {
+        _end = createEnd();
+        insert(first, last);
+    }
+
+    radix_map(const radix_map& x) : _root(NULL), _alloc(x._alloc), _size(0) {
+        _end = createEnd();
+        if (x._root)
+            _root = cloneTree(x._root);
+        _size = x._size;
+    }
+
+    ~radix_map() {
+        clear();
+        leaf_allocator_type(_alloc).deallocate(_end, 1);
+    }
+
+    radix_map& operator=(const radix_map& x) {
+        radix_map tmp(x);
+        swap(tmp);
+        return *this;
+    }
+
+    iterator begin() { return iterator(_end->next); }
+    const_iterator begin() const { return const_iterator(_end->next); }
+    iterator end() { return iterator(_end); }
+    const_iterator end() const { return const_iterator(_end); }
+
+    bool empty() const { return !_size; }
+    size_type size() const { return _size; }
+    size_type max_size() const { return leaf_allocator_type(_alloc).max_size(); }
+    allocator_type get_allocator() const { return _alloc; }
+
+    mapped_type& operator[](const key_type& k) { return insert(ft::make_pair<const Key, T>(k, mapped_type())).first->second; }
+
+    ft::pair<iterator, bool> insert(const value_type& val) {
+        unsigned char buf[KEY_BUFFER];
+        const unsigned char* kb = traits::bytes(val.first, buf);
+        size_t len = traits::length(val.first);
+        ft::pair<leaf*, bool> res = insertLeaf(val, kb, len);
+        if (res.second)
+        {
+            leaf* next = bound(_root, kb, len, 0, true);
+            link(res.first, next ? next : _end);
+            ++_size;
+        }
+        return ft::pair<iterator, bool>(iterator(res.first), res.second);
+    }
+
+    template <class InputIterator>
+    void insert(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            insert(*first);
+    }
+
+    void erase(iterator position) { erase(position->first); }
+
+    size_type erase(const key_type& k) {
+        unsigned char buf[KEY_BUFFER];
+        leaf* l = eraseLeaf(traits::bytes(k, buf), traits::length(k));
+        if (!l)
+            return 0;
+        unlink(l);
+        destroyLeaf(l);
+        --_size;
+        return 1;
+    }
+
+    void erase(iterator first, iterator last) {
+        while (first != last)
+            erase(first++);
+    }
+
+    void swap(radix_map& x) {
+        swapValues(_root, x._root);
+        swapValues(_end, x._end);
+        swapValues(_alloc, x._alloc);
+        swapValues(_size, x._size);
+    }
+
+    void clear() {
+        if (_root)
+            freeTree(_root);
+        _root = NULL;
+        _end->next = _end;
+        _end->prev = _end;
+        _size = 0;
+    }
+
+    iterator find(const key_type& k) {
+        leaf* l = findLeaf(k);
+        return iterator(l ? l : _end);
+    }
+    const_iterator find(const key_type& k) const {
+        leaf* l = findLeaf(k);
+        return const_iterator(l ? l : _end);
+    }
+    size_type count(const key_type& k) const { return findLeaf(k) ? 1 : 0; }
+
+    iterator lower_bound(const key_type& k) { return iterator(boundLeaf(k, false)); }
+    const_iterator lower_bound(const key_type& k) const { return const_iterator(boundLeaf(k, false)); }
+    iterator upper_bound(const key_type& k) { return iterator(boundLeaf(k, true)); }
+    const_iterator upper_bound(const key_type& k) const { return const_iterator(boundLeaf(k, true)); }
+    ft::pair<iterator, iterator> equal_range(const key_type& k) { return ft::pair<iterator, iterator>(lower_bound(k), upper_bound(k)); }
+    ft::pair<const_iterator, const_iterator> equal_range(const key_type& k) const {
+        return ft::pair<const_iterator, const_iterator>(lower_bound(k), upper_bound(k));
+    }
+
+private:
+    template <typename U>
+    static void swapValues(U& a, U& b) {
+        U tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    static size_t minSize(size_t a, size_t b) { return a < b ? a : b; }
+
+    static bool isLeaf(const void* r) { return reinterpret_cast<size_t>(r) & 1; }
+    static leaf* toLeaf(const void* r) { return reinterpret_cast<leaf*>(reinterpret_cast<size_t>(r) & ~static_cast<size_t>(1)); }
+    static inner* toInner(void* r) { return static_cast<inner*>(r); }
+    static void* leafRef(leaf* l) { return reinterpret_cast<void*>(reinterpret_cast<size_t>(l) | 1); }
+
+    static const unsigned char* keyBytes(const leaf* l, unsigned char* buf) { return traits::bytes(l->content.first, buf); }
+
+    static bool keyEquals(const leaf* l, const unsigned char* kb, size_t len) {
+        unsigned char buf[KEY_BUFFER];
+        return traits::length(l->content.first) == len && (!len || !std::memcmp(keyBytes(l, buf), kb, len));
+    }
+
+    // <0, 0, >0 as the leaf's key is below, equal to or above kb
+    static int compareKey(const leaf* l, const unsigned char* kb, size_t len) {
+        unsigned char buf[KEY_BUFFER];
+        size_t llen = traits::length(l->content.first);
+        size_t n = minSize(llen, len);
+        int c = n ? std::memcmp(keyBytes(l, buf), kb, n) : 0;
+        if (c)
+            return c;
+        return llen < len ? -1 : llen > len;
+    }
+
+    /* ------------------------------ nodes ------------------------------ */
+
+    template <class N>
+    N* createNode(unsigned char type) {
+        N* n = typename allocator_type::template rebind<N>::other(_alloc).allocate(1);
+        std::memset(static_cast<void*>(n), 0, sizeof(N));
+        n->type = type;
+        return n;
+    }
+
+    void freeNode(inner* n) {
+        switch (n->type)
+        {
+        case NODE4:
+            typename allocator_type::template rebind<node4>::other(_alloc).deallocate(static_cast<node4*>(n), 1);
+            break;
+        case NODE16:
+            typename allocator_type::template rebind<node16>::other(_alloc).deallocate(static_cast<node16*>(n), 1);
+            break;
+        case NODE48:
+            typename allocator_type::template rebind<node48>::other(_alloc).deallocate(static_cast<node48*>(n), 1);
+            break;
+        default:
+            typename allocator_type::template rebind<node256>::other(_alloc).deallocate(static_cast<node256*>(n), 1);
+        }
+    }
+
+    static void copyHeader(inner* to, const inner* from) {
+        to->count = from->count;
+        to->prefixLen = from->prefixLen;
+        std::memcpy(to->prefix, from->prefix, MAX_PREFIX);
+        to->terminal = from->terminal;
+    }
+
+    // the slot of the child on byte b, NULL when there is none
+    static void** findChild(inner* n, unsigned char b) {
+        switch (n->type)
+        {
+        case NODE4:
+        {
+            node4* p = static_cast<node4*>(n);
+            for (unsigned i = 0; i < p->count; ++i)
+                if (p->keys[i] == b)
+                    return &p->children[i];
+            return NULL;
+        }
+        case NODE16:
+        {
+            node16* p = static_cast<node16*>(n);
+#if FT_SIMD_X86 && defined(__SSE2__)
+            __m128i keys = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p->keys));
+            unsigned hits = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(keys, _mm_set1_epi8(static_cast<char>(b)))));
+            hits &= (1U << p->count) - 1;
+            return hits ? &p->children[__builtin_ctz(hits)] : NULL;
+#else
+            for (unsigned i = 0; i < p->count; ++i)
+                if (p->keys[i] == b)
+                    return &p->children[i];
+            return NULL;
+#endif
+        }
+        case NODE48:
+        {
+            node48* p = static_cast<node48*>(n);
+            return p->index[b] ? &p->children[p->index[b] - 1] : NULL;
+        }
+        default:
+        {
+            node256* p = static_cast<node256*>(n);
+            return p->children[b] ? &p->children[b] : NULL;
+        }
+        }
+    }
+
+    // the child on the smallest byte above after (-1 for the first), NULL when there is none
+    static void* nextChild(const inner* n, int after, int* key = NULL) {
+        switch (n->type)
+        {
+        case NODE4:
+        case NODE16:
+        {
+            const unsigned char* keys = n->type == NODE4 ? static_cast<const node4*>(n)->keys : static_cast<const node16*>(n)->keys;
+            void* const* children = n->type == NODE4 ? static_cast<const node4*>(n)->children : static_cast<const node16*>(n)->children;
+            for (unsigned i = 0; i < n->count; ++i)
+                if (keys[i] > after)
+                {
+                    if (key)
+                        *key = keys[i];
+                    return children[i];
+                }
+            return NULL;
+        }
+        case NODE48:
+        {
+            const node48* p = static_cast<const node48*>(n);
+            for (int b = after + 1; b < 256; ++b)
+                if (p->index[b])
+                {
+                    if (key)
+                        *key = b;
+                    return p->children[p->index[b] - 1];
+                }
+            return NULL;
+        }
+        default:
+        {
+            const node256* p = static_cast<const node256*>(n);
+            for (int b = after + 1; b < 256; ++b)
+                if (p->children[b])
+                {
+                    if (key)
+                        *key = b;
+                    return p->children[b];
+                }
+            return NULL;
+        }
+        }
+    }
+
+    static leaf* minimumLeaf(void* r) {
+        while (!isLeaf(r))
+        {
+            inner* n = toInner(r);
+            if (n->terminal)
+                return n->terminal;
+            r = nextChild(n, -1);
+        }
+        return toLeaf(r);
+    }
+
+    // room for one more child in a sorted node4 / node16
+    static void insertSorted(unsigned char* keys, void** children, unsigned count, unsigned char b, void* child) {
+        unsigned i = 0;
+        while (i < count && keys[i] < b)
+            ++i;
+        std::memmove(keys + i + 1, keys + i, count - i);
+        std::memmove(children + i + 1, children + i, (count - i) * sizeof(void*));
+        keys[i] = b;
+        children[i] = child;
+    }
+
+    // adds child on byte b to n, held by slot; a full node is replaced by the next size
+    void addChild(void*& slot, inner* n, unsigned char b, void* child) {
+        switch (n->type)
+        {
+        case NODE4:
+        {
+            node4* p = static_cast<node4*>(n);
+            if (p->count < 4)
+            {
+                insertSorted(p->keys, p->children, p->count++, b, child);
+                return;
+            }
+            node16* g = createNode<node16>(NODE16);
+            copyHeader(g, p);
+            std::memcpy(g->keys, p->keys, 4);
+            std::memcpy(g->children, p->children, 4 * sizeof(void*));
+            freeNode(p);
+            slot = g;
+            return addChild(slot, g, b, child);
+        }
+        case NODE16:
+        {
+            node16* p = static_cast<node16*>(n);
+            if (p->count < 16)
+            {
+                insertSorted(p->keys, p->children, p->count++, b, child);
+                return;
+            }
+            node48* g = createNode<node48>(NODE48);
+            copyHeader(g, p);
+            for (unsigned i = 0; i < 16; ++i)
+            {
+                g->index[p->keys[i]] = static_cast<unsigned char>(i + 1);
+                g->children[i] = p->children[i];
+            }
+            freeNode(p);
+            slot = g;
+            return addChild(slot, g, b, child);
+        }
+        case NODE48:
+        {
+            node48* p = static_cast<node48*>(n);
+            if (p->count < 48)
+            {
+                unsigned i = 0;
+                while (p->children[i])
+                    ++i;
+                p->children[i] = child;
+                p->index[b] = static_cast<unsigned char>(i + 1);
+                ++p->count;
+                return;
+            }
+            node256* g = createNode<node256>(NODE256);
+            copyHeader(g, p);
+            for (int k = 0; k < 256; ++k)
+                if (p->index[k])
+                    g->children[k] = p->children[p->index[k] - 1];
+            freeNode(p);
+            slot = g;
+            return addChild(slot, g, b, child);
+        }
+        default:
+        {
+            node256* p = static_cast<node256*>(n);
+            p->children[b] = child;
+            ++p->count;
+        }
+        }
+    }
+
+    static void removeChild(inner* n, unsigned char b) {
+        switch (n->type)
+        {
+        case NODE4:
+        case NODE16:
+        {
+            unsigned char* keys = n->type == NODE4 ? static_cast<node4*>(n)->keys : static_cast<node16*>(n)->keys;
+            void** children = n->type == NODE4 ? static_cast<node4*>(n)->children : static_cast<node16*>(n)->children;
+            unsigned i = 0;
+            while (keys[i] != b)
+                ++i;
+            std::memmove(keys + i, keys + i + 1, n->count - i - 1);
+            std::memmove(children + i, children + i + 1, (n->count - i - 1) * sizeof(void*));
+            break;
+        }
+        case NODE48:
+        {
+            node48* p = static_cast<node48*>(n);
+            p->children[p->index[b] - 1] = NULL;
+            p->index[b] = 0;
+            break;
+        }
+        default:
+            static_cast<node256*>(n)->children[b] = NULL;
+        }
+        --n->count;
+    }
+
+    // after a removal from n, starting at depth and held by slot: a node left with one entry
+    // is replaced by it, the others move down a size below a third of their capacity
+    void shrink(void*& slot, inner* n, size_t depth) {
+        if (n->count + (n->terminal ? 1 : 0) == 1)
+        {
+            int b = -1;
+            void* only = n->terminal ? leafRef(n->terminal) : nextChild(n, -1, &b);
+            if (!isLeaf(only))
+            {
+                // the child now also skips n's prefix and the byte leading to it
+                inner* c = toInner(only);
+                unsigned char buf[KEY_BUFFER];
+                c->prefixLen += n->prefixLen + 1;
+                std::memcpy(c->prefix, keyBytes(minimumLeaf(only), buf) + depth, minSize(c->prefixLen, MAX_PREFIX));
+            }
+            freeNode(n);
+            slot = only;
+            return;
+        }
+        if (n->type == NODE16 && n->count <= 3)
+        {
+            node16* p = static_cast<node16*>(n);
+            node4* s = createNode<node4>(NODE4);
+            copyHeader(s, p);
+            std::memcpy(s->keys, p->keys, p->count);
+            std::memcpy(s->children, p->children, p->count * sizeof(void*));
+            freeNode(p);
+            slot = s;
+        }
+        else if (n->type == NODE48 && n->count <= 12)
+        {
+            node48* p = static_cast<node48*>(n);
+            node16* s = createNode<node16>(NODE16);
+            copyHeader(s, p);
+            unsigned i = 0;
+            for (int k = 0; k < 256; ++k)
+                if (p->index[k])
+                {
+                    s->keys[i] = static_cast<unsigned char>(k);
+                    s->children[i++] = p->children[p->index[k] - 1];
+                }
+            freeNode(p);
+            slot = s;
+        }
+        else if (n->type == NODE256 && n->count <= 37)
+        {
+            node256* p = static_cast<node256*>(n);
+            node48* s = createNode<node48>(NODE48);
+            copyHeader(s, p);
+            unsigned i = 0;
+            for (int k = 0; k < 256; ++k)
+                if (p->children[k])
+                {
+                    s->children[i] = p->children[k];
+                    s->index[k] = static_cast<unsigned char>(++i);
+                }
+            freeNode(p);
+            slot = s;
+        }
+    }
+
+    /* ------------------------------ leaves ----------------------------- */
+
+    leaf* createEnd() {
+        leaf* e = leaf_allocator_type(_alloc).allocate(1);
+        e->prev = e;
+        e->next = e;
+        return e;
+    }
+
+    leaf* createLeaf(const value_type& val) {
+        leaf* l = leaf_allocator_type(_alloc).allocate(1);
+        _alloc.construct(&l->content, val);
+        return l;
+    }
+
+    void destroyLeaf(leaf* l) {
+        _alloc.destroy(&l->content);
+        leaf_allocator_type(_alloc).deallocate(l, 1);
+    }
+
+    // l goes right before next in key order
+    static void link(leaf* l, leaf* next) {
+        l->next = next;
+        l->prev = next->prev;
+        next->prev->next = l;
+        next->prev = l;
+    }
+
+    static void unlink(leaf* l) {
+        l->prev->next = l->next;
+        l->next->prev = l->prev;
+    }
+
+    /* ------------------------------ trees ------------------------------ */
+
+    // copies the subtree, appending its leaves in order before _end
+    void* cloneTree(void* r) {
+        if (isLeaf(r))
+        {
+            leaf* l = createLeaf(toLeaf(r)->content);
+            link(l, _end);
+            return leafRef(l);
+        }
+        inner* n = toInner(r);
+        inner* c;
+        switch (n->type)
+        {
+        case NODE4:
+            c = createNode<node4>(NODE4);
+            break;
+        case NODE16:
+            c = createNode<node16>(NODE16);
+            break;
+        case NODE48:
+            c = createNode<node48>(NODE48);
+            break;
+        default:
+            c = createNode<node256>(NODE256);
+        }
+        copyHeader(c, n);
+        c->count = 0;
+        if (n->terminal)
+        {
+            c->terminal = createLeaf(n->terminal->content);
+            link(c->terminal, _end);
+        }
+        // the copy holds one node until its children are added, the slot follows its growth
+        void* slot = c;
+        int b = -1;
+        for (void* child = nextChild(n, b, &b); child; child = nextChild(n, b, &b))
+            addChild(slot, toInner(slot), static_cast<unsigned char>(b), cloneTree(child));
+        return slot;
+    }
+
+    void freeTree(void* r) {
+        if (isLeaf(r))
+            return destroyLeaf(toLeaf(r));
+        inner* n = toInner(r);
+        int b = -1;
+        for (void* child = nextChild(n, b, &b); child; child = nextChild(n, b, &b))
+            freeTree(child);
+        if (n->terminal)
+            destroyLeaf(n->terminal);
+        freeNode(n);
+    }
+
+    // bytes of the prefix of n, starting at depth, that kb matches: all of them, or where they differ
+    static size_t prefixMismatch(void* r, const unsigned char* kb, size_t len, size_t depth) {
+        inner* n = toInner(r);
+        size_t max = minSize(n->prefixLen, len - depth);
+        size_t stored = minSize(max, MAX_PREFIX);
+        size_t i = 0;
+        for (; i < stored; ++i)
+            if (n->prefix[i] != kb[depth + i])
+                return i;
+        if (max > stored)
+        {
+            unsigned char buf[KEY_BUFFER];
+            const unsigned char* full = keyBytes(minimumLeaf(r), buf);
+            for (; i < max; ++i)
+                if (full[depth + i] != kb[depth + i])
+                    return i;
+        }
+        return i;
+    }
+
+    // n gets leaf l for a key whose next byte is at depth, or that ends there
+    static void placeLeaf(node4* n, const unsigned char* kb, size_t len, size_t depth, leaf* l) {
+        if (depth == len)
+            n->terminal = l;
+        else
+            insertSorted(n->keys, n->children, n->count++, kb[depth], leafRef(l));
+    }
+
+    // the leaf of val's key, created unlinked when it is new
+    ft::pair<leaf*, bool> insertLeaf(const value_type& val, const unsigned char* kb, size_t len) {
+        void** slot = &_root;
+        size_t depth = 0;
+        while (true)
+        {
+            void* r = *slot;
+            if (!r)
+            {
+                leaf* l = createLeaf(val);
+                *slot = leafRef(l);
+                return ft::make_pair(l, true);
+            }
+            if (isLeaf(r))
+            {
+                leaf* old = toLeaf(r);
+                unsigned char buf[KEY_BUFFER];
+                const unsigned char* ob = keyBytes(old, buf);
+                size_t olen = traits::length(old->content.first);
+                size_t common = depth;
+                size_t limit = minSize(len, olen);
+                while (common < limit && ob[common] == kb[common])
+                    ++common;
+                if (common == len && common == olen)
+                    return ft::make_pair(old, false);
+                leaf* l = createLeaf(val);
+                node4* n = createNode<node4>(NODE4);
+                n->prefixLen = common - depth;
+                std::memcpy(n->prefix, kb + depth, minSize(n->prefixLen, MAX_PREFIX));
+                placeLeaf(n, ob, olen, common, old);
+                placeLeaf(n, kb, len, common, l);
+                *slot = n;
+                return ft::make_pair(l, true);
+            }
+            inner* n = toInner(r);
+            if (n->prefixLen)
+            {
+                size_t p = prefixMismatch(r, kb, len, depth);
+                if (p < n->prefixLen)
+                {
+                    // a new node4 takes the p shared bytes, n keeps what follows the byte they differ on
+                    unsigned char buf[KEY_BUFFER];
+                    const unsigned char* full = n->prefixLen > MAX_PREFIX ? keyBytes(minimumLeaf(r), buf) + depth : n->prefix;
+                    unsigned char branch = full[p];
+                    leaf* l = createLeaf(val);
+                    node4* top = createNode<node4>(NODE4);
+                    top->prefixLen = p;
+                    std::memcpy(top->prefix, kb + depth, minSize(p, MAX_PREFIX));
+                    n->prefixLen -= p + 1;
+                    std::memmove(n->prefix, full + p + 1, minSize(n->prefixLen, MAX_PREFIX));
+                    insertSorted(top->keys, top->children, top->count++, branch, r);
+                    placeLeaf(top, kb, len, depth + p, l);
+                    *slot = top;
+                    return ft::make_pair(l, true);
+                }
+                depth += n->prefixLen;
+            }
+            if (depth == len)
+            {
+                if (n->terminal)
+                    return ft::make_pair(n->terminal, false);
+                n->terminal = createLeaf(val);
+                return ft::make_pair(n->terminal, true);
+            }
+            void** child = findChild(n, kb[depth]);
+            if (!child)
+            {
+                leaf* l = createLeaf(val);
+                addChild(*slot, n, kb[depth], leafRef(l));
+                return ft::make_pair(l, true);
+            }
+            slot = child;
+            ++depth;
+        }
+    }
+
+    // the stored prefixes are compared, the leaf checks the whole key
+    leaf* findLeaf(const key_type& k) const {
+        unsigned char buf[KEY_BUFFER];
+        const unsigned char* kb = traits::bytes(k, buf);
+        size_t len = traits::length(k);
+        void* r = _root;
+        size_t depth = 0;
+        while (r)
+        {
+            if (isLeaf(r))
+                return keyEquals(toLeaf(r), kb, len) ? toLeaf(r) : NULL;
+            inner* n = toInner(r);
+            if (n->prefixLen)
+            {
+                if (n->prefixLen > len - depth || std::memcmp(n->prefix, kb + depth, minSize(n->prefixLen, MAX_PREFIX)))
+                    return NULL;
+                depth += n->prefixLen;
+            }
+            if (depth == len)
+                return n->terminal && keyEquals(n->terminal, kb, len) ? n->terminal : NULL;
+            void** child = findChild(n, kb[depth]);
+            if (!child)
+                return NULL;
+            r = *child;
+            ++depth;
+        }
+        return NULL;
+    }
+
+    // unhooks the leaf of kb from the tree, NULL when absent
+    leaf* eraseLeaf(const unsigned char* kb, size_t len) {
+        void** slot = &_root;
+        size_t depth = 0;
+        while (*slot)
+        {
+            void* r = *slot;
+            if (isLeaf(r))
+            {
+                if (!keyEquals(toLeaf(r), kb, len))
+                    return NULL;
+                *slot = NULL;
+                return toLeaf(r);
+            }
+            inner* n = toInner(r);
+            size_t nodeDepth = depth;
+            if (n->prefixLen)
+            {
+                if (n->prefixLen > len - depth || std::memcmp(n->prefix, kb + depth, minSize(n->prefixLen, MAX_PREFIX)))
+                    return NULL;
+                depth += n->prefixLen;
+            }
+            if (depth == len)
+            {
+                leaf* l = n->terminal;
+                if (!l || !keyEquals(l, kb, len))
+                    return NULL;
+                n->terminal = NULL;
+                shrink(*slot, n, nodeDepth);
+                return l;
+            }
+            void** child = findChild(n, kb[depth]);
+            if (!child)
+                return NULL;
+            if (isLeaf(*child))
+            {
+                leaf* l = toLeaf(*child);
+                if (!keyEquals(l, kb, len))
+                    return NULL;
+                removeChild(n, kb[depth]);
+                shrink(*slot, n, nodeDepth);
+                return l;
+            }
+            slot = child;
+            ++depth;
+        }
+        return NULL;
+    }
+
+    leaf* boundLeaf(const key_type& k, bool strict) const {
+        unsigned char buf[KEY_BUFFER];
+        leaf* l = _root ? bound(_root, traits::bytes(k, buf), traits::length(k), 0, strict) : NULL;
+        return l ? l : _end;
+    }
+
+    // the first leaf under r whose key is >= kb (> kb when strict), NULL when none is
+    static leaf* bound(void* r, const unsigned char* kb, size_t len, size_t depth, bool strict) {
+        if (isLeaf(r))
+        {
+            int c = compareKey(toLeaf(r), kb, len);
+            return c > 0 || (!c && !strict) ? toLeaf(r) : NULL;
+        }
+        inner* n = toInner(r);
+        if (n->prefixLen)
+        {
+            unsigned char buf[KEY_BUFFER];
+            const unsigned char* full = n->prefixLen > MAX_PREFIX ? keyBytes(minimumLeaf(r), buf) + depth : n->prefix;
+            for (size_t i = 0; i < n->prefixLen; ++i)
+            {
+                // kb ran out: it is a prefix of every key below
+                if (depth + i == len || full[i] > kb[depth + i])
+                    return minimumLeaf(r);
+                if (full[i] < kb[depth + i])
+                    return NULL;
+            }
+            depth += n->prefixLen;
+        }
+        if (depth == len)
+        {
+            if (n->terminal && !strict)
+                return n->terminal;
+            void* first = nextChild(n, -1);
+            return first ? minimumLeaf(first) : NULL;
+        }
+        void** child = findChild(n, kb[depth]);
+        if (child)
+        {
+            leaf* l = bound(*child, kb, len, depth + 1, strict);
+            if (l)
+                return l;
+        }
+        void* next = nextChild(n, kb[depth]);
+        return next ? minimumLeaf(next) : NULL;
+    }
+};
+
+template <class Key, class T, class Alloc>
+const size_t radix_map<Key, T, Alloc>::KEY_BUFFER;
+
+template <class Key, class T, class Alloc>
+void swap(radix_map<Key, T, Alloc>& x, radix_map<Key, T, Alloc>& y) { x.swap(y); }
+
+}
+
+#endif
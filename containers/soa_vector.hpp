@@ -0,0 +1,250 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include "vector.hpp"
+#include "span.hpp"
+#include "../iterator/soa_iterator.hpp"
+#include "../utility.hpp"
+#include <memory>
+#include <stdexcept>
+#include <algorithm>
+
+namespace ft {
+
+// only ft::pair rows are supported, see the specialization below
+template < class T, class Alloc = std::allocator<T> >
+class soa_vector;
+
+/**
+    * ------------------------------------------------------------- *
+    * ---------------------- FT::SOA_VECTOR ----------------------- *
+    *
+    * Structure of arrays storage for ft::pair<T1, T2>: all the firsts
+    * live in one ft::vector<T1>, all the seconds in another. A scan of
+    * one field only pulls that field through the cache, and the
+    * column is a plain array the SIMD algorithms run on:
+    *
+    *     ft::soa_vector<ft::pair<int, double> > table;
+    *     ft::count(table.firsts().begin(), table.firsts().end(), 42);
+    *
+    * Rows are reached through ft::soa_reference, a proxy holding a
+    * reference into each column (it->first, it->second work, and it
+    * converts to and from ft::pair). Every modifier changes both
+    * columns, they always have the same size, even when a copy or an
+    * allocation throws: push_back and resize take the new rows back,
+    * insert and erase, which leave the shifted rows of a column half
+    * moved, drop the rows from the insert or erase point on. Fields of
+    * type bool are not supported: their column would be the
+    * bit-packed vector.
+    *
+    * - Coplien form: constructor, destructor, operator=
+    * - Iterators: begin, end
+    * - Columns: firsts, seconds
+    * - Capacity: size, max_size, resize, capacity, empty, reserve
+    * - Element access: operator[], at, front, back
+    * - Modifiers: push_back, pop_back, insert, erase, swap, clear
+    * - Non-member function overloads: relational operators, swap
+    * ------------------------------------------------------------- *
+    */
+template < class T1, class T2, class Alloc >
+class soa_vector<ft::pair<T1, T2>, Alloc>
+{
+public:
+    typedef ft::pair<T1, T2> value_type;
+    typedef Alloc allocator_type;
+    typedef ft::vector<T1, typename Alloc::template rebind<T1>::other> first_column;
+    typedef ft::vector<T2, typename Alloc::template rebind<T2>::other> second_column;
+    typedef ft::soa_reference<T1, T2, false>    reference;
+    typedef ft::soa_reference<T1, T2, true>     const_reference;
+    typedef ft::soa_iterator<T1, T2, false>     iterator;
+    typedef ft::soa_iterator<T1, T2, true>      const_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    explicit soa_vector(const allocator_type& alloc = allocator_type()) : _firsts(alloc), _seconds(alloc) {}
+
+    explicit soa_vector(size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type())
+        : _firsts(n, val.first, alloc), _seconds(n, val.second, alloc) {}
+
+    template <class InputIterator>
+    soa_vector(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(), typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0)
+        : _firsts(alloc), _seconds(alloc)
+    {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    const_iterator  begin() const   { return const_iterator(_firsts.begin().getPtr(), _seconds.begin().getPtr()); }
+    iterator        begin()         { return iterator(_firsts.begin().getPtr(), _seconds.begin().getPtr()); }
+    const_iterator  end() const     { return begin() + size(); }
+    iterator        end()           { return begin() + size(); }
+
+    allocator_type get_allocator() const { return allocator_type(_firsts.get_allocator()); }
+
+    ft::span<T1>        firsts()        { return ft::span<T1>(_firsts.begin().getPtr(), size()); }
+    ft::span<T1, true>  firsts() const  { return ft::span<T1, true>(_firsts.begin().getPtr(), size()); }
+    ft::span<T2>        seconds()       { return ft::span<T2>(_seconds.begin().getPtr(), size()); }
+    ft::span<T2, true>  seconds() const { return ft::span<T2, true>(_seconds.begin().getPtr(), size()); }
+
+    size_type size() const { return _firsts.size(); }
+
+    size_type max_size() const { return std::min(_firsts.max_size(), _seconds.max_size()); }
+
+    void resize (size_type n, value_type val = value_type())
+    {
+        size_type old = size();
+        try
+        {
+            _firsts.resize(n, val.first);
+            _seconds.resize(n, val.second);
+        }
+        catch (...)
+        {
+            truncate(old);
+            throw;
+        }
+    }
+
+    size_type capacity() const { return std::min(_firsts.capacity(), _seconds.capacity()); }
+
+    bool empty() const { return _firsts.empty(); }
+
+    void reserve (size_type n)
+    {
+        _firsts.reserve(n);
+        _seconds.reserve(n);
+    }
+
+    reference operator[] (size_type n) { return reference(_firsts[n], _seconds[n]); }
+
+    const_reference operator[] (size_type n) const { return const_reference(_firsts[n], _seconds[n]); }
+
+    reference at (size_type n) {
+        if (n >= size())
+            throw std::out_of_range("soa_vector");
+        return (*this)[n];
+    }
+
+    const_reference at (size_type n) const {
+        if (n >= size())
+            throw std::out_of_range("soa_vector");
+        return (*this)[n];
+    }
+
+    reference front() { return (*this)[0]; }
+
+    const_reference front() const { return (*this)[0]; }
+
+    reference back() { return (*this)[size() - 1]; }
+
+    const_reference back() const { return (*this)[size() - 1]; }
+
+    // the second column throws with its size unchanged: the first one pops the row back
+    void push_back (const value_type& val) {
+        _firsts.push_back(val.first);
+        try
+        {
+            _seconds.push_back(val.second);
+        }
+        catch (...)
+        {
+            _firsts.pop_back();
+            throw;
+        }
+    }
+
+    void pop_back() {
+        _firsts.pop_back();
+        _seconds.pop_back();
+    }
+
+    iterator insert (iterator position, const value_type& val) {
+        size_type index = position - begin();
+        try
+        {
+            _firsts.insert(_firsts.begin() + index, val.first);
+            _seconds.insert(_seconds.begin() + index, val.second);
+        }
+        catch (...)
+        {
+            truncate(index);
+            throw;
+        }
+        return begin() + index;
+    }
+
+    iterator erase (iterator position) {
+        return erase(position, position + 1);
+    }
+
+    iterator erase (iterator first, iterator last) {
+        size_type index = first - begin();
+        size_type count = last - first;
+        try
+        {
+            _firsts.erase(_firsts.begin() + index, _firsts.begin() + index + count);
+            _seconds.erase(_seconds.begin() + index, _seconds.begin() + index + count);
+        }
+        catch (...)
+        {
+            truncate(index);
+            throw;
+        }
+        return begin() + index;
+    }
+
+    void clear() {
+        _firsts.clear();
+        _seconds.clear();
+    }
+
+    void swap (soa_vector& x) {
+        _firsts.swap(x._firsts);
+        _seconds.swap(x._seconds);
+    }
+
+    friend bool operator== (const soa_vector& lhs, const soa_vector& rhs) {
+        return lhs._firsts == rhs._firsts && lhs._seconds == rhs._seconds;
+    }
+
+    friend bool operator!= (const soa_vector& lhs, const soa_vector& rhs) { return (!(lhs == rhs)); }
+
+    // row order, as ft::vector<ft::pair> would compare
+    friend bool operator<  (const soa_vector& lhs, const soa_vector& rhs) {
+        size_type n = std::min(lhs.size(), rhs.size());
+        for (size_type i = 0; i < n; ++i)
+        {
+            value_type l = lhs[i];
+            value_type r = rhs[i];
+            if (l < r)
+                return true;
+            if (r < l)
+                return false;
+        }
+        return lhs.size() < rhs.size();
+    }
+
+    friend bool operator<= (const soa_vector& lhs, const soa_vector& rhs) { return (!(rhs < lhs)); }
+
+    friend bool operator>  (const soa_vector& lhs, const soa_vector& rhs) { return (rhs < lhs); }
+
+    friend bool operator>= (const soa_vector& lhs, const soa_vector& rhs) { return (!(lhs < rhs)); }
+
+private:
+    first_column _firsts;
+    second_column _seconds;
+
+    // pops only: cannot throw, safe in a catch block
+    void truncate(size_type n) {
+        while (_firsts.size() > n)
+            _firsts.pop_back();
+        while (_seconds.size() > n)
+            _seconds.pop_back();
+    }
+};
+
+template <class T, class Alloc>
+  void swap (soa_vector<T,Alloc>& x, soa_vector<T,Alloc>& y) { x.swap(y); }
+}
+
+#endif
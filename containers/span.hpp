@@ -0,0 +1,59 @@
+#ifndef SPAN_H
+#define SPAN_H
+
+#include <cstddef>
+#include <stdexcept>
+#include "../iterator/iterator.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * -------------------------- FT::SPAN ------------------------- *
+    *
+    * Non-owning view over size() contiguous T, read only when B is
+    * true. Its iterators are the vector ones, so ft::find, ft::count
+    * and ft::equal take their SIMD paths on it.
+    * ------------------------------------------------------------- *
+    */
+template <class T, bool B = false>
+class span
+{
+public:
+    typedef T value_type;
+    typedef typename ft::chooseConst<B, T&, const T&>::type reference;
+    typedef typename ft::chooseConst<B, T*, const T*>::type pointer;
+    typedef typename ft::iterator<std::random_access_iterator_tag, T, B> iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    span() : _data(NULL), _size(0) {}
+    span(pointer data, size_type size) : _data(data), _size(size) {}
+
+    iterator begin() const { return iterator(_data); }
+    iterator end() const { return iterator(_data + _size); }
+
+    pointer data() const { return _data; }
+    size_type size() const { return _size; }
+    bool empty() const { return !_size; }
+
+    reference operator[] (size_type n) const { return _data[n]; }
+
+    reference at (size_type n) const {
+        if (n >= _size)
+            throw std::out_of_range("span");
+        return _data[n];
+    }
+
+    reference front() const { return _data[0]; }
+    reference back() const { return _data[_size - 1]; }
+
+    span subspan(size_type offset, size_type count) const { return span(_data + offset, count); }
+
+private:
+    pointer _data;
+    size_type _size;
+};
+
+}
+
+#endif
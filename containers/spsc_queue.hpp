@@ -0,0 +1,159 @@
+#ifndef SPSC_QUEUE_H
+#define SPSC_QUEUE_H
+
+#include <memory>
+#include "../concurrency/atomic.hpp"
+#include "../utility.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ----------------------- FT::SPSC_QUEUE ---------------------- *
+    *
+    * Bounded FIFO ring of N elements between exactly one producer
+    * thread and one consumer thread, without locks: the producer only
+    * writes the tail, the consumer only writes the head, each one
+    * publishing with a release store.
+    *
+    * The two counters live on separate cache lines, and each side keeps
+    * a private copy of the other side's counter, refreshed only when
+    * the ring looks full (producer) or empty (consumer): most calls
+    * touch no line the other thread writes. N is best a power of two,
+    * the modulo then compiles to a mask.
+    *
+    * try_push, try_pop:    One element, false when full / empty
+    * push, pop:            Wait, spinning then yielding, until there is
+    *                       room / an element
+    * try_push_batch:       As many elements of a range as fit, published
+    *                       with one store; returns how many
+    * try_pop_batch:        Up to max elements, released with one store
+    * size, empty:          Snapshot, exact only from the producer or
+    *                       the consumer thread, in [0, N] from any other
+    * ------------------------------------------------------------- *
+    */
+template < class T, size_t N, class Alloc = std::allocator<T> >
+class spsc_queue
+{
+public:
+    typedef T value_type;
+    typedef Alloc allocator_type;
+    typedef size_t size_type;
+
+    explicit spsc_queue(const allocator_type& alloc = allocator_type())
+        : _ring(NULL), _alloc(alloc)
+    {
+        _ring = _alloc.allocate(N);
+    }
+
+    ~spsc_queue() {
+        for (size_type i = _consumer.own; i != _producer.own; ++i)
+            _alloc.destroy(&_ring[i % N]);
+        _alloc.deallocate(_ring, N);
+    }
+
+    size_type capacity() const { return N; }
+
+    // head first, as mpmc_queue: the tail only grows, so it cannot be read behind the
+    // head. Pushes after pops between the two loads can still count more than N: clamped
+    size_type size() const {
+        size_type head = atomic_load(&_consumer.own);
+        size_type tail = atomic_load(&_producer.own);
+        return tail - head < N ? tail - head : N;
+    }
+
+    bool empty() const { return !size(); }
+
+    allocator_type get_allocator() const { return _alloc; }
+
+    // producer side
+
+    bool try_push(const value_type& val) {
+        size_type tail = _producer.own;
+        if (tail - _producer.other == N && tail - (_producer.other = atomic_load(&_consumer.own)) == N)
+            return false;
+        _alloc.construct(&_ring[tail % N], val);
+        atomic_store(&_producer.own, tail + 1);
+        return true;
+    }
+
+    void push(const value_type& val) {
+        spin_backoff backoff;
+        while (!try_push(val))
+            backoff.pause();
+    }
+
+    template <class InputIterator>
+    size_type try_push_batch(InputIterator first, InputIterator last) {
+        size_type tail = _producer.own;
+        size_type room = N - (tail - _producer.other);
+        if (!room)
+            room = N - (tail - (_producer.other = atomic_load(&_consumer.own)));
+        size_type count = 0;
+        for (; count < room && first != last; ++first, ++count)
+            _alloc.construct(&_ring[(tail + count) % N], *first);
+        if (count)
+            atomic_store(&_producer.own, tail + count);
+        return count;
+    }
+
+    // consumer side
+
+    bool try_pop(value_type& out) {
+        size_type head = _consumer.own;
+        if (head == _consumer.other && head == (_consumer.other = atomic_load(&_producer.own)))
+            return false;
+        T* slot = &_ring[head % N];
+        out = *slot;
+        _alloc.destroy(slot);
+        atomic_store(&_consumer.own, head + 1);
+        return true;
+    }
+
+    void pop(value_type& out) {
+        spin_backoff backoff;
+        while (!try_pop(out))
+            backoff.pause();
+    }
+
+    template <class OutputIterator>
+    size_type try_pop_batch(OutputIterator out, size_type max) {
+        size_type head = _consumer.own;
+        size_type ready = _consumer.other - head;
+        if (!ready)
+            ready = (_consumer.other = atomic_load(&_producer.own)) - head;
+        size_type count = ready < max ? ready : max;
+        for (size_type i = 0; i < count; ++i)
+        {
+            T* slot = &_ring[(head + i) % N];
+            *out++ = *slot;
+            _alloc.destroy(slot);
+        }
+        if (count)
+            atomic_store(&_consumer.own, head + count);
+        return count;
+    }
+
+private:
+    // the counter one side writes and its copy of the other side's, alone on their cache line
+    struct side {
+        char front[CACHE_LINE];
+        size_type own;
+        size_type other;
+        char back[CACHE_LINE - 2 * sizeof(size_type)];
+
+        side() : own(0), other(0) {}
+    };
+
+    T* _ring;
+    allocator_type _alloc;
+    // counters only grow; the slot of counter i is i % N
+    side _producer;
+    side _consumer;
+
+    spsc_queue(const spsc_queue&);
+    spsc_queue& operator=(const spsc_queue&);
+};
+
+}
+
+#endif
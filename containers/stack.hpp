@@ -6,6 +6,8 @@
 #include "../iterator/list_iterator.hpp"
 #include "../utility.hpp"
 #include "vector.hpp"
+#include "deque.hpp"
+#include "../memory/trace.hpp"
 #include <cmath>
 #include <memory>
 #include <cstdio>
@@ -20,13 +22,14 @@ class stack
 public:
     typedef T 			value_type;
     typedef Container	container_type;
+    typedef typename container_type::reference			reference;
+    typedef typename container_type::const_reference	const_reference;
     typedef ptrdiff_t	size_type;
 
 
 
-    explicit stack (const container_type& ctnr = container_type())
-    {
-    	c = ctnr;
+    explicit stack (const container_type& ctnr = container_type()) : c(ctnr) {
+        FT_TRACE_EVENT(ATTACH, this, reinterpret_cast<size_t>(&c), 0, 0);
     }
 
     ~stack () {}
@@ -51,12 +54,12 @@ public:
     	return c.size();
     }
 
-     value_type& top()
+     reference top()
      {
      	return c.back();
      }
 
-	const value_type& top() const
+	const_reference top() const
 	{
 		return c.back();
 	}
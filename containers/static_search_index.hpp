@@ -0,0 +1,199 @@
+#ifndef STATIC_SEARCH_INDEX_H
+#define STATIC_SEARCH_INDEX_H
+
+#include "vector.hpp"
+#include "../algorithm/simd.hpp"
+#include "../utility.hpp"
+#include <memory>
+#include <algorithm>
+
+#if defined(__GNUC__)
+# define FT_PREFETCH(addr) __builtin_prefetch(addr)
+#else
+# define FT_PREFETCH(addr) ((void)(addr))
+#endif
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------ FT::STATIC_SEARCH_INDEX ------------------ *
+    *
+    * Read-only sorted key set laid out in Eytzinger (breadth first)
+    * order: the children of slot k are 2k and 2k + 1, so the first
+    * levels of every search share a few cache lines and the next
+    * levels of a search sit at k * 2^j, where they can be prefetched
+    * before they are needed. The descent has no branch to mispredict:
+    * k = 2k + (tree[k] < key).
+    *
+    * rank:         Number of keys less than key, i.e. the lower_bound
+    *               position in the sorted input
+    * lower_bound:  Pointer to the first key not less than key, NULL if none
+    * contains:     Test whether key is in the set
+    *
+    * rank and contains also come in batches: the descents of
+    * BATCH keys are interleaved level by level so their cache misses
+    * overlap instead of queueing one after the other.
+    *
+    * Built once from a sorted ft::vector (or any sorted range) and
+    * never modified; duplicates are allowed.
+    * ------------------------------------------------------------- *
+    */
+template < class T, class Compare = ft::less<T>, class Alloc = std::allocator<T> >
+class static_search_index
+{
+public:
+    typedef T value_type;
+    typedef Compare key_compare;
+    typedef Alloc allocator_type;
+    typedef const T* const_pointer;
+    typedef size_t size_type;
+
+    static const size_type BATCH = 16;
+
+    explicit static_search_index(const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : _tree(alloc), _ranks(alloc), _comp(comp), _size(0), _depth(0) {}
+
+    template <class A>
+    explicit static_search_index(const ft::vector<T, A>& sorted, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type())
+        : _tree(alloc), _ranks(alloc), _comp(comp), _size(0), _depth(0)
+    {
+        build(sorted.begin(), sorted.end());
+    }
+
+    template <class RandomIt>
+    static_search_index(RandomIt first, RandomIt last, const key_compare& comp = key_compare(), const allocator_type& alloc = allocator_type(),
+                        typename ft::enable_if<!ft::is_integral<RandomIt>::value , int>::type* = 0)
+        : _tree(alloc), _ranks(alloc), _comp(comp), _size(0), _depth(0)
+    {
+        build(first, last);
+    }
+
+    size_type size() const { return _size; }
+    bool empty() const { return !_size; }
+
+    size_type rank(const value_type& key) const {
+        size_type k = search(key);
+        return k ? _ranks[k] : _size;
+    }
+
+    const_pointer lower_bound(const value_type& key) const {
+        size_type k = search(key);
+        return k ? &_tree[k] : NULL;
+    }
+
+    bool contains(const value_type& key) const {
+        size_type k = search(key);
+        return k && !_comp(key, _tree[k]);
+    }
+
+    // out[i] = rank(keys[i])
+    void rank(const value_type* keys, size_type count, size_type* out) const {
+        size_type slots[BATCH];
+        for (size_type i = 0; i < count; i += BATCH)
+        {
+            size_type n = std::min(BATCH, count - i);
+            searchBatch(keys + i, n, slots);
+            for (size_type j = 0; j < n; ++j)
+                out[i + j] = slots[j] ? _ranks[slots[j]] : _size;
+        }
+    }
+
+    // out[i] = contains(keys[i])
+    void contains(const value_type* keys, size_type count, bool* out) const {
+        size_type slots[BATCH];
+        for (size_type i = 0; i < count; i += BATCH)
+        {
+            size_type n = std::min(BATCH, count - i);
+            searchBatch(keys + i, n, slots);
+            for (size_type j = 0; j < n; ++j)
+                out[i + j] = slots[j] && !_comp(keys[i + j], _tree[slots[j]]);
+        }
+    }
+
+private:
+    typedef ft::vector<size_type, typename Alloc::template rebind<size_type>::other> rank_vector;
+
+    // descendants of slot k that share a cache line start at slot k * PREFETCH_STRIDE
+    static const size_type PREFETCH_STRIDE = sizeof(T) < 64 ? 64 / sizeof(T) : 1;
+
+    // 1-based: slot 0 is never a node, a search ending there found no lower bound
+    ft::vector<T, Alloc> _tree;
+    rank_vector _ranks;
+    key_compare _comp;
+    size_type _size;
+    size_type _depth;
+
+    template <class RandomIt>
+    void build(RandomIt first, RandomIt last) {
+        _size = last - first;
+        if (!_size)
+            return;
+        _tree.assign(_size + 1, *first);
+        _ranks.assign(_size + 1, 0);
+        size_type next = 0;
+        fill(first, 1, next);
+        for (size_type k = _size; k; k >>= 1)
+            ++_depth;
+    }
+
+    // in-order walk of the implicit tree hands out the sorted keys
+    template <class RandomIt>
+    void fill(RandomIt sorted, size_type k, size_type& next) {
+        if (k > _size)
+            return;
+        fill(sorted, 2 * k, next);
+        _tree[k] = sorted[next];
+        _ranks[k] = next++;
+        fill(sorted, 2 * k + 1, next);
+    }
+
+    // computed as an integer: the line may lie past the end, prefetching it is harmless
+    void prefetch(size_type k) const {
+        FT_PREFETCH(reinterpret_cast<const char*>(reinterpret_cast<size_t>(&_tree[0]) + k * PREFETCH_STRIDE * sizeof(T)));
+    }
+
+    // the right turns taken after the last left turn are undone: what
+    // remains is the slot of the lower bound, 0 if every key is less
+    static size_type undoRightTurns(size_type k) {
+        return k >> (simd::countTrailingZeros(~static_cast<unsigned long long>(k)) + 1);
+    }
+
+    size_type search(const value_type& key) const {
+        size_type k = 1;
+        while (k <= _size)
+        {
+            prefetch(k);
+            k = 2 * k + _comp(_tree[k], key);
+        }
+        return undoRightTurns(k);
+    }
+
+    void searchBatch(const value_type* keys, size_type n, size_type* slots) const {
+        for (size_type j = 0; j < n; ++j)
+            slots[j] = 1;
+        for (size_type level = 0; level < _depth; ++level)
+        {
+            for (size_type j = 0; j < n; ++j)
+            {
+                size_type k = slots[j];
+                if (k <= _size)
+                {
+                    prefetch(k);
+                    slots[j] = 2 * k + _comp(_tree[k], keys[j]);
+                }
+            }
+        }
+        for (size_type j = 0; j < n; ++j)
+            slots[j] = undoRightTurns(slots[j]);
+    }
+};
+
+template <class T, class Compare, class Alloc>
+const typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::BATCH;
+
+template <class T, class Compare, class Alloc>
+const typename static_search_index<T, Compare, Alloc>::size_type static_search_index<T, Compare, Alloc>::PREFETCH_STRIDE;
+
+}
+
+#endif
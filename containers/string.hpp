@@ -0,0 +1,721 @@
+#ifndef STRING_H
+#define STRING_H
+
+#include <cstddef>
+#include <cstring>
+#include <memory>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <limits>
+#include "../iterator/iterator.hpp"
+#include "../iterator/reverse_iterator.hpp"
+#include "../utility.hpp"
+#include "../algorithm/simd.hpp"
+
+namespace ft {
+
+// characters order as unsigned values, like std::char_traits<char>: "\xe9" > "z"
+template <class CharT>
+struct char_order { static bool lt(CharT a, CharT b) { return a < b; } };
+
+template <>
+struct char_order<char> {
+    static bool lt(char a, char b) { return static_cast<unsigned char>(a) < static_cast<unsigned char>(b); }
+};
+
+// 64 bits hash of n bytes, read 8 at a time, murmur3 finalizer
+inline size_t hash_bytes(const void* data, size_t n)
+{
+    const unsigned char* p = static_cast<const unsigned char*>(data);
+    unsigned long long h = 0x9E3779B97F4A7C15ULL ^ (n * 0xFF51AFD7ED558CCDULL);
+    for (; n >= 8; n -= 8, p += 8)
+    {
+        unsigned long long w;
+        std::memcpy(&w, p, 8);
+        h = (h ^ w) * 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 29;
+    }
+    if (n)
+    {
+        unsigned long long w = 0;
+        std::memcpy(&w, p, n);
+        h = (h ^ w) * 0xC4CEB9FE1A85EC53ULL;
+        h ^= h >> 29;
+    }
+    h ^= h >> 33;
+    h *= 0xFF51AFD7ED558CCDULL;
+    h ^= h >> 33;
+    h *= 0xC4CEB9FE1A85EC53ULL;
+    h ^= h >> 33;
+    return static_cast<size_t>(h);
+}
+
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------ FT::STRING ------------------------- *
+    *
+    * basic_string of trivial characters in 3 words, the same on every
+    * standard library. Up to 23 chars (sizeof(void*) * 3 - 1 bytes)
+    * live inline, longer strings on the heap:
+    *
+    *   small:  | chars ...                    | 23 - size |
+    *   heap:   | pointer | size | capacity with the top bit set |
+    *
+    * The last byte tells the two apart. A full small string's size
+    * byte is 0 and doubles as its terminator, so 23 chars fit.
+    *
+    * - Copies of small strings are a 24 bytes copy, no allocation.
+    * - swap exchanges the 3 words, and ft::vector relocates strings
+    *   with memcpy when it grows (is_trivially_relocatable): the C++98
+    *   stand-ins for moves.
+    * - find runs on ft::simd::search (AVX2 on first and last chars),
+    *   compare on memcmp for 1 byte chars, simd::mismatch otherwise.
+    * - hash() hashes the characters; basic_hashed_string keeps the
+    *   hash next to the string so map keys compare hashes first.
+    *
+    * Same members as the C++98 std::string minus the traits, the
+    * find_*_not_of and the replace overloads taking iterators; str()
+    * and the std::basic_string constructor convert both ways.
+    * ------------------------------------------------------------- *
+    */
+template <class CharT, class Alloc = std::allocator<CharT> >
+class basic_string
+{
+public:
+    typedef CharT value_type;
+    typedef Alloc allocator_type;
+    typedef CharT& reference;
+    typedef const CharT& const_reference;
+    typedef CharT* pointer;
+    typedef const CharT* const_pointer;
+    typedef typename ft::iterator<std::random_access_iterator_tag, CharT, false> iterator;
+    typedef typename ft::iterator<std::random_access_iterator_tag, CharT, true> const_iterator;
+    typedef typename ft::reverse_iterator<std::random_access_iterator_tag, CharT, false> reverse_iterator;
+    typedef typename ft::reverse_iterator<std::random_access_iterator_tag, CharT, true> const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+
+    static const size_type npos = static_cast<size_type>(-1);
+
+private:
+    struct heap {
+        CharT* ptr;
+        size_type size;
+        size_type cap;      // encodeCapacity
+    };
+
+    enum { SSO_CAPACITY = sizeof(heap) / sizeof(CharT) - 1 };
+
+    union rep {
+        heap h;
+        CharT buf[SSO_CAPACITY + 1];    // buf[SSO_CAPACITY] is SSO_CAPACITY - size
+        unsigned char raw[sizeof(heap)];
+    };
+
+    // the allocator as an empty base: an std::allocator takes no room
+    struct storage : Alloc {
+        rep r;
+        explicit storage(const Alloc& alloc) : Alloc(alloc) {}
+    };
+
+    storage _s;
+
+public:
+    explicit basic_string(const allocator_type& alloc = allocator_type()) : _s(alloc) { setSmall(0); }
+
+    basic_string(const basic_string& str) : _s(str.get_allocator()) {
+        if (str.isSmall())
+            _s.r = str._s.r;
+        else
+            init(str.data(), str.size());
+    }
+
+    basic_string(const basic_string& str, size_type pos, size_type len = npos, const allocator_type& alloc = allocator_type()) : _s(alloc) {
+        if (pos > str.size())
+            throw std::out_of_range("basic_string");
+        init(str.data() + pos, clamp(len, str.size() - pos));
+    }
+
+    basic_string(const CharT* s, const allocator_type& alloc = allocator_type()) : _s(alloc) { init(s, length(s)); }
+
+    basic_string(const CharT* s, size_type n, const allocator_type& alloc = allocator_type()) : _s(alloc) { init(s, n); }
+
+    basic_string(size_type n, CharT c, const allocator_type& alloc = allocator_type()) : _s(alloc) {
+        setSmall(0);
+        append(n, c);
+    }
+
+    template <class InputIterator>
+    basic_string(InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(),
+        typename ft::enable_if<!ft::is_integral<InputIterator>::value, int>::type* = 0) : _s(alloc) {
+        setSmall(0);
+        append(first, last);
+    }
+
+    basic_string(const std::basic_string<CharT>& str, const allocator_type& alloc = allocator_type()) : _s(alloc) {
+        init(str.data(), str.size());
+    }
+
+    ~basic_string() { release(); }
+
+    basic_string& operator=(const basic_string& str) {
+        if (this == &str)
+            return *this;
+        if (str.isSmall() && isSmall())
+            _s.r = str._s.r;
+        else
+            assign(str.data(), str.size());
+        return *this;
+    }
+    basic_string& operator=(const CharT* s) { return assign(s); }
+    basic_string& operator=(CharT c) { return assign(1, c); }
+
+    iterator begin() { return iterator(ptr()); }
+    const_iterator begin() const { return const_iterator(data()); }
+    iterator end() { return iterator(ptr() + size()); }
+    const_iterator end() const { return const_iterator(data() + size()); }
+    reverse_iterator rbegin() { return reverse_iterator(end()); }
+    const_reverse_iterator rbegin() const { return const_reverse_iterator(end()); }
+    reverse_iterator rend() { return reverse_iterator(begin()); }
+    const_reverse_iterator rend() const { return const_reverse_iterator(begin()); }
+
+    size_type size() const {
+        return isSmall() ? SSO_CAPACITY - static_cast<size_type>(_s.r.buf[SSO_CAPACITY]) : _s.r.h.size;
+    }
+    size_type length() const { return size(); }
+    size_type max_size() const { return (std::numeric_limits<size_type>::max() >> 8) / sizeof(CharT); }
+    size_type capacity() const { return isSmall() ? static_cast<size_type>(SSO_CAPACITY) : decodeCapacity(_s.r.h.cap); }
+    bool empty() const { return !size(); }
+
+    void resize(size_type n, CharT c = CharT()) {
+        size_type sz = size();
+        if (n <= sz)
+            setSize(n);
+        else
+            append(n - sz, c);
+    }
+
+    void reserve(size_type n = 0) {
+        if (n > capacity())
+            reallocate(n);
+    }
+
+    // the storage is kept
+    void clear() { setSize(0); }
+
+    reference operator[](size_type n) { return ptr()[n]; }
+    const_reference operator[](size_type n) const { return data()[n]; }
+
+    reference at(size_type n) {
+        if (n >= size())
+            throw std::out_of_range("basic_string");
+        return ptr()[n];
+    }
+    const_reference at(size_type n) const {
+        if (n >= size())
+            throw std::out_of_range("basic_string");
+        return data()[n];
+    }
+
+    basic_string& operator+=(const basic_string& str) { return append(str.data(), str.size()); }
+    basic_string& operator+=(const CharT* s) { return append(s); }
+    basic_string& operator+=(CharT c) {
+        push_back(c);
+        return *this;
+    }
+
+    basic_string& append(const basic_string& str) { return append(str.data(), str.size()); }
+    basic_string& append(const basic_string& str, size_type pos, size_type len) {
+        if (pos > str.size())
+            throw std::out_of_range("basic_string");
+        return append(str.data() + pos, clamp(len, str.size() - pos));
+    }
+    basic_string& append(const CharT* s) { return append(s, length(s)); }
+    basic_string& append(const CharT* s, size_type n) {
+        size_type sz = size();
+        // s may be in this string: it is not moved and ends before the chars written
+        if (n <= capacity() - sz)
+        {
+            if (n)
+                std::memcpy(ptr() + sz, s, n * sizeof(CharT));
+            setSize(sz + n);
+            return *this;
+        }
+        return replace(sz, 0, s, n);
+    }
+    basic_string& append(size_type n, CharT c) { return replace(size(), 0, n, c); }
+
+    template <class InputIterator>
+    typename ft::enable_if<!ft::is_integral<InputIterator>::value, basic_string&>::type
+        append(InputIterator first, InputIterator last) {
+        for (; first != last; ++first)
+            push_back(*first);
+        return *this;
+    }
+
+    void push_back(CharT c) {
+        size_type sz = size();
+        if (sz < capacity())
+        {
+            ptr()[sz] = c;
+            setSize(sz + 1);
+        }
+        else
+            *makeRoom(sz, 0, 1) = c;
+    }
+
+    basic_string& assign(const basic_string& str) { return *this = str; }
+    basic_string& assign(const basic_string& str, size_type pos, size_type len) {
+        if (pos > str.size())
+            throw std::out_of_range("basic_string");
+        return assign(str.data() + pos, clamp(len, str.size() - pos));
+    }
+    basic_string& assign(const CharT* s) { return assign(s, length(s)); }
+    basic_string& assign(const CharT* s, size_type n) { return replace(0, size(), s, n); }
+    basic_string& assign(size_type n, CharT c) { return replace(0, size(), n, c); }
+
+    template <class InputIterator>
+    typename ft::enable_if<!ft::is_integral<InputIterator>::value, basic_string&>::type
+        assign(InputIterator first, InputIterator last) {
+        basic_string tmp(first, last, get_allocator());
+        swap(tmp);
+        return *this;
+    }
+
+    basic_string& insert(size_type pos, const basic_string& str) { return replace(pos, 0, str.data(), str.size()); }
+    basic_string& insert(size_type pos, const CharT* s) { return replace(pos, 0, s, length(s)); }
+    basic_string& insert(size_type pos, const CharT* s, size_type n) { return replace(pos, 0, s, n); }
+    basic_string& insert(size_type pos, size_type n, CharT c) { return replace(pos, 0, n, c); }
+    iterator insert(iterator p, CharT c) {
+        size_type pos = p - begin();
+        replace(pos, 0, 1, c);
+        return begin() + pos;
+    }
+    void insert(iterator p, size_type n, CharT c) { replace(p - begin(), 0, n, c); }
+
+    basic_string& erase(size_type pos = 0, size_type len = npos) { return replace(pos, len, static_cast<const CharT*>(NULL), 0); }
+    iterator erase(iterator p) {
+        size_type pos = p - begin();
+        erase(pos, 1);
+        return begin() + pos;
+    }
+    iterator erase(iterator first, iterator last) {
+        size_type pos = first - begin();
+        erase(pos, last - first);
+        return begin() + pos;
+    }
+
+    basic_string& replace(size_type pos, size_type len, const basic_string& str) { return replace(pos, len, str.data(), str.size()); }
+    basic_string& replace(size_type pos, size_type len, const CharT* s) { return replace(pos, len, s, length(s)); }
+    basic_string& replace(size_type pos, size_type len, const CharT* s, size_type n) {
+        // s inside this string would move under the copy
+        if (n && s >= data() && s < data() + size())
+        {
+            basic_string tmp(s, n, get_allocator());
+            return replace(pos, len, tmp.data(), n);
+        }
+        if (n)
+            std::memcpy(makeRoom(pos, len, n), s, n * sizeof(CharT));
+        else
+            makeRoom(pos, len, 0);
+        return *this;
+    }
+    basic_string& replace(size_type pos, size_type len, size_type n, CharT c) {
+        CharT* p = makeRoom(pos, len, n);
+        for (size_type i = 0; i < n; ++i)
+            p[i] = c;
+        return *this;
+    }
+
+    void swap(basic_string& str) {
+        rep tmp = _s.r;
+        _s.r = str._s.r;
+        str._s.r = tmp;
+    }
+
+    const CharT* c_str() const { return data(); }
+    const CharT* data() const { return isSmall() ? _s.r.buf : _s.r.h.ptr; }
+    allocator_type get_allocator() const { return static_cast<const Alloc&>(_s); }
+
+    size_type copy(CharT* s, size_type len, size_type pos = 0) const {
+        if (pos > size())
+            throw std::out_of_range("basic_string");
+        len = clamp(len, size() - pos);
+        if (len)
+            std::memcpy(s, data() + pos, len * sizeof(CharT));
+        return len;
+    }
+
+    size_type find(const basic_string& str, size_type pos = 0) const { return find(str.data(), pos, str.size()); }
+    size_type find(const CharT* s, size_type pos = 0) const { return find(s, pos, length(s)); }
+    size_type find(const CharT* s, size_type pos, size_type n) const {
+        size_type sz = size();
+        if (pos > sz || n > sz - pos)
+            return npos;
+        if (!n)
+            return pos;
+        size_type i = ft::simd::search(data() + pos, sz - pos, s, n);
+        return i == sz - pos ? npos : pos + i;
+    }
+    size_type find(CharT c, size_type pos = 0) const {
+        size_type sz = size();
+        if (pos >= sz)
+            return npos;
+        size_type i = ft::simd::find(data() + pos, sz - pos, c);
+        return pos + i == sz ? npos : pos + i;
+    }
+
+    size_type rfind(const basic_string& str, size_type pos = npos) const { return rfind(str.data(), pos, str.size()); }
+    size_type rfind(const CharT* s, size_type pos = npos) const { return rfind(s, pos, length(s)); }
+    size_type rfind(const CharT* s, size_type pos, size_type n) const {
+        size_type sz = size();
+        if (n > sz)
+            return npos;
+        const CharT* p = data();
+        for (size_type at = clamp(pos, sz - n) + 1; at-- > 0; )
+            if (ft::simd::equal(p + at, s, n))
+                return at;
+        return npos;
+    }
+    size_type rfind(CharT c, size_type pos = npos) const {
+        size_type sz = size();
+        if (!sz)
+            return npos;
+        const CharT* p = data();
+        for (size_type at = clamp(pos, sz - 1) + 1; at-- > 0; )
+            if (p[at] == c)
+                return at;
+        return npos;
+    }
+
+    size_type find_first_of(const basic_string& str, size_type pos = 0) const { return find_first_of(str.data(), pos, str.size()); }
+    size_type find_first_of(const CharT* s, size_type pos = 0) const { return find_first_of(s, pos, length(s)); }
+    size_type find_first_of(const CharT* s, size_type pos, size_type n) const {
+        const CharT* p = data();
+        for (size_type sz = size(); pos < sz; ++pos)
+            if (ft::simd::find(s, n, p[pos]) != n)
+                return pos;
+        return npos;
+    }
+    size_type find_first_of(CharT c, size_type pos = 0) const { return find(c, pos); }
+
+    size_type find_last_of(const basic_string& str, size_type pos = npos) const { return find_last_of(str.data(), pos, str.size()); }
+    size_type find_last_of(const CharT* s, size_type pos = npos) const { return find_last_of(s, pos, length(s)); }
+    size_type find_last_of(const CharT* s, size_type pos, size_type n) const {
+        size_type sz = size();
+        if (!sz)
+            return npos;
+        const CharT* p = data();
+        for (size_type at = clamp(pos, sz - 1) + 1; at-- > 0; )
+            if (ft::simd::find(s, n, p[at]) != n)
+                return at;
+        return npos;
+    }
+    size_type find_last_of(CharT c, size_type pos = npos) const { return rfind(c, pos); }
+
+    basic_string substr(size_type pos = 0, size_type len = npos) const { return basic_string(*this, pos, len, get_allocator()); }
+
+    int compare(const basic_string& str) const { return compareChars(data(), size(), str.data(), str.size()); }
+    int compare(size_type pos, size_type len, const basic_string& str) const { return compare(pos, len, str.data(), str.size()); }
+    int compare(size_type pos, size_type len, const basic_string& str, size_type subpos, size_type sublen) const {
+        if (subpos > str.size())
+            throw std::out_of_range("basic_string");
+        return compare(pos, len, str.data() + subpos, clamp(sublen, str.size() - subpos));
+    }
+    int compare(const CharT* s) const { return compareChars(data(), size(), s, length(s)); }
+    int compare(size_type pos, size_type len, const CharT* s) const { return compare(pos, len, s, length(s)); }
+    int compare(size_type pos, size_type len, const CharT* s, size_type n) const {
+        if (pos > size())
+            throw std::out_of_range("basic_string");
+        return compareChars(data() + pos, clamp(len, size() - pos), s, n);
+    }
+
+    // hash of the characters, the same for equal strings
+    size_t hash() const { return hash_bytes(data(), size() * sizeof(CharT)); }
+
+    std::basic_string<CharT> str() const { return std::basic_string<CharT>(data(), size()); }
+
+    static int compareChars(const CharT* a, size_type na, const CharT* b, size_type nb) {
+        size_type n = na < nb ? na : nb;
+        // memcmp orders bytes as unsigned char, as char_order does, and is vectorized at any length
+        if (sizeof(CharT) == 1)
+        {
+            int res = n ? std::memcmp(a, b, n) : 0;
+            if (res)
+                return res < 0 ? -1 : 1;
+        }
+        else
+        {
+            size_type i = n ? ft::simd::mismatch(a, b, n) : 0;
+            if (i != n)
+                return char_order<CharT>::lt(a[i], b[i]) ? -1 : 1;
+        }
+        return na < nb ? -1 : na > nb;
+    }
+
+private:
+    bool isSmall() const { return !(_s.r.raw[sizeof(heap) - 1] & 0x80); }
+
+    CharT* ptr() { return isSmall() ? _s.r.buf : _s.r.h.ptr; }
+    Alloc& alloc() { return _s; }
+
+    // the flag must land in the last byte of the object
+    static size_type encodeCapacity(size_type cap) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return cap << 8 | 0x80;
+#else
+        return cap | ~(~static_cast<size_type>(0) >> 1);
+#endif
+    }
+    static size_type decodeCapacity(size_type stored) {
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+        return stored >> 8;
+#else
+        return stored & ~static_cast<size_type>(0) >> 1;
+#endif
+    }
+
+    static size_type length(const CharT* s) {
+        size_type n = 0;
+        while (s[n] != CharT())
+            ++n;
+        return n;
+    }
+
+    static size_type clamp(size_type len, size_type max) { return len < max ? len : max; }
+
+    void setSmall(size_type n) {
+        _s.r.buf[n] = CharT();
+        _s.r.buf[SSO_CAPACITY] = static_cast<CharT>(SSO_CAPACITY - n);
+    }
+
+    void setSize(size_type n) {
+        if (isSmall())
+            setSmall(n);
+        else
+        {
+            _s.r.h.size = n;
+            _s.r.h.ptr[n] = CharT();
+        }
+    }
+
+    void setHeap(CharT* p, size_type n, size_type cap) {
+        _s.r.h.ptr = p;
+        _s.r.h.size = n;
+        _s.r.h.cap = encodeCapacity(cap);
+        p[n] = CharT();
+    }
+
+    void init(const CharT* s, size_type n) {
+        if (n <= SSO_CAPACITY)
+        {
+            if (n)
+                std::memcpy(_s.r.buf, s, n * sizeof(CharT));
+            setSmall(n);
+            return;
+        }
+        if (n > max_size())
+            throw std::length_error("basic_string");
+        CharT* p = alloc().allocate(n + 1);
+        std::memcpy(p, s, n * sizeof(CharT));
+        setHeap(p, n, n);
+    }
+
+    void release() {
+        if (!isSmall())
+            alloc().deallocate(_s.r.h.ptr, decodeCapacity(_s.r.h.cap) + 1);
+    }
+
+    // exactly cap chars of storage, the content kept
+    void reallocate(size_type cap) {
+        if (cap > max_size())
+            throw std::length_error("basic_string");
+        size_type sz = size();
+        CharT* p = alloc().allocate(cap + 1);
+        std::memcpy(p, data(), sz * sizeof(CharT));
+        release();
+        setHeap(p, sz, cap);
+    }
+
+    // replaces [pos, pos + len) by n chars left for the caller to write, returns where they go
+    CharT* makeRoom(size_type pos, size_type len, size_type n) {
+        size_type sz = size();
+        if (pos > sz)
+            throw std::out_of_range("basic_string");
+        len = clamp(len, sz - pos);
+        size_type tail = sz - pos - len;
+        if (n > max_size() - (sz - len))
+            throw std::length_error("basic_string");
+        size_type newSize = sz - len + n;
+        size_type cap = capacity();
+        if (newSize <= cap)
+        {
+            CharT* p = ptr();
+            if (tail && n != len)
+                std::memmove(p + pos + n, p + pos + len, tail * sizeof(CharT));
+            setSize(newSize);
+            return p + pos;
+        }
+        size_type newCap = newSize < 2 * cap ? 2 * cap : newSize;
+        CharT* p = alloc().allocate(newCap + 1);
+        const CharT* old = data();
+        std::memcpy(p, old, pos * sizeof(CharT));
+        std::memcpy(p + pos + n, old + pos + len, tail * sizeof(CharT));
+        release();
+        setHeap(p, newSize, newCap);
+        return p + pos;
+    }
+};
+
+template <class CharT, class Alloc>
+const typename basic_string<CharT, Alloc>::size_type basic_string<CharT, Alloc>::npos;
+
+// the 3 words move with memcpy: no pointer into the object itself
+template <class CharT, class Alloc>
+struct is_trivially_relocatable<basic_string<CharT, Alloc> > { static const bool value = true; };
+
+template <class CharT, class Alloc>
+void swap(basic_string<CharT, Alloc>& x, basic_string<CharT, Alloc>& y) { x.swap(y); }
+
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) {
+    basic_string<CharT, Alloc> res(lhs);
+    return res.append(rhs);
+}
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) {
+    basic_string<CharT, Alloc> res(lhs);
+    return res.append(rhs);
+}
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) {
+    basic_string<CharT, Alloc> res(lhs, rhs.get_allocator());
+    return res.append(rhs);
+}
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(const basic_string<CharT, Alloc>& lhs, CharT rhs) {
+    basic_string<CharT, Alloc> res(lhs);
+    res.push_back(rhs);
+    return res;
+}
+template <class CharT, class Alloc>
+basic_string<CharT, Alloc> operator+(CharT lhs, const basic_string<CharT, Alloc>& rhs) {
+    basic_string<CharT, Alloc> res(1, lhs, rhs.get_allocator());
+    return res.append(rhs);
+}
+
+template <class CharT, class Alloc>
+bool operator==(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) {
+    return lhs.size() == rhs.size() && ft::simd::equal(lhs.data(), rhs.data(), lhs.size());
+}
+template <class CharT, class Alloc>
+bool operator==(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) { return !lhs.compare(rhs); }
+template <class CharT, class Alloc>
+bool operator==(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) { return !rhs.compare(lhs); }
+
+template <class CharT, class Alloc>
+bool operator!=(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) { return !(lhs == rhs); }
+template <class CharT, class Alloc>
+bool operator!=(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) { return !(lhs == rhs); }
+template <class CharT, class Alloc>
+bool operator!=(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) { return !(lhs == rhs); }
+
+template <class CharT, class Alloc>
+bool operator<(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) { return lhs.compare(rhs) < 0; }
+template <class CharT, class Alloc>
+bool operator<(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) { return lhs.compare(rhs) < 0; }
+template <class CharT, class Alloc>
+bool operator<(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) { return rhs.compare(lhs) > 0; }
+
+template <class CharT, class Alloc>
+bool operator>(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) { return rhs < lhs; }
+template <class CharT, class Alloc>
+bool operator>(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) { return rhs < lhs; }
+template <class CharT, class Alloc>
+bool operator>(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) { return rhs < lhs; }
+
+template <class CharT, class Alloc>
+bool operator<=(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) { return !(rhs < lhs); }
+template <class CharT, class Alloc>
+bool operator<=(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) { return !(rhs < lhs); }
+template <class CharT, class Alloc>
+bool operator<=(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) { return !(rhs < lhs); }
+
+template <class CharT, class Alloc>
+bool operator>=(const basic_string<CharT, Alloc>& lhs, const basic_string<CharT, Alloc>& rhs) { return !(lhs < rhs); }
+template <class CharT, class Alloc>
+bool operator>=(const basic_string<CharT, Alloc>& lhs, const CharT* rhs) { return !(lhs < rhs); }
+template <class CharT, class Alloc>
+bool operator>=(const CharT* lhs, const basic_string<CharT, Alloc>& rhs) { return !(lhs < rhs); }
+
+template <class CharT, class Alloc>
+std::basic_ostream<CharT>& operator<<(std::basic_ostream<CharT>& os, const basic_string<CharT, Alloc>& str) {
+    return os.write(str.data(), str.size());
+}
+
+/**
+    * A basic_string and its hash() computed once, for map keys looked
+    * up more often than built. Keys order by hash, then by characters:
+    * most comparisons are one integer compare, but iterating a
+    * map<hashed_string, T> gives hash order, not alphabetical order.
+    */
+template <class CharT, class Alloc = std::allocator<CharT> >
+class basic_hashed_string
+{
+public:
+    typedef basic_string<CharT, Alloc> string_type;
+
+    basic_hashed_string() : _str(), _hash(_str.hash()) {}
+    basic_hashed_string(const string_type& str) : _str(str), _hash(_str.hash()) {}
+    basic_hashed_string(const CharT* s) : _str(s), _hash(_str.hash()) {}
+    basic_hashed_string(const CharT* s, size_t n) : _str(s, n), _hash(_str.hash()) {}
+
+    const string_type& str() const { return _str; }
+    size_t hash() const { return _hash; }
+
+    void swap(basic_hashed_string& x) {
+        _str.swap(x._str);
+        size_t tmp = _hash;
+        _hash = x._hash;
+        x._hash = tmp;
+    }
+
+private:
+    string_type _str;
+    size_t _hash;
+};
+
+template <class CharT, class Alloc>
+struct is_trivially_relocatable<basic_hashed_string<CharT, Alloc> > { static const bool value = true; };
+
+template <class CharT, class Alloc>
+void swap(basic_hashed_string<CharT, Alloc>& x, basic_hashed_string<CharT, Alloc>& y) { x.swap(y); }
+
+template <class CharT, class Alloc>
+bool operator==(const basic_hashed_string<CharT, Alloc>& lhs, const basic_hashed_string<CharT, Alloc>& rhs) {
+    return lhs.hash() == rhs.hash() && lhs.str() == rhs.str();
+}
+template <class CharT, class Alloc>
+bool operator!=(const basic_hashed_string<CharT, Alloc>& lhs, const basic_hashed_string<CharT, Alloc>& rhs) { return !(lhs == rhs); }
+
+template <class CharT, class Alloc>
+bool operator<(const basic_hashed_string<CharT, Alloc>& lhs, const basic_hashed_string<CharT, Alloc>& rhs) {
+    if (lhs.hash() != rhs.hash())
+        return lhs.hash() < rhs.hash();
+    return lhs.str() < rhs.str();
+}
+template <class CharT, class Alloc>
+bool operator>(const basic_hashed_string<CharT, Alloc>& lhs, const basic_hashed_string<CharT, Alloc>& rhs) { return rhs < lhs; }
+template <class CharT, class Alloc>
+bool operator<=(const basic_hashed_string<CharT, Alloc>& lhs, const basic_hashed_string<CharT, Alloc>& rhs) { return !(rhs < lhs); }
+template <class CharT, class Alloc>
+bool operator>=(const basic_hashed_string<CharT, Alloc>& lhs, const basic_hashed_string<CharT, Alloc>& rhs) { return !(lhs < rhs); }
+
+typedef basic_string<char> string;
+typedef basic_string<wchar_t> wstring;
+typedef basic_hashed_string<char> hashed_string;
+
+}
+
+#endif
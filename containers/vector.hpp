@@ -5,12 +5,16 @@
 #include "../iterator/reverse_iterator.hpp"
 #include "../iterator/list_iterator.hpp"
 #include "../utility.hpp"
+#include "../algorithm/algorithm.hpp"
+#include "../memory/trace.hpp"
 #include <cmath>
+#include <cstring>
 #include <memory>
 #include <cstdio>
 #include <stdexcept>
 #include <iostream>
 #include <limits>
+#include <new>
 
 namespace ft {
 /**
@@ -32,6 +36,7 @@ namespace ft {
     * size:                 Return size ++++++++++++++++
     * max_size:             Return maximum size ++++++++++++++++
     * resize:               Change size +++++++1+++++++++
+    * resize_uninitialized: Change size, default-initializing new elements
     * capacity:             Return size of allocated storage capacity ++++++++++++++++
     * empty:                Test whether vector is empty ++++++++++++++++
     * reserve:              Request a change in capacity ++++++++++++++++
@@ -45,6 +50,7 @@ namespace ft {
     * - Modifiers:
     * assign:               Assign vector content  ++++++++++++++++
     * push_back:            Add element at the end ++++++++++++++++
+    * append_from:          Let a writer fill the reserved tail, then commit it
     * pop_back:             Delete last element ++++++++++++++++
     * insert:               Insert elements  ++++++++++++++++
     * erase:                Erase elements  ++++++++++++++++
@@ -85,17 +91,10 @@ public:
     }
 
     template <class InputIterator>
-    vector (InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(), typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0) :  _alloc(alloc) , _size(0)
+    vector (InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(), typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0) :  _alloc(alloc) , _size(0), _capacity(0)
     {
-        InputIterator tmp(first);
-        while (tmp++ != last)
-            _size++;
-        
-        _capacity = _size;
         _vector = _alloc.allocate(_capacity);
-
-        for (size_type i = 0; first != last; ++first, ++i)
-            _alloc.construct(&_vector[i], *first);
+        rangeAppend(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
     }
 
     vector(const vector& x) : _alloc(x._alloc), _size(x._size), _capacity(x._capacity)
@@ -117,17 +116,17 @@ public:
 
     //assign operator
     vector& operator= (const vector& x) {
+        if (this == &x)
+            return (*this);
+        clear();
         if (x._size > _capacity) {
+            FT_TRACE_EVENT(REALLOCATE, this, _capacity, x._size, 0);
+            _alloc.deallocate(_vector, _capacity);
             _capacity = x._size;
             _vector = _alloc.allocate(_capacity);
         }
-        size_type i = 0;
-        for (const_iterator it = x.begin(); it != x.end(); ++it)
-        {
-            if (i < _size)
-                _alloc.destroy(&_vector[i]);
-            _alloc.construct(&_vector[i++], *it);
-        }
+        for (size_type i = 0; i < x._size; ++i)
+            _alloc.construct(&_vector[i], x._vector[i]);
         _size = x._size;
         return (*this);
     }
@@ -146,25 +145,8 @@ public:
     template <class InputIterator>
     void assign (InputIterator first, InputIterator last, typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0)
     {
-        size_type tmp = _capacity;
         clear();
-        _capacity = tmp;
-        tmp = 0;
-        InputIterator itmp(first);
-        while (itmp++ != last)
-            tmp++;
-        if (tmp > _capacity)
-        {
-            _alloc.deallocate(_vector, _capacity);
-            _vector = _alloc.allocate(tmp);
-            _capacity = tmp;
-        }
-        
-        size_type i = 0;
-        for (; first != last; ++i, ++first)
-            _alloc.construct(&_vector[i], *first);
-        _size = i;
-        
+        rangeAppend(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
     }
 
     void assign (size_type n, const value_type& val)
@@ -174,6 +156,7 @@ public:
         _capacity = tmp;
         if (n > _capacity)
         {
+            FT_TRACE_EVENT(REALLOCATE, this, _capacity, n, 0);
             _alloc.deallocate(_vector, _capacity);
             _vector = _alloc.allocate(n);
             _capacity = n;
@@ -191,7 +174,33 @@ public:
     void push_back (const value_type& val) {
         if (_size >= _capacity)
             reallocVector(!_capacity ? 1 : _capacity * 2);
-        _alloc.construct(&_vector[_size++], val);
+        _alloc.construct(&_vector[_size], val);
+        ++_size;
+    }
+
+    // writer(pointer tail, size_type maxCount) stores up to maxCount
+    // elements at tail and returns how many it wrote; only those are kept.
+    // If writer throws, none are: the size is back to what it was
+    template <class Writer>
+    size_type append_from(size_type maxCount, Writer writer) {
+        size_type oldSize = _size;
+        resize_uninitialized(_size + maxCount);
+        size_type written;
+        try
+        {
+            written = writer(_vector + oldSize, maxCount);
+        }
+        catch (...)
+        {
+            while (_size > oldSize)
+                pop_back();
+            throw;
+        }
+        if (written > maxCount)
+            written = maxCount;
+        while (_size > oldSize + written)
+            pop_back();
+        return written;
     }
 
     void pop_back() {
@@ -207,55 +216,44 @@ public:
 
     void insert (iterator position, size_type n, const value_type& val) {
         difference_type index = position - begin();
+        // val may be one of the elements the growth or the shift moves
+        value_type copy(val);
         if (_size + n > _capacity)
             reallocVector((2 * _capacity >= _size + n) ? 2 * _capacity : _size + n);
-        
-        iterator newPosition(&_vector[index]);
-        if (newPosition != end())
-            moveElementsToTheRight(newPosition, n);
-        for (size_type i = 0; i < n; i++)
-            _alloc.construct(&(*newPosition++), val);
-        _size += n;
+        insertElements(index, repeatValue(&copy), n);
     }
 
     template <class InputIterator>
     void insert (iterator position, InputIterator first, InputIterator last,  typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0) {
-        difference_type index = position - begin();
-        size_type len = 0;
-        InputIterator tmp(first);
-        while (tmp++ != last)
-            len++;
-        if (_size + len > _capacity)
-            reallocVector((2 * _capacity >= _size + len) ? 2 * _capacity : _size + len);
-
-        iterator newPosition(&_vector[index]);
-        if (newPosition != end())
-            moveElementsToTheRight(newPosition, len);
-        for (size_type i = 0; i < len; i++)
-            _alloc.construct(&(*newPosition++), *(first++));
-        _size += len;
+        rangeInsert(position, first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
     }
 
     iterator erase (iterator position) {
-        if (position != end())
-            moveElementsToTheLeft(position, 1);
-        _size--;
-        return (position);
+        return erase(position, position + 1);
     }
     iterator erase (iterator first, iterator last) {
-        size_type len = 0;
-        iterator tmp(first);
-        while (tmp++ != last)
-            len++;
-        if (first != end())
-            moveElementsToTheLeft(first, len);
-        _size -= len;
+        size_type index = first - begin();
+        size_type len = last - first;
+        if (ft::is_trivially_relocatable<value_type>::value)
+        {
+            for (size_type i = index; i < index + len; ++i)
+                _alloc.destroy(&_vector[i]);
+            std::memmove(static_cast<void*>(&_vector[index]), static_cast<const void*>(&_vector[index + len]), (_size - index - len) * sizeof(value_type));
+            _size -= len;
+            return (first);
+        }
+        // assigned down then popped: a copy that throws leaves every slot below _size alive
+        for (size_type i = index; i + len < _size; ++i)
+            _vector[i] = _vector[i + len];
+        while (len--)
+            pop_back();
         return (first);
     }
     
 
     
     void clear() {
+        FT_TRACE_EVENT(CLEAR, this, _size, 0, 0);
         for (iterator it = begin(); it != end(); ++it)
             _alloc.destroy(&*it);
         _size = 0;
@@ -281,8 +279,20 @@ public:
     {
         if (n > _capacity)
             reserve((2 * _capacity >= n) ? 2 * _capacity : n);
-        while (_size < n)
-            push_back(val);
+        for (; _size < n; ++_size)
+            _alloc.construct(&_vector[_size], val);
+        while (_size > n)
+            pop_back();
+    }
+
+    // same as resize, but new elements are default-initialized: for
+    // trivial types (int, Buffer...) their bytes are left untouched
+    void resize_uninitialized (size_type n)
+    {
+        if (n > _capacity)
+            reserve((2 * _capacity >= n) ? 2 * _capacity : n);
+        for (; _size < n; ++_size)
+            ::new (static_cast<void*>(&_vector[_size])) value_type;
         while (_size > n)
             pop_back();
     }
@@ -325,13 +335,7 @@ public:
 
 
     friend bool operator== (const vector& lhs, const vector& rhs) {
-        if (lhs.size() != rhs.size())
-            return false;
-        for (const_iterator ita = lhs.begin(), itb = rhs.begin(); ita != lhs.end(); ita++, itb++) {
-            if (*ita != *itb)
-                return false;
-        }
-        return true;
+        return lhs.size() == rhs.size() && ft::equal(lhs.begin(), lhs.end(), rhs.begin());
     }
     	
     
@@ -339,13 +343,7 @@ public:
     	
     
     friend bool operator<  (const vector& lhs, const vector& rhs) {
-        for (const_iterator ita = lhs.begin(), itb = rhs.begin(); ita != lhs.end() && itb != rhs.end(); ita++, itb++) {
-            if (*ita < *itb)
-                return true;
-            if (*itb < *ita)
-                return false;
-        }
-        return lhs.size() < rhs.size();
+        return ft::lexicographical_compare(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
     }
     	
     
@@ -365,24 +363,122 @@ private:
 
     void reallocVector(size_type newCapacity) {
         pointer tmp = _alloc.allocate(newCapacity);
-        for (size_type i = 0; i < _size; ++i)
-            _alloc.construct(&tmp[i], _vector[i]);
-        this->~vector();
+        if (ft::is_trivially_relocatable<value_type>::value)
+            std::memcpy(static_cast<void*>(tmp), static_cast<const void*>(_vector), _size * sizeof(value_type));
+        else
+        {
+            // all copied before any destroyed: a copy that throws leaves the old buffer whole
+            size_type i = 0;
+            try
+            {
+                for (; i < _size; ++i)
+                    _alloc.construct(&tmp[i], _vector[i]);
+            }
+            catch (...)
+            {
+                while (i)
+                    _alloc.destroy(&tmp[--i]);
+                _alloc.deallocate(tmp, newCapacity);
+                throw;
+            }
+            for (i = 0; i < _size; ++i)
+                _alloc.destroy(&_vector[i]);
+        }
+        FT_TRACE_EVENT(REALLOCATE, this, _capacity, newCapacity, _size * sizeof(value_type));
+        _alloc.deallocate(_vector, _capacity);
         _capacity = newCapacity;
         _vector = tmp;
     }
 
-	void moveElementsToTheLeft(iterator pos, size_type n) {
-        for (iterator it = pos; it != end() - n; it++) {
-            _alloc.destroy(&(*it));
-            _alloc.construct(&*it, *(it + n));
-        }
+    // single-pass ranges can only be read once: grow as we go
+    template <class InputIterator>
+    void rangeAppend(InputIterator first, InputIterator last, std::input_iterator_tag) {
+        for (; first != last; ++first)
+            push_back(*first);
     }
-    void moveElementsToTheRight(iterator pos, size_type n) {
-        for (iterator it = end() - 1; it != pos - 1; --it) {
-            _alloc.construct(&(*(it + n)), *it);
-            _alloc.destroy(&(*it));
+
+    // multi-pass ranges are measured first so storage is reserved once
+    template <class ForwardIterator>
+    void rangeAppend(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        size_type len = ft::distance(first, last);
+        if (_size + len > _capacity)
+            reallocVector(_size + len);
+        for (; first != last; ++first, ++_size)
+            _alloc.construct(&_vector[_size], *first);
+    }
+
+    template <class InputIterator>
+    void rangeInsert(iterator position, InputIterator first, InputIterator last, std::input_iterator_tag) {
+        vector tmp(first, last, _alloc);
+        insert(position, tmp.begin(), tmp.end());
+    }
+
+    template <class ForwardIterator>
+    void rangeInsert(iterator position, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        difference_type index = position - begin();
+        size_type len = ft::distance(first, last);
+        if (_size + len > _capacity)
+            reallocVector((2 * _capacity >= _size + len) ? 2 * _capacity : _size + len);
+        insertElements(index, first, len);
+    }
+
+    // the value of insert (position, n, val), as a range of n copies
+    struct repeatValue
+    {
+        const value_type* value;
+
+        explicit repeatValue(const value_type* v) : value(v) {}
+        const value_type& operator*() const { return *value; }
+        repeatValue& operator++() { return *this; }
+        repeatValue operator++(int) { return *this; }
+    };
+
+    // n elements from first put at index, the capacity already there. Relocatable elements
+    // are moved up with memmove and moved back if a copy throws; the others as the standard
+    // library does: the tail copied into the free slots, the rest assigned, so every slot
+    // below _size always holds a live element, whatever copy throws
+    template <class ForwardIterator>
+    void insertElements(size_type index, ForwardIterator first, size_type n) {
+        size_type oldSize = _size;
+        size_type after = oldSize - index;
+        if (ft::is_trivially_relocatable<value_type>::value)
+        {
+            std::memmove(static_cast<void*>(&_vector[index + n]), static_cast<const void*>(&_vector[index]), after * sizeof(value_type));
+            size_type built = 0;
+            try
+            {
+                for (; built < n; ++built, ++first)
+                    _alloc.construct(&_vector[index + built], *first);
+            }
+            catch (...)
+            {
+                while (built)
+                    _alloc.destroy(&_vector[index + --built]);
+                std::memmove(static_cast<void*>(&_vector[index]), static_cast<const void*>(&_vector[index + n]), after * sizeof(value_type));
+                throw;
+            }
+            _size += n;
+            return;
+        }
+        if (after > n)
+        {
+            for (size_type i = oldSize - n; i < oldSize; ++i, ++_size)
+                _alloc.construct(&_vector[_size], _vector[i]);
+            for (size_type i = oldSize - n; i-- > index; )
+                _vector[i + n] = _vector[i];
+            for (size_type i = index; i < index + n; ++i, ++first)
+                _vector[i] = *first;
+            return;
         }
+        ForwardIterator mid = first;
+        for (size_type i = 0; i < after; ++i)
+            ++mid;
+        for (; _size < oldSize + n - after; ++mid, ++_size)
+            _alloc.construct(&_vector[_size], *mid);
+        for (size_type i = index; i < oldSize; ++i, ++_size)
+            _alloc.construct(&_vector[_size], _vector[i]);
+        for (size_type i = index; i < oldSize; ++i, ++first)
+            _vector[i] = *first;
     }
 
     template <typename U>
@@ -398,4 +494,6 @@ template <class T, class Alloc>
   void swap (vector<T,Alloc>& x, vector<T,Alloc>& y) { x.swap(y); }
 }
 
+#include "vector_bool.hpp"
+
 #endif
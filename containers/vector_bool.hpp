@@ -0,0 +1,444 @@
+#ifndef VECTOR_BOOL_H
+#define VECTOR_BOOL_H
+
+#include "../iterator/bit_iterator.hpp"
+#include "../algorithm/simd.hpp"
+#include "../utility.hpp"
+#include <memory>
+#include <cstring>
+#include <stdexcept>
+#include <limits>
+#include <algorithm>
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * --------------------- FT::VECTOR<BOOL> ---------------------- *
+    *
+    * Bit-packed specialization: one bit per flag, stored in 64 bits
+    * words. Bits past size() are always kept at 0, so whole words can
+    * be counted, compared and combined without masking the tail.
+    *
+    * Same interface as ft::vector, with operator[] returning a proxy
+    * (ft::bit_reference), plus:
+    *
+    * - Word-level operations:
+    * flip:                 Flip every bit, or every bit of a range
+    * set:                  Set every bit of a range
+    * reset:                Reset every bit of a range
+    * count:                Count set bits (popcount)
+    * find_first:           Index of the first set bit, size() if none
+    * find_next:            Index of the first set bit after pos, size() if none
+    * operator&= |= ^=:     Combine with another bitvector, the shorter
+    *                       one being read as zero-padded
+    * ------------------------------------------------------------- *
+    */
+template <class Alloc>
+class vector<bool, Alloc>
+{
+public:
+    typedef bool value_type;
+    typedef Alloc allocator_type;
+    typedef ft::bit_reference reference;
+    typedef bool const_reference;
+    typedef ft::bit_iterator<false> iterator;
+    typedef ft::bit_iterator<true> const_iterator;
+    typedef ft::reverse_bit_iterator<false> reverse_iterator;
+    typedef ft::reverse_bit_iterator<true> const_reverse_iterator;
+    typedef ptrdiff_t difference_type;
+    typedef size_t size_type;
+    typedef ft::bit_word word_type;
+    typedef typename allocator_type::template rebind<word_type>::other word_allocator_type;
+
+    explicit vector(const allocator_type& alloc = allocator_type()) : _alloc(alloc), _words(NULL), _size(0), _capacity(0) {}
+
+    explicit vector (size_type n, const value_type& val = value_type(), const allocator_type& alloc = allocator_type()) : _alloc(alloc), _words(NULL), _size(0), _capacity(0) {
+        resize(n, val);
+    }
+
+    template <class InputIterator>
+    vector (InputIterator first, InputIterator last, const allocator_type& alloc = allocator_type(), typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0) : _alloc(alloc), _words(NULL), _size(0), _capacity(0)
+    {
+        rangeAppend(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    vector(const vector& x) : _alloc(x._alloc), _words(NULL), _size(0), _capacity(0)
+    {
+        *this = x;
+    }
+
+    ~vector() {
+        if (_words)
+            _alloc.deallocate(_words, wordsFor(_capacity));
+    }
+
+    vector& operator= (const vector& x) {
+        if (this == &x)
+            return (*this);
+        if (x._size > _capacity)
+        {
+            clear();
+            reallocWords(x._size);
+        }
+        if (x._size)
+            std::memcpy(_words, x._words, wordsFor(x._size) * sizeof(word_type));
+        if (wordsFor(_size) > wordsFor(x._size))
+            std::memset(_words + wordsFor(x._size), 0, (wordsFor(_size) - wordsFor(x._size)) * sizeof(word_type));
+        _size = x._size;
+        return (*this);
+    }
+
+    const_iterator  begin() const   { return const_iterator(_words, 0); }
+    iterator        begin()         { return iterator(_words, 0); }
+    const_iterator  end() const     { return const_iterator(_words + _size / WORD_BITS, _size % WORD_BITS); }
+    iterator        end()           { return iterator(_words + _size / WORD_BITS, _size % WORD_BITS); }
+    const_reverse_iterator rbegin() const   { return const_reverse_iterator(end()); }
+    reverse_iterator rbegin()               { return reverse_iterator(end()); }
+    const_reverse_iterator rend() const     { return const_reverse_iterator(begin()); }
+    reverse_iterator rend()                 { return reverse_iterator(begin()); }
+
+    allocator_type get_allocator() const { return allocator_type(_alloc); }
+
+    template <class InputIterator>
+    void assign (InputIterator first, InputIterator last, typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0)
+    {
+        clear();
+        rangeAppend(first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    void assign (size_type n, const value_type& val)
+    {
+        clear();
+        resize(n, val);
+    }
+
+    void push_back (const value_type& val) {
+        if (_size >= _capacity)
+            reallocWords(!_capacity ? WORD_BITS : _capacity * 2);
+        if (val)
+            _words[_size / WORD_BITS] |= bitMask(_size);
+        ++_size;
+    }
+
+    void pop_back() {
+        if (_size)
+        {
+            --_size;
+            _words[_size / WORD_BITS] &= ~bitMask(_size);
+        }
+    }
+
+    iterator insert (iterator position, const value_type& val) {
+        difference_type index = position - begin();
+        insert(position, 1, val);
+        return (begin() + index);
+    }
+
+    void insert (iterator position, size_type n, const value_type& val) {
+        size_type index = position - begin();
+        makeRoom(index, n);
+        applyRange(index, index + n, val ? SET : RESET);
+    }
+
+    template <class InputIterator>
+    void insert (iterator position, InputIterator first, InputIterator last,  typename ft::enable_if<!ft::is_integral<InputIterator>::value , int>::type* = 0) {
+        rangeInsert(position, first, last, typename ft::iterator_traits<InputIterator>::iterator_category());
+    }
+
+    iterator erase (iterator position) {
+        return erase(position, position + 1);
+    }
+
+    iterator erase (iterator first, iterator last) {
+        size_type index = first - begin();
+        size_type len = last - first;
+        for (size_type i = index + len; i < _size; ++i)
+            assignBit(i - len, testBit(i));
+        applyRange(_size - len, _size, RESET);
+        _size -= len;
+        return (begin() + index);
+    }
+
+    void clear() {
+        if (_size)
+            std::memset(_words, 0, wordsFor(_size) * sizeof(word_type));
+        _size = 0;
+    }
+
+    void swap (vector& x) {
+        swap(_alloc, x._alloc);
+        swap(_words, x._words);
+        swap(_size, x._size);
+        swap(_capacity, x._capacity);
+    }
+
+    static void swap (reference x, reference y) {
+        bool tmp = x;
+        x = y;
+        y = tmp;
+    }
+
+    size_type size() const { return _size; }
+
+    size_type max_size() const { return std::numeric_limits<difference_type>::max(); }
+
+    void resize (size_type n, value_type val = value_type())
+    {
+        if (n > _capacity)
+            reserve((2 * _capacity >= n) ? 2 * _capacity : n);
+        if (n > _size && val)
+            applyRange(_size, n, SET);
+        else if (n < _size)
+            applyRange(n, _size, RESET);
+        _size = n;
+    }
+
+    size_type capacity() const { return _capacity; }
+
+    bool empty() const { return !_size; }
+
+    void reserve(size_type n)
+    {
+        if (n > max_size())
+            throw std::length_error("vector");
+        else if (n > _capacity)
+            reallocWords(n);
+    }
+
+    reference operator[] (size_type n) { return reference(_words + n / WORD_BITS, bitMask(n)); }
+
+    const_reference operator[] (size_type n) const { return testBit(n); }
+
+    reference at (size_type n) {
+        if (n >= _size)
+            throw std::out_of_range("vector");
+        return (*this)[n];
+    }
+
+    const_reference at (size_type n) const {
+        if (n >= _size)
+            throw std::out_of_range("vector");
+        return testBit(n);
+    }
+
+    reference front() { return (*this)[0]; }
+
+    const_reference front() const { return testBit(0); }
+
+    reference back() { return (*this)[_size - 1]; }
+
+    const_reference back() const { return testBit(_size - 1); }
+
+    void flip() { applyRange(0, _size, FLIP); }
+
+    void flip(size_type first, size_type last) { checkRange(first, last); applyRange(first, last, FLIP); }
+
+    void set(size_type first, size_type last) { checkRange(first, last); applyRange(first, last, SET); }
+
+    void reset(size_type first, size_type last) { checkRange(first, last); applyRange(first, last, RESET); }
+
+    size_type count() const { return ft::simd::popcount(_words, wordsFor(_size)); }
+
+    size_type find_first() const { return findFrom(0); }
+
+    size_type find_next(size_type pos) const { return findFrom(pos + 1); }
+
+    vector& operator&= (const vector& x) {
+        size_type n = wordsFor(_size);
+        size_type common = std::min(n, wordsFor(x._size));
+        for (size_type i = 0; i < common; ++i)
+            _words[i] &= x._words[i];
+        if (n > common)
+            std::memset(_words + common, 0, (n - common) * sizeof(word_type));
+        return (*this);
+    }
+
+    vector& operator|= (const vector& x) {
+        size_type common = std::min(wordsFor(_size), wordsFor(x._size));
+        for (size_type i = 0; i < common; ++i)
+            _words[i] |= x._words[i];
+        clearTail();
+        return (*this);
+    }
+
+    vector& operator^= (const vector& x) {
+        size_type common = std::min(wordsFor(_size), wordsFor(x._size));
+        for (size_type i = 0; i < common; ++i)
+            _words[i] ^= x._words[i];
+        clearTail();
+        return (*this);
+    }
+
+    friend vector operator& (const vector& lhs, const vector& rhs) { vector res(lhs); return (res &= rhs); }
+
+    friend vector operator| (const vector& lhs, const vector& rhs) { vector res(lhs); return (res |= rhs); }
+
+    friend vector operator^ (const vector& lhs, const vector& rhs) { vector res(lhs); return (res ^= rhs); }
+
+    friend bool operator== (const vector& lhs, const vector& rhs) {
+        return lhs._size == rhs._size
+            && (!lhs._size || std::memcmp(lhs._words, rhs._words, wordsFor(lhs._size) * sizeof(word_type)) == 0);
+    }
+
+    friend bool operator!= (const vector& lhs, const vector& rhs) { return (!(lhs == rhs)); }
+
+    // bit i is element i, so the first differing bit is the lowest one of the first differing word
+    friend bool operator<  (const vector& lhs, const vector& rhs) {
+        size_type common = std::min(lhs._size, rhs._size);
+        size_type n = wordsFor(common);
+        for (size_type i = 0; i < n; ++i)
+        {
+            word_type diff = lhs._words[i] ^ rhs._words[i];
+            if (!diff)
+                continue;
+            size_type bit = i * WORD_BITS + ft::simd::countTrailingZeros(diff);
+            if (bit >= common)
+                break;
+            return rhs.testBit(bit);
+        }
+        return lhs._size < rhs._size;
+    }
+
+    friend bool operator<= (const vector& lhs, const vector& rhs) { return (!(rhs < lhs)); }
+
+    friend bool operator>  (const vector& lhs, const vector& rhs) { return (rhs < lhs); }
+
+    friend bool operator>= (const vector& lhs, const vector& rhs) { return (!(lhs < rhs)); }
+
+private:
+    static const size_type WORD_BITS = 64;
+    enum rangeOp { SET, RESET, FLIP };
+
+    word_allocator_type _alloc;
+    word_type* _words;
+    size_type _size;
+    size_type _capacity;
+
+    static size_type wordsFor(size_type bits) { return (bits + WORD_BITS - 1) / WORD_BITS; }
+
+    static word_type bitMask(size_type n) { return word_type(1) << (n % WORD_BITS); }
+
+    bool testBit(size_type n) const { return (_words[n / WORD_BITS] & bitMask(n)) != 0; }
+
+    void assignBit(size_type n, bool val) {
+        if (val)
+            _words[n / WORD_BITS] |= bitMask(n);
+        else
+            _words[n / WORD_BITS] &= ~bitMask(n);
+    }
+
+    void checkRange(size_type first, size_type last) const {
+        if (first > last || last > _size)
+            throw std::out_of_range("vector");
+    }
+
+    // new words are zeroed so the bits past size() stay at 0
+    void reallocWords(size_type bits) {
+        size_type n = wordsFor(bits);
+        word_type* tmp = _alloc.allocate(n);
+        size_type used = wordsFor(_size);
+        if (used)
+            std::memcpy(tmp, _words, used * sizeof(word_type));
+        std::memset(tmp + used, 0, (n - used) * sizeof(word_type));
+        if (_words)
+            _alloc.deallocate(_words, wordsFor(_capacity));
+        _words = tmp;
+        _capacity = n * WORD_BITS;
+    }
+
+    void clearTail() {
+        if (_size % WORD_BITS)
+            _words[_size / WORD_BITS] &= ~(~word_type(0) << (_size % WORD_BITS));
+    }
+
+    void applyWord(word_type& word, word_type mask, rangeOp op) {
+        if (op == SET)
+            word |= mask;
+        else if (op == RESET)
+            word &= ~mask;
+        else
+            word ^= mask;
+    }
+
+    void applyRange(size_type first, size_type last, rangeOp op) {
+        if (first >= last)
+            return;
+        size_type firstWord = first / WORD_BITS;
+        size_type lastWord = (last - 1) / WORD_BITS;
+        word_type firstMask = ~word_type(0) << (first % WORD_BITS);
+        word_type lastMask = ~word_type(0) >> (WORD_BITS - 1 - (last - 1) % WORD_BITS);
+        if (firstWord == lastWord)
+            return applyWord(_words[firstWord], firstMask & lastMask, op);
+        applyWord(_words[firstWord], firstMask, op);
+        for (size_type i = firstWord + 1; i < lastWord; ++i)
+            applyWord(_words[i], ~word_type(0), op);
+        applyWord(_words[lastWord], lastMask, op);
+    }
+
+    size_type findFrom(size_type pos) const {
+        if (pos >= _size)
+            return _size;
+        size_type i = pos / WORD_BITS;
+        word_type word = _words[i] & (~word_type(0) << (pos % WORD_BITS));
+        size_type n = wordsFor(_size);
+        while (!word)
+        {
+            if (++i == n)
+                return _size;
+            word = _words[i];
+        }
+        return i * WORD_BITS + ft::simd::countTrailingZeros(word);
+    }
+
+    // shifts [index, size) n bits to the right, the gap is left as is
+    void makeRoom(size_type index, size_type n) {
+        if (_size + n > _capacity)
+            reallocWords((2 * _capacity >= _size + n) ? 2 * _capacity : _size + n);
+        size_type i = _size;
+        _size += n;
+        while (i-- > index)
+            assignBit(i + n, testBit(i));
+    }
+
+    template <class InputIterator>
+    void rangeAppend(InputIterator first, InputIterator last, std::input_iterator_tag) {
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    template <class ForwardIterator>
+    void rangeAppend(ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        reserve(_size + ft::distance(first, last));
+        for (; first != last; ++first)
+            push_back(*first);
+    }
+
+    template <class InputIterator>
+    void rangeInsert(iterator position, InputIterator first, InputIterator last, std::input_iterator_tag) {
+        vector tmp(first, last, get_allocator());
+        insert(position, tmp.begin(), tmp.end());
+    }
+
+    template <class ForwardIterator>
+    void rangeInsert(iterator position, ForwardIterator first, ForwardIterator last, std::forward_iterator_tag) {
+        size_type index = position - begin();
+        makeRoom(index, ft::distance(first, last));
+        for (; first != last; ++first)
+            assignBit(index++, *first);
+    }
+
+    template <typename U>
+    void swap(U& a, U&b)
+    {
+        U tmp = a;
+        a = b;
+        b = tmp;
+    }
+};
+
+template <class Alloc>
+const typename vector<bool, Alloc>::size_type vector<bool, Alloc>::WORD_BITS;
+
+}
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef BIT_ITERATOR_H
+#define BIT_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include "../utility.hpp"
+
+namespace ft {
+
+typedef unsigned long long bit_word;
+
+// proxy standing for one bit of a vector<bool>
+class bit_reference {
+public:
+    bit_reference(bit_word* word, bit_word mask) : _word(word), _mask(mask) {}
+
+    operator bool() const { return (*_word & _mask) != 0; }
+    bool operator~() const { return !(*_word & _mask); }
+
+    bit_reference& operator=(bool x) {
+      if (x)
+        *_word |= _mask;
+      else
+        *_word &= ~_mask;
+      return (*this);
+    }
+    bit_reference& operator=(const bit_reference& x) { return (*this = bool(x)); }
+
+    void flip() { *_word ^= _mask; }
+
+    private:
+        bit_word* _word;
+        bit_word _mask;
+};
+
+template<bool B>
+struct bit_iterator {
+    typedef bool                                                value_type;
+    typedef long int                                            difference_type;
+    typedef typename ft::chooseConst<B, bit_reference, bool>::type  reference;
+    typedef void                                                pointer;
+    typedef std::random_access_iterator_tag                     iterator_category;
+
+    bit_iterator() : _word(NULL), _offset(0) {}
+    bit_iterator(bit_word* word, unsigned offset) : _word(word), _offset(offset) {}
+
+    bit_iterator(const bit_iterator<false>& src) : _word(src.getWord()), _offset(src.getOffset()) {}
+
+    ~bit_iterator() {}
+
+    bit_iterator& operator=(const bit_iterator & src) {
+      _word = src._word;
+      _offset = src._offset;
+      return (*this);
+    }
+
+    bit_word* getWord() const { return _word; }
+    unsigned getOffset() const { return _offset; }
+
+    reference operator*() const { return reference(bit_reference(_word, bit_word(1) << _offset)); }
+
+    bit_iterator& operator++() {
+      if (++_offset == 64) {
+        _offset = 0;
+        ++_word;
+      }
+      return *this;
+    }
+    bit_iterator& operator--() {
+      if (_offset-- == 0) {
+        _offset = 63;
+        --_word;
+      }
+      return *this;
+    }
+
+    bit_iterator operator++(int) { bit_iterator tmp = *this; ++(*this); return tmp; }
+    bit_iterator operator--(int) { bit_iterator tmp = *this; --(*this); return tmp; }
+
+    friend bool operator==(const bit_iterator& lhs, const bit_iterator& rhs) {return lhs._word == rhs._word && lhs._offset == rhs._offset;}
+    friend bool operator!=(const bit_iterator& lhs, const bit_iterator& rhs) {return !(lhs == rhs);}
+    friend bool operator<(const bit_iterator& lhs, const bit_iterator& rhs) {return (lhs - rhs) < 0;}
+    friend bool operator>(const bit_iterator& lhs, const bit_iterator& rhs) {return rhs < lhs;}
+    friend bool operator<=(const bit_iterator& lhs, const bit_iterator& rhs) {return !(rhs < lhs);}
+    friend bool operator>=(const bit_iterator& lhs, const bit_iterator& rhs) {return !(lhs < rhs);}
+
+    bit_iterator& operator+=(difference_type n) {
+      difference_type pos = static_cast<difference_type>(_offset) + n;
+      _word += pos / 64;
+      pos %= 64;
+      if (pos < 0) {
+        pos += 64;
+        --_word;
+      }
+      _offset = static_cast<unsigned>(pos);
+      return (*this);
+    }
+
+    bit_iterator operator+(difference_type n) const {
+      bit_iterator it(*this);
+      return (it += n);
+    }
+
+    bit_iterator& operator-=(difference_type n) { return (*this += -n); }
+
+    bit_iterator operator-(difference_type n) const {
+      bit_iterator it(*this);
+      return (it -= n);
+    }
+
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    difference_type operator-(const bit_iterator& it) const {
+      return (_word - it._word) * 64 + static_cast<difference_type>(_offset) - static_cast<difference_type>(it._offset);
+    }
+
+    friend bit_iterator operator+(difference_type n, const bit_iterator & it) { return (it + n); }
+
+    private:
+        bit_word* _word;
+        unsigned _offset;
+  };
+
+template<bool B>
+struct reverse_bit_iterator {
+    typedef bool                                  value_type;
+    typedef long int                              difference_type;
+    typedef typename bit_iterator<B>::reference   reference;
+    typedef void                                  pointer;
+    typedef std::random_access_iterator_tag       iterator_category;
+
+    reverse_bit_iterator() {}
+    explicit reverse_bit_iterator(const bit_iterator<B>& base) : _base(base) {}
+    reverse_bit_iterator(const reverse_bit_iterator<false>& src) : _base(src.base()) {}
+
+    bit_iterator<B> base() const { return _base; }
+
+    reference operator*() const { bit_iterator<B> tmp(_base); return *(--tmp); }
+
+    reverse_bit_iterator& operator++() { --_base; return *this; }
+    reverse_bit_iterator& operator--() { ++_base; return *this; }
+    reverse_bit_iterator operator++(int) { reverse_bit_iterator tmp = *this; --_base; return tmp; }
+    reverse_bit_iterator operator--(int) { reverse_bit_iterator tmp = *this; ++_base; return tmp; }
+
+    reverse_bit_iterator& operator+=(difference_type n) { _base -= n; return *this; }
+    reverse_bit_iterator& operator-=(difference_type n) { _base += n; return *this; }
+    reverse_bit_iterator operator+(difference_type n) const { return reverse_bit_iterator(_base - n); }
+    reverse_bit_iterator operator-(difference_type n) const { return reverse_bit_iterator(_base + n); }
+    difference_type operator-(const reverse_bit_iterator& it) const { return it._base - _base; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    friend bool operator==(const reverse_bit_iterator& lhs, const reverse_bit_iterator& rhs) {return lhs._base == rhs._base;}
+    friend bool operator!=(const reverse_bit_iterator& lhs, const reverse_bit_iterator& rhs) {return lhs._base != rhs._base;}
+    friend bool operator<(const reverse_bit_iterator& lhs, const reverse_bit_iterator& rhs) {return rhs._base < lhs._base;}
+    friend bool operator>(const reverse_bit_iterator& lhs, const reverse_bit_iterator& rhs) {return rhs < lhs;}
+    friend bool operator<=(const reverse_bit_iterator& lhs, const reverse_bit_iterator& rhs) {return !(rhs < lhs);}
+    friend bool operator>=(const reverse_bit_iterator& lhs, const reverse_bit_iterator& rhs) {return !(lhs < rhs);}
+
+    private:
+        bit_iterator<B> _base;
+  };
+}
+
+#endif
@@ -0,0 +1,121 @@
+#ifndef DEQUE_ITERATOR_H
+#define DEQUE_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include "../utility.hpp"
+
+namespace ft {
+
+// elements per deque chunk, a power of two so that index math stays shifts and masks
+template <typename T>
+struct deque_chunk {
+    static const size_t size = sizeof(T) <= 8 ? 512 : (sizeof(T) <= 64 ? 64 : 16);
+};
+
+template <typename T>
+const size_t deque_chunk<T>::size;
+
+// a position in the deque's block map: element index is global to the map, chunk = index / size
+template<typename T, bool B>
+struct deque_iterator {
+    typedef T         value_type;
+    typedef long int  difference_type;
+    typedef typename ft::chooseConst<B, T&, const T&>::type     reference;
+    typedef typename ft::chooseConst<B, T*, const T*>::type     pointer;
+    typedef std::random_access_iterator_tag                     iterator_category;
+    typedef T**                                                 mapPtr;
+
+    deque_iterator() : _map(NULL), _index(0) {}
+    deque_iterator(mapPtr map, size_t index) : _map(map), _index(index) {}
+
+    deque_iterator(const deque_iterator<T, false>& src) : _map(src.getMap()), _index(src.getIndex()) {}
+
+    ~deque_iterator() {}
+
+    deque_iterator& operator=(const deque_iterator & src) {
+      _map = src._map;
+      _index = src._index;
+      return (*this);
+    }
+
+    mapPtr getMap() const { return _map; }
+    size_t getIndex() const { return _index; }
+
+    reference operator*() const { return _map[_index / deque_chunk<T>::size][_index % deque_chunk<T>::size]; }
+    pointer operator->() const { return &(operator*()); }
+
+    deque_iterator& operator++() { ++_index; return *this; }
+    deque_iterator& operator--() { --_index; return *this; }
+
+    deque_iterator operator++(int) { deque_iterator tmp = *this; ++_index; return tmp; }
+    deque_iterator operator--(int) { deque_iterator tmp = *this; --_index; return tmp; }
+
+    friend bool operator==(const deque_iterator& lhs, const deque_iterator& rhs) {return lhs._index == rhs._index;}
+    friend bool operator!=(const deque_iterator& lhs, const deque_iterator& rhs) {return lhs._index != rhs._index;}
+    friend bool operator<=(const deque_iterator& lhs, const deque_iterator& rhs) {return lhs._index <= rhs._index;}
+    friend bool operator>=(const deque_iterator& lhs, const deque_iterator& rhs) {return lhs._index >= rhs._index;}
+    friend bool operator>(const deque_iterator& lhs, const deque_iterator& rhs) {return lhs._index > rhs._index;}
+    friend bool operator<(const deque_iterator& lhs, const deque_iterator& rhs) {return lhs._index < rhs._index;}
+
+    deque_iterator& operator+=(difference_type n) { _index += n; return (*this); }
+    deque_iterator& operator-=(difference_type n) { _index -= n; return (*this); }
+
+    deque_iterator operator+(difference_type n) const { return deque_iterator(_map, _index + n); }
+    deque_iterator operator-(difference_type n) const { return deque_iterator(_map, _index - n); }
+
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    difference_type operator-(const deque_iterator& it) const {
+      return static_cast<difference_type>(_index) - static_cast<difference_type>(it._index);
+    }
+
+    friend deque_iterator operator+(difference_type n, const deque_iterator & it) { return (it + n); }
+
+    private:
+        mapPtr _map;
+        size_t _index;
+  };
+
+template<typename T, bool B>
+struct reverse_deque_iterator {
+    typedef T                                       value_type;
+    typedef long int                                difference_type;
+    typedef typename deque_iterator<T, B>::reference    reference;
+    typedef typename deque_iterator<T, B>::pointer      pointer;
+    typedef std::random_access_iterator_tag         iterator_category;
+
+    reverse_deque_iterator() {}
+    explicit reverse_deque_iterator(const deque_iterator<T, B>& base) : _base(base) {}
+    reverse_deque_iterator(const reverse_deque_iterator<T, false>& src) : _base(src.base()) {}
+
+    deque_iterator<T, B> base() const { return _base; }
+
+    reference operator*() const { deque_iterator<T, B> tmp(_base); return *(--tmp); }
+    pointer operator->() const { return &(operator*()); }
+
+    reverse_deque_iterator& operator++() { --_base; return *this; }
+    reverse_deque_iterator& operator--() { ++_base; return *this; }
+    reverse_deque_iterator operator++(int) { reverse_deque_iterator tmp = *this; --_base; return tmp; }
+    reverse_deque_iterator operator--(int) { reverse_deque_iterator tmp = *this; ++_base; return tmp; }
+
+    reverse_deque_iterator& operator+=(difference_type n) { _base -= n; return *this; }
+    reverse_deque_iterator& operator-=(difference_type n) { _base += n; return *this; }
+    reverse_deque_iterator operator+(difference_type n) const { return reverse_deque_iterator(_base - n); }
+    reverse_deque_iterator operator-(difference_type n) const { return reverse_deque_iterator(_base + n); }
+    difference_type operator-(const reverse_deque_iterator& it) const { return it._base - _base; }
+    reference operator[](difference_type n) const { return *(*this + n); }
+
+    friend bool operator==(const reverse_deque_iterator& lhs, const reverse_deque_iterator& rhs) {return lhs._base == rhs._base;}
+    friend bool operator!=(const reverse_deque_iterator& lhs, const reverse_deque_iterator& rhs) {return lhs._base != rhs._base;}
+    friend bool operator<(const reverse_deque_iterator& lhs, const reverse_deque_iterator& rhs) {return rhs._base < lhs._base;}
+    friend bool operator>(const reverse_deque_iterator& lhs, const reverse_deque_iterator& rhs) {return rhs < lhs;}
+    friend bool operator<=(const reverse_deque_iterator& lhs, const reverse_deque_iterator& rhs) {return !(rhs < lhs);}
+    friend bool operator>=(const reverse_deque_iterator& lhs, const reverse_deque_iterator& rhs) {return !(lhs < rhs);}
+
+    private:
+        deque_iterator<T, B> _base;
+  };
+}
+
+#endif
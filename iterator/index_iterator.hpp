@@ -0,0 +1,72 @@
+#ifndef INDEX_ITERATOR_H
+#define INDEX_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include "../utility.hpp"
+
+namespace ft {
+
+// random access iterator over any container with operator[]: a container pointer and an index
+template<typename Container, typename T, bool B>
+struct index_iterator {
+    typedef T         value_type;
+    typedef long int  difference_type;
+    typedef typename ft::chooseConst<B, T&, const T&>::type                   reference;
+    typedef typename ft::chooseConst<B, T*, const T*>::type                   pointer;
+    typedef typename ft::chooseConst<B, Container*, const Container*>::type   containerPtr;
+    typedef std::random_access_iterator_tag                                   iterator_category;
+
+    index_iterator() : _container(NULL), _index(0) {}
+    index_iterator(containerPtr container, size_t index) : _container(container), _index(index) {}
+
+    index_iterator(const index_iterator<Container, T, false>& src) : _container(src.getContainer()), _index(src.getIndex()) {}
+
+    ~index_iterator() {}
+
+    index_iterator& operator=(const index_iterator & src) {
+      _container = src._container;
+      _index = src._index;
+      return (*this);
+    }
+
+    containerPtr getContainer() const { return _container; }
+    size_t getIndex() const { return _index; }
+
+    reference operator*() const { return (*_container)[_index]; }
+    pointer operator->() const { return &(operator*()); }
+
+    index_iterator& operator++() { ++_index; return *this; }
+    index_iterator& operator--() { --_index; return *this; }
+
+    index_iterator operator++(int) { index_iterator tmp = *this; ++_index; return tmp; }
+    index_iterator operator--(int) { index_iterator tmp = *this; --_index; return tmp; }
+
+    friend bool operator==(const index_iterator& lhs, const index_iterator& rhs) {return lhs._index == rhs._index;}
+    friend bool operator!=(const index_iterator& lhs, const index_iterator& rhs) {return lhs._index != rhs._index;}
+    friend bool operator<=(const index_iterator& lhs, const index_iterator& rhs) {return lhs._index <= rhs._index;}
+    friend bool operator>=(const index_iterator& lhs, const index_iterator& rhs) {return lhs._index >= rhs._index;}
+    friend bool operator>(const index_iterator& lhs, const index_iterator& rhs) {return lhs._index > rhs._index;}
+    friend bool operator<(const index_iterator& lhs, const index_iterator& rhs) {return lhs._index < rhs._index;}
+
+    index_iterator& operator+=(difference_type n) { _index += n; return (*this); }
+    index_iterator& operator-=(difference_type n) { _index -= n; return (*this); }
+
+    index_iterator operator+(difference_type n) const { return index_iterator(_container, _index + n); }
+    index_iterator operator-(difference_type n) const { return index_iterator(_container, _index - n); }
+
+    reference operator[](difference_type n) const { return (*_container)[_index + n]; }
+
+    difference_type operator-(const index_iterator& it) const {
+      return static_cast<difference_type>(_index) - static_cast<difference_type>(it._index);
+    }
+
+    friend index_iterator operator+(difference_type n, const index_iterator & it) { return (it + n); }
+
+    private:
+        containerPtr _container;
+        size_t _index;
+  };
+}
+
+#endif
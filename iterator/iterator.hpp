@@ -50,29 +50,29 @@ struct iterator {
     friend bool operator>(const iterator& lhs, const iterator& rhs) {return lhs.getPtr() > rhs.getPtr();}
     friend bool operator<(const iterator& lhs, const iterator& rhs) {return lhs.getPtr() < rhs.getPtr();}
 
-    iterator operator+=(int n) {
+    iterator operator+=(difference_type n) {
       m_ptr += n;
       return (*this);
     }
 
-    iterator operator+(int n) const {
+    iterator operator+(difference_type n) const {
       iterator it(*this);
       it.m_ptr += n;
       return (it);
     }
 
-    iterator operator-=(int n) {
+    iterator operator-=(difference_type n) {
       m_ptr -= n;
       return (*this);
     }
 
-    iterator operator-(int n) const {
+    iterator operator-(difference_type n) const {
       iterator it(*this);
       it.m_ptr -= n;
       return (it);
     }
 
-    reference operator[](int n) const {
+    reference operator[](difference_type n) const {
       pointer ptr(m_ptr);
       ptr += n;
       return (*ptr);
@@ -83,12 +83,12 @@ struct iterator {
     }
     
 
-    friend iterator operator+(int n, const iterator & it) {
+    friend iterator operator+(difference_type n, const iterator & it) {
       iterator newIt(it);
       return (newIt += n);
     }
 
-    friend iterator operator-(int n, const iterator & it) {
+    friend iterator operator-(difference_type n, const iterator & it) {
       iterator newIt(it);
       return (newIt -= n);
     }
@@ -56,29 +56,29 @@ struct reverse_iterator {
     friend bool operator>(const reverse_iterator& lhs, const reverse_iterator& rhs) {return lhs.getPtr() < rhs.getPtr();}
     friend bool operator<(const reverse_iterator& lhs, const reverse_iterator& rhs) {return lhs.getPtr() > rhs.getPtr();}
 
-    reverse_iterator operator+=(int n) {
+    reverse_iterator operator+=(difference_type n) {
       m_ptr -= n;
       return (*this);
     }
 
-    reverse_iterator operator+(int n) const {
+    reverse_iterator operator+(difference_type n) const {
       reverse_iterator it(*this);
       it.m_ptr -= n;
       return (it);
     }
 
-    reverse_iterator operator-=(int n) {
+    reverse_iterator operator-=(difference_type n) {
       m_ptr += n;
       return (*this);
     }
 
-    reverse_iterator operator-(int n) const {
+    reverse_iterator operator-(difference_type n) const {
       reverse_iterator it(*this);
       it.m_ptr += n;
       return (it);
     }
 
-    reference operator[](int n) const {
+    reference operator[](difference_type n) const {
       pointer ptr(m_ptr);
       ptr -= n;
       return (*ptr);
@@ -92,12 +92,12 @@ struct reverse_iterator {
       return (it.getPtr() + m_ptr);
     }
 
-    friend reverse_iterator operator+(int n, const reverse_iterator & it) {
+    friend reverse_iterator operator+(difference_type n, const reverse_iterator & it) {
       reverse_iterator newIt(it);
       return (newIt += n);
     }
 
-    friend reverse_iterator operator-(int n, const reverse_iterator & it) {
+    friend reverse_iterator operator-(difference_type n, const reverse_iterator & it) {
       reverse_iterator newIt(it);
       return (newIt -= n);
     }
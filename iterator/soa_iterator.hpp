@@ -0,0 +1,112 @@
+#ifndef SOA_ITERATOR_H
+#define SOA_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include "../utility.hpp"
+
+namespace ft {
+
+// proxy standing for one row of a soa_vector: a reference into each column
+template<typename T1, typename T2, bool B>
+struct soa_reference {
+    typedef typename ft::chooseConst<B, T1&, const T1&>::type   first_reference;
+    typedef typename ft::chooseConst<B, T2&, const T2&>::type   second_reference;
+
+    first_reference first;
+    second_reference second;
+
+    soa_reference(first_reference a, second_reference b) : first(a), second(b) {}
+    soa_reference(const soa_reference<T1, T2, false>& src) : first(src.first), second(src.second) {}
+
+    operator ft::pair<T1, T2>() const { return ft::pair<T1, T2>(first, second); }
+
+    soa_reference& operator=(const ft::pair<T1, T2>& x) {
+      first = x.first;
+      second = x.second;
+      return (*this);
+    }
+    soa_reference& operator=(const soa_reference& x) {
+      first = x.first;
+      second = x.second;
+      return (*this);
+    }
+
+    friend bool operator==(const soa_reference& lhs, const soa_reference& rhs) {
+      return lhs.first == rhs.first && lhs.second == rhs.second;
+    }
+    friend bool operator!=(const soa_reference& lhs, const soa_reference& rhs) { return !(lhs == rhs); }
+};
+
+// what soa_iterator::operator-> returns: keeps the proxy alive for the member access
+template<typename Reference>
+struct soa_pointer {
+    explicit soa_pointer(const Reference& ref) : _ref(ref) {}
+    Reference* operator->() { return &_ref; }
+
+    private:
+        Reference _ref;
+};
+
+// one pointer per column, moved in step
+template<typename T1, typename T2, bool B>
+struct soa_iterator {
+    typedef ft::pair<T1, T2>                                      value_type;
+    typedef long int                                              difference_type;
+    typedef ft::soa_reference<T1, T2, B>                          reference;
+    typedef ft::soa_pointer<reference>                            pointer;
+    typedef std::random_access_iterator_tag                       iterator_category;
+    typedef typename ft::chooseConst<B, T1*, const T1*>::type     first_pointer;
+    typedef typename ft::chooseConst<B, T2*, const T2*>::type     second_pointer;
+
+    soa_iterator() : _first(NULL), _second(NULL) {}
+    soa_iterator(first_pointer first, second_pointer second) : _first(first), _second(second) {}
+
+    soa_iterator(const soa_iterator<T1, T2, false>& src) : _first(src.getFirst()), _second(src.getSecond()) {}
+
+    ~soa_iterator() {}
+
+    soa_iterator& operator=(const soa_iterator & src) {
+      _first = src._first;
+      _second = src._second;
+      return (*this);
+    }
+
+    first_pointer getFirst() const { return _first; }
+    second_pointer getSecond() const { return _second; }
+
+    reference operator*() const { return reference(*_first, *_second); }
+    pointer operator->() const { return pointer(**this); }
+
+    soa_iterator& operator++() { ++_first; ++_second; return *this; }
+    soa_iterator& operator--() { --_first; --_second; return *this; }
+
+    soa_iterator operator++(int) { soa_iterator tmp = *this; ++(*this); return tmp; }
+    soa_iterator operator--(int) { soa_iterator tmp = *this; --(*this); return tmp; }
+
+    friend bool operator==(const soa_iterator& lhs, const soa_iterator& rhs) {return lhs._first == rhs._first;}
+    friend bool operator!=(const soa_iterator& lhs, const soa_iterator& rhs) {return lhs._first != rhs._first;}
+    friend bool operator<=(const soa_iterator& lhs, const soa_iterator& rhs) {return lhs._first <= rhs._first;}
+    friend bool operator>=(const soa_iterator& lhs, const soa_iterator& rhs) {return lhs._first >= rhs._first;}
+    friend bool operator>(const soa_iterator& lhs, const soa_iterator& rhs) {return lhs._first > rhs._first;}
+    friend bool operator<(const soa_iterator& lhs, const soa_iterator& rhs) {return lhs._first < rhs._first;}
+
+    soa_iterator& operator+=(difference_type n) { _first += n; _second += n; return (*this); }
+    soa_iterator& operator-=(difference_type n) { _first -= n; _second -= n; return (*this); }
+
+    soa_iterator operator+(difference_type n) const { return soa_iterator(_first + n, _second + n); }
+    soa_iterator operator-(difference_type n) const { return soa_iterator(_first - n, _second - n); }
+
+    reference operator[](difference_type n) const { return reference(_first[n], _second[n]); }
+
+    difference_type operator-(const soa_iterator& it) const { return _first - it._first; }
+
+    friend soa_iterator operator+(difference_type n, const soa_iterator & it) { return (it + n); }
+
+    private:
+        first_pointer _first;
+        second_pointer _second;
+  };
+}
+
+#endif
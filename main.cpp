@@ -16,6 +16,7 @@
 	#include "containers/map.hpp"
 	#include "containers/stack.hpp"
 	#include "containers/vector.hpp"
+	#include "containers/string.hpp"
 #endif
 #include <list>
 
@@ -154,7 +155,7 @@ int main(int argc, char** argv) {
 	const int seed = atoi(argv[1]);
 	srand(seed);
 
-	ft::vector<std::string> vector_str;
+	ft::vector<ft::string> vector_str;
 	ft::vector<int> vector_int;
 	ft::stack<int> stack_int;
 	ft::vector<Buffer> vector_buffer;
@@ -188,25 +189,16 @@ int main(int argc, char** argv) {
 	}
 	ft::vector<int> vector_int_ft;
 	std::vector<int> vector_int_std;
-	time_t start_vec1_ft = clock();
 	for (int i = 0; i < COUNT; ++i)
 	{
 		vector_int.push_back(rand());
 	}
-	time_t end_vec1_ft = clock();
-    std::cout << "vec push duration : " << (end_vec1_ft - start_vec1_ft)  << std::endl;
-	time_t start_vec2_ft = clock();
 	vector_int.clear();
-	time_t end_vec2_ft = clock();
-    std::cout << "vec clear duration : " << (end_vec2_ft - start_vec2_ft) << std::endl;
-	time_t start_1_ft = clock();
 	for (int i = 0; i < COUNT; ++i)
 	{
 		map_int.insert(ft::make_pair(rand(), rand()));
 	}
-	time_t end_1_ft = clock();
 	
-    std::cout << "map insert duration : " << (end_1_ft - start_1_ft) << std::endl;
 
 	int sum = 0;
 	for (int i = 0; i < 10000; i++)
@@ -231,13 +223,10 @@ int main(int argc, char** argv) {
 
 	
 	
-	time_t start_2_ft = clock();
 	
 		ft::map<int, int> copy_ft = map_int;
 	
-	time_t end_2_ft = clock();
 	
-    std::cout << "map assign duration : " << (end_2_ft - start_2_ft) << std::endl;
 	
 	
 
@@ -268,11 +257,8 @@ int main(int argc, char** argv) {
     copy.insert(ft::pair<int, char>(1, 'c'));
     
 	
-	time_t start_clear_ft = clock();
     map_int.clear();
-    time_t end_clear_ft = clock();
 	
-    std::cout << "clear duration : " << (end_clear_ft - start_clear_ft) << std::endl;
     mp.empty();
     mp.size();
     mp.max_size();
@@ -0,0 +1,190 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <cstddef>
+#include <new>
+#include <limits>
+#include "../utility.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::ARENA ------------------------- *
+    *
+    * Monotonic memory resource: allocations are bumped out of large
+    * blocks and never freed one by one. reset() releases everything
+    * at once (keeping one block around for the next batch), the
+    * destructor gives every block back.
+    *
+    * ft::arena_allocator<T> plugs an arena into any ft container:
+    *
+    *     ft::arena a;
+    *     ft::map<int, int, ft::less<int>, ft::arena_allocator<ft::pair<const int, int> > >
+    *         m((ft::less<int>()), ft::arena_allocator<ft::pair<const int, int> >(a));
+    *
+    * deallocate is a no-op, and ft::allocator_skips_teardown is true
+    * for it: containers of trivially destructible elements return from
+    * their destructor without visiting each element or node. Containers
+    * must not outlive reset() or the arena.
+    * ------------------------------------------------------------- *
+    */
+class arena
+{
+public:
+    explicit arena(size_t blockSize = 1 << 20) : _blockSize(blockSize), _head(NULL), _cur(NULL), _end(NULL), _used(0), _reserved(0) {}
+
+    ~arena() {
+        releaseBlocks(NULL);
+    }
+
+    void* allocate(size_t bytes, size_t align) {
+        char* p = alignUp(_cur, align);
+        if (!_cur || p > _end || bytes > static_cast<size_t>(_end - p))
+        {
+            addBlock(bytes + align);
+            p = alignUp(_cur, align);
+        }
+        _cur = p + bytes;
+        _used += bytes;
+        return p;
+    }
+
+    // releases every allocation; one regular block is kept for the next batch
+    void reset() {
+        block* keep = NULL;
+        for (block* b = _head; b; b = b->next)
+            if (b->size == _blockSize)
+                keep = b;
+        releaseBlocks(keep);
+        _head = keep;
+        _used = 0;
+        if (keep)
+        {
+            keep->next = NULL;
+            _cur = keep->data();
+            _end = _cur + keep->size;
+            _reserved = keep->size;
+        }
+        else
+        {
+            _cur = NULL;
+            _end = NULL;
+            _reserved = 0;
+        }
+    }
+
+    size_t bytes_used() const { return _used; }
+    size_t bytes_reserved() const { return _reserved; }
+
+private:
+    struct block {
+        block* next;
+        size_t size;
+        char* data() { return reinterpret_cast<char*>(this + 1); }
+    };
+
+    size_t _blockSize;
+    block* _head;
+    char* _cur;
+    char* _end;
+    size_t _used;
+    size_t _reserved;
+
+    arena(const arena&);
+    arena& operator=(const arena&);
+
+    static char* alignUp(char* p, size_t align) {
+        size_t addr = reinterpret_cast<size_t>(p);
+        return reinterpret_cast<char*>((addr + align - 1) & ~(align - 1));
+    }
+
+    void addBlock(size_t minSize) {
+        size_t size = minSize > _blockSize ? minSize : _blockSize;
+        block* b = static_cast<block*>(::operator new(sizeof(block) + size));
+        b->next = _head;
+        b->size = size;
+        _head = b;
+        _cur = b->data();
+        _end = _cur + size;
+        _reserved += size;
+    }
+
+    void releaseBlocks(block* keep) {
+        block* b = _head;
+        while (b)
+        {
+            block* next = b->next;
+            if (b != keep)
+                ::operator delete(b);
+            b = next;
+        }
+        _head = NULL;
+    }
+};
+
+// alignment of T without alignof: padding the compiler puts after a char to place a T
+template <class T>
+struct alignment_of {
+    struct helper { char c; T t; };
+    static const size_t value = sizeof(helper) - sizeof(T);
+};
+
+template <class T>
+const size_t alignment_of<T>::value;
+
+template <class T>
+class arena_allocator
+{
+public:
+    typedef T               value_type;
+    typedef T*              pointer;
+    typedef const T*        const_pointer;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    template <class U>
+    struct rebind { typedef arena_allocator<U> other; };
+
+    explicit arena_allocator(ft::arena& a) : _arena(&a) {}
+    arena_allocator(const arena_allocator& src) : _arena(src.getArena()) {}
+    template <class U>
+    arena_allocator(const arena_allocator<U>& src) : _arena(src.getArena()) {}
+
+    arena_allocator& operator=(const arena_allocator& src) {
+        _arena = src._arena;
+        return (*this);
+    }
+
+    ft::arena* getArena() const { return _arena; }
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(size_type n, const void* = 0) {
+        if (n > max_size())
+            throw std::bad_alloc();
+        return static_cast<pointer>(_arena->allocate(n * sizeof(T), ft::alignment_of<T>::value));
+    }
+
+    void deallocate(pointer, size_type) {}
+
+    size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+    void construct(pointer p, const_reference val) { new (static_cast<void*>(p)) T(val); }
+    void destroy(pointer p) { p->~T(); }
+
+    friend bool operator==(const arena_allocator& lhs, const arena_allocator& rhs) { return lhs._arena == rhs._arena; }
+    friend bool operator!=(const arena_allocator& lhs, const arena_allocator& rhs) { return lhs._arena != rhs._arena; }
+
+private:
+    ft::arena* _arena;
+};
+
+template <class T>
+struct allocator_skips_teardown<arena_allocator<T> > { static const bool value = true; };
+
+}
+
+#endif
@@ -0,0 +1,105 @@
+#ifndef COW_PTR_H
+#define COW_PTR_H
+
+#include <cstddef>
+#include "../concurrency/atomic.hpp"
+
+namespace ft {
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::COW_PTR ----------------------- *
+    *
+    * One T shared by the copies of a handle until one of them writes,
+    * behind ft::cow_vector and ft::cow_map. Copying a handle bumps an
+    * atomic count; the first write through a shared handle copies T
+    * (detach) and leaves the other handles on the old one.
+    *
+    * read:         The T, never copied
+    * write:        The T, copied first if shared
+    * rewrite(e):   For writes replacing the whole content (assign,
+    *               clear): a shared T is not copied, the handle gets
+    *               its own copy of e instead
+    * use_count:    Handles on this T
+    *
+    * A reference out of write() is good until the handle is copied:
+    * the copy shares the T, and writing through the old reference
+    * would change both. Handles are values: a handle is used by one
+    * thread at a time, copies of it may live in other threads.
+    * ------------------------------------------------------------- *
+    */
+template <class T>
+class cow_ptr
+{
+public:
+    explicit cow_ptr(const T& value = T()) : _block(new block(value)) {}
+
+    cow_ptr(const cow_ptr& x) : _block(x.share()) {}
+
+    cow_ptr& operator=(const cow_ptr& x) {
+        block* b = x.share();
+        release();
+        _block = b;
+        return *this;
+    }
+
+    ~cow_ptr() { release(); }
+
+    const T& read() const { return _block->value; }
+
+    T& write() {
+        detach();
+        return _block->value;
+    }
+
+    T& rewrite(const T& empty) {
+        if (shared())
+        {
+            block* b = new block(empty);
+            release();
+            _block = b;
+        }
+        return _block->value;
+    }
+
+    size_t use_count() const { return atomic_load(&_block->refs); }
+    bool shared() const { return use_count() > 1; }
+
+    void swap(cow_ptr& x) {
+        block* tmp = _block;
+        _block = x._block;
+        x._block = tmp;
+    }
+
+private:
+    struct block {
+        T value;
+        size_t refs;
+
+        explicit block(const T& v) : value(v), refs(1) {}
+    };
+
+    block* _block;
+
+    block* share() const {
+        atomic_fetch_add(&_block->refs, static_cast<size_t>(1));
+        return _block;
+    }
+
+    void detach() {
+        if (!shared())
+            return;
+        block* b = new block(_block->value);
+        release();
+        _block = b;
+    }
+
+    // the last handle frees; acq_rel orders every other handle's reads before it
+    void release() {
+        if (atomic_fetch_add(&_block->refs, static_cast<size_t>(-1)) == 1)
+            delete _block;
+    }
+};
+
+}
+
+#endif
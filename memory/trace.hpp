@@ -0,0 +1,242 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <cstddef>
+#include <cstring>
+#include <ostream>
+#include <time.h>
+#include "../concurrency/atomic.hpp"
+
+// 1 makes ft::vector, ft::map and ft::stack record trace events; 0, the default, compiles the hooks away
+#ifndef FT_TRACE
+# define FT_TRACE 0
+#endif
+
+// slots per thread, the oldest events are overwritten; a power of two. The slot the
+// next event goes to is never read: FT_TRACE_RING - 1 events can be dumped
+#ifndef FT_TRACE_RING
+# define FT_TRACE_RING 4096
+#endif
+
+#if FT_TRACE
+# define FT_TRACE_EVENT(kind, object, a, b, c) ft::trace::record(ft::trace::kind, (object), (a), (b), (c))
+#else
+# define FT_TRACE_EVENT(kind, object, a, b, c) ((void)0)
+#endif
+
+namespace ft {
+
+struct trace_event {
+    unsigned long long time;        // ns, CLOCK_MONOTONIC
+    const void* object;             // the container
+    unsigned long long args[3];     // see trace::arg_name
+    unsigned int kind;
+    unsigned int thread;            // 0 for the first thread that recorded, then 1, 2...
+};
+
+/**
+    * ------------------------------------------------------------- *
+    * ------------------------- FT::TRACE ------------------------- *
+    *
+    * What the containers do to memory, built in with FT_TRACE=1:
+    *
+    * REALLOCATE      vector storage replaced: old capacity, new
+    *                 capacity, bytes moved from the old storage
+    * CLEAR           vector or map cleared: elements destroyed
+    * NODE_ALLOCATE   map node allocated: bytes
+    * NODE_FREE       map node freed: bytes
+    * REBALANCE       map tree rebuilt balanced (copies): nodes
+    * ATTACH          stack constructed: address of its container,
+    *                 whose events are the stack's
+    *
+    * Each thread writes to its own ring of FT_TRACE_RING events,
+    * created on its first event and never freed, so recording takes
+    * no lock and shares no cache line: a clock read and a release
+    * store. A reader may run at any time: it only reports the events
+    * the writer cannot have overwritten while they were copied.
+    *
+    * for_each(f):      f(const trace_event&) on every event kept,
+    *                   thread by thread, oldest first
+    * dump_json:        {"events": [{...}, ...], "dropped": n}
+    * dump_binary:      "FTTRACE1", event size and count as uint32,
+    *                   then the trace_event structs as they are in
+    *                   memory (this machine's layout and endianness)
+    * reset:            Forget every event; no thread may record
+    * ------------------------------------------------------------- *
+    */
+namespace trace {
+
+enum kind { REALLOCATE, CLEAR, NODE_ALLOCATE, NODE_FREE, REBALANCE, ATTACH, KINDS };
+
+inline const char* kind_name(unsigned int k)
+{
+    static const char* names[KINDS] = { "reallocate", "clear", "node_allocate", "node_free", "rebalance", "attach" };
+    return k < KINDS ? names[k] : "unknown";
+}
+
+// name of args[i] for kind k, NULL when unused
+inline const char* arg_name(unsigned int k, int i)
+{
+    static const char* names[KINDS][3] = {
+        { "old_capacity", "new_capacity", "bytes_moved" },
+        { "elements", NULL, NULL },
+        { "bytes", NULL, NULL },
+        { "bytes", NULL, NULL },
+        { "nodes", NULL, NULL },
+        { "container", NULL, NULL },
+    };
+    return k < KINDS ? names[k][i] : NULL;
+}
+
+struct ring {
+    trace_event events[FT_TRACE_RING];
+    // events ever written, the next one goes to head % FT_TRACE_RING
+    size_t head;
+    unsigned int thread;
+    ring* older;
+};
+
+// every ring, the newest first
+inline ring*& rings()
+{
+    static ring* newest = NULL;
+    return newest;
+}
+
+inline ring* createRing()
+{
+    static unsigned int threads = 0;
+    ring* r = new ring();
+    r->thread = atomic_fetch_add(&threads, 1U);
+    ring* newest = atomic_load(&rings());
+    do
+        r->older = newest;
+    while (!atomic_compare_exchange(&rings(), newest, r));
+    return r;
+}
+
+inline ring* threadRing()
+{
+    static __thread ring* mine = NULL;
+    if (!mine)
+        mine = createRing();
+    return mine;
+}
+
+inline void record(kind k, const void* object, unsigned long long a, unsigned long long b, unsigned long long c)
+{
+    ring* r = threadRing();
+    size_t head = r->head;
+    trace_event& e = r->events[head % FT_TRACE_RING];
+    // the slot is rewritten only once the head that retires its old event is visible
+    atomic_thread_fence_release();
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    e.time = ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+    e.object = object;
+    e.args[0] = a;
+    e.args[1] = b;
+    e.args[2] = c;
+    e.kind = k;
+    e.thread = r->thread;
+    atomic_store(&r->head, head + 1);
+}
+
+// calls f(const trace_event&) on the events kept; returns the number lost to overwriting
+template <class Function>
+size_t for_each(Function f)
+{
+    size_t dropped = 0;
+    for (ring* r = atomic_load(&rings()); r; r = r->older)
+    {
+        size_t head = atomic_load(&r->head);
+        size_t first = head >= FT_TRACE_RING ? head - FT_TRACE_RING + 1 : 0;
+        dropped += first;
+        for (size_t i = first; i < head; ++i)
+        {
+            trace_event e;
+            std::memcpy(&e, &r->events[i % FT_TRACE_RING], sizeof(e));
+            // the slot may have been rewritten while it was copied: event i + FT_TRACE_RING
+            // goes into it while head is still i + FT_TRACE_RING. The fence keeps the
+            // copy's reads before the load
+            atomic_thread_fence_acquire();
+            if (atomic_load(&r->head) - i >= FT_TRACE_RING)
+            {
+                ++dropped;
+                continue;
+            }
+            f(e);
+        }
+    }
+    return dropped;
+}
+
+inline void reset()
+{
+    for (ring* r = atomic_load(&rings()); r; r = r->older)
+        atomic_store(&r->head, static_cast<size_t>(0));
+}
+
+struct json_writer {
+    std::ostream* os;
+    bool first;
+
+    void operator()(const trace_event& e) {
+        *os << (first ? "\n" : ",\n") << "  {\"time\": " << e.time << ", \"thread\": " << e.thread
+            << ", \"kind\": \"" << kind_name(e.kind) << "\", \"object\": \"" << e.object << "\"";
+        for (int i = 0; i < 3; ++i)
+            if (arg_name(e.kind, i))
+            {
+                *os << ", \"" << arg_name(e.kind, i) << "\": ";
+                if (e.kind == ATTACH)
+                    *os << "\"" << reinterpret_cast<const void*>(static_cast<size_t>(e.args[i])) << "\"";
+                else
+                    *os << e.args[i];
+            }
+        *os << "}";
+        first = false;
+    }
+};
+
+inline void dump_json(std::ostream& os)
+{
+    json_writer writer = { &os, true };
+    os << "{\"events\": [";
+    size_t dropped = for_each<json_writer&>(writer);
+    os << "\n], \"dropped\": " << dropped << "}" << std::endl;
+}
+
+struct binary_writer {
+    std::ostream* os;
+    unsigned int count;
+
+    void operator()(const trace_event& e) {
+        os->write(reinterpret_cast<const char*>(&e), sizeof(e));
+        ++count;
+    }
+};
+
+inline void dump_binary(std::ostream& os)
+{
+    unsigned int size = sizeof(trace_event);
+    os.write("FTTRACE1", 8);
+    os.write(reinterpret_cast<const char*>(&size), sizeof(size));
+    std::streampos countAt = os.tellp();
+    unsigned int count = 0;
+    os.write(reinterpret_cast<const char*>(&count), sizeof(count));
+    binary_writer writer = { &os, 0 };
+    for_each<binary_writer&>(writer);
+    // a stream that cannot seek, a pipe say, keeps a count of 0: read until the end
+    if (countAt != std::streampos(-1))
+    {
+        os.seekp(countAt);
+        os.write(reinterpret_cast<const char*>(&writer.count), sizeof(writer.count));
+        os.seekp(0, std::ios_base::end);
+    }
+}
+
+}
+
+}
+
+#endif
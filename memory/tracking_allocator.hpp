@@ -0,0 +1,168 @@
+#ifndef TRACKING_ALLOCATOR_H
+#define TRACKING_ALLOCATOR_H
+
+#include <cstddef>
+#include <memory>
+#include <limits>
+#include <ostream>
+
+namespace ft {
+
+// counters of one tag; size class k counts the allocations of [2^k, 2^(k+1)) bytes
+struct allocation_stats {
+    static const size_t SIZE_CLASSES = 32;
+
+    size_t live_bytes;
+    size_t peak_bytes;
+    size_t allocations;
+    size_t frees;
+    size_t histogram[SIZE_CLASSES];
+
+    size_t live_blocks() const { return allocations - frees; }
+};
+
+/**
+    * ------------------------------------------------------------- *
+    * --------------------- FT::MEMORY_TELEMETRY ------------------ *
+    *
+    * Per tag allocation counters, fed by ft::tracking_allocator. The
+    * tag is any type, it only names the counters:
+    *
+    *     struct map_tag {};
+    *     ft::map<int, int, ft::less<int>, ft::tracking_allocator<ft::pair<const int, int>, map_tag> > m;
+    *     ft::memory_telemetry<map_tag>::stats().live_bytes;
+    *
+    * dump_every(n, &os) prints the counters to os after every n
+    * allocations of the tag. Counters are plain globals, not thread safe.
+    * ------------------------------------------------------------- *
+    */
+template <class Tag>
+class memory_telemetry
+{
+public:
+    static const allocation_stats& stats() { return state().stats; }
+
+    static void reset() {
+        state() = telemetry_state();
+    }
+
+    static void dump(std::ostream& os, const char* label = "") {
+        const allocation_stats& s = stats();
+        os << label << (*label ? ": " : "")
+           << "live " << s.live_bytes << " B in " << s.live_blocks() << " blocks"
+           << ", peak " << s.peak_bytes << " B"
+           << ", allocs " << s.allocations
+           << ", frees " << s.frees
+           << ", sizes";
+        for (size_t k = 0; k < allocation_stats::SIZE_CLASSES; ++k)
+            if (s.histogram[k])
+                os << " [" << (static_cast<size_t>(1) << k) << "," << (static_cast<size_t>(1) << (k + 1)) << "):" << s.histogram[k];
+        os << std::endl;
+    }
+
+    // 0 or NULL turns the periodic dump off
+    static void dump_every(size_t allocations, std::ostream* os, const char* label = "") {
+        state().period = allocations;
+        state().out = os;
+        state().label = label;
+    }
+
+    static void record_allocation(size_t bytes) {
+        telemetry_state& t = state();
+        t.stats.live_bytes += bytes;
+        if (t.stats.live_bytes > t.stats.peak_bytes)
+            t.stats.peak_bytes = t.stats.live_bytes;
+        ++t.stats.allocations;
+        ++t.stats.histogram[sizeClass(bytes)];
+        if (t.period && t.out && t.stats.allocations % t.period == 0)
+            dump(*t.out, t.label);
+    }
+
+    static void record_deallocation(size_t bytes) {
+        telemetry_state& t = state();
+        t.stats.live_bytes -= bytes;
+        ++t.stats.frees;
+    }
+
+private:
+    struct telemetry_state {
+        allocation_stats stats;
+        size_t period;
+        std::ostream* out;
+        const char* label;
+    };
+
+    static telemetry_state& state() {
+        static telemetry_state s;
+        return s;
+    }
+
+    static size_t sizeClass(size_t bytes) {
+        size_t k = 0;
+        while (bytes >>= 1)
+            ++k;
+        return k < allocation_stats::SIZE_CLASSES ? k : allocation_stats::SIZE_CLASSES - 1;
+    }
+};
+
+/**
+    * ------------------------------------------------------------- *
+    * -------------------- FT::TRACKING_ALLOCATOR ----------------- *
+    *
+    * std::allocator that reports every allocate/deallocate to
+    * ft::memory_telemetry<Tag>. Rebinding keeps the tag, so the nodes
+    * of a map are counted under the tag the map was declared with.
+    * ------------------------------------------------------------- *
+    */
+template <class T, class Tag>
+class tracking_allocator
+{
+public:
+    typedef T               value_type;
+    typedef T*              pointer;
+    typedef const T*        const_pointer;
+    typedef T&              reference;
+    typedef const T&        const_reference;
+    typedef size_t          size_type;
+    typedef ptrdiff_t       difference_type;
+
+    template <class U>
+    struct rebind { typedef tracking_allocator<U, Tag> other; };
+
+    tracking_allocator() {}
+    tracking_allocator(const tracking_allocator&) {}
+    template <class U>
+    tracking_allocator(const tracking_allocator<U, Tag>&) {}
+    ~tracking_allocator() {}
+
+    tracking_allocator& operator=(const tracking_allocator&) { return (*this); }
+
+    pointer address(reference x) const { return &x; }
+    const_pointer address(const_reference x) const { return &x; }
+
+    pointer allocate(size_type n, const void* hint = 0) {
+        pointer p = _alloc.allocate(n, hint);
+        memory_telemetry<Tag>::record_allocation(n * sizeof(T));
+        return p;
+    }
+
+    void deallocate(pointer p, size_type n) {
+        memory_telemetry<Tag>::record_deallocation(n * sizeof(T));
+        _alloc.deallocate(p, n);
+    }
+
+    size_type max_size() const { return std::numeric_limits<size_type>::max() / sizeof(T); }
+
+    void construct(pointer p, const_reference val) { _alloc.construct(p, val); }
+    void destroy(pointer p) { _alloc.destroy(p); }
+
+    friend bool operator==(const tracking_allocator&, const tracking_allocator&) { return true; }
+    friend bool operator!=(const tracking_allocator&, const tracking_allocator&) { return false; }
+
+private:
+    std::allocator<T> _alloc;
+};
+
+}
+
+#endif
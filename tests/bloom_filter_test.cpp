@@ -0,0 +1,97 @@
+#include <string>
+#include <vector>
+#include <cstdio>
+#include "check.hpp"
+#include "../containers/bloom_filter.hpp"
+#include "../containers/filtered_map.hpp"
+
+/*
+ * Copies of a filled ft::bloom_filter and ft::filtered_map still find
+ * every key inserted. Allocations of growing size between the copies
+ * put their buffers at other offsets in a cache line than the original.
+ */
+#define KEYS 5000
+#define OFFSETS 8
+
+static std::string makeKey(int i)
+{
+	char buf[32];
+	std::sprintf(buf, "key-%d", i);
+	return buf;
+}
+
+template <class Key> Key key(int i);
+template <> int key<int>(int i) { return i * 7919; }
+template <> std::string key<std::string>(int i) { return makeKey(i); }
+
+template <class Filter>
+static bool findsAll(const Filter& f)
+{
+	for (int i = 0; i < KEYS; ++i)
+		if (!f.may_contain(key<typename Filter::key_type>(i)))
+			return false;
+	return true;
+}
+
+template <class Map>
+static bool findsAllKeys(const Map& m)
+{
+	if (m.size() != KEYS)
+		return false;
+	for (int i = 0; i < KEYS; ++i)
+		if (!m.count(key<typename Map::key_type>(i)))
+			return false;
+	return true;
+}
+
+template <class Key>
+static void copiedFilter()
+{
+	ft::bloom_filter<Key> f(KEYS);
+	for (int i = 0; i < KEYS; ++i)
+		f.insert(key<Key>(i));
+	CHECK(findsAll(f));
+	std::vector<char*> pads;
+	for (int pad = 0; pad < OFFSETS; ++pad)
+	{
+		pads.push_back(new char[pad * sizeof(unsigned long long) + 1]);
+		ft::bloom_filter<Key> copy(f);
+		CHECK(findsAll(copy));
+		ft::bloom_filter<Key> assigned;
+		assigned = f;
+		CHECK(findsAll(assigned));
+		CHECK(assigned.size() == f.size() && assigned.bit_count() == f.bit_count());
+	}
+	for (size_t i = 0; i < pads.size(); ++i)
+		delete[] pads[i];
+}
+
+template <class Key>
+static void copiedMap()
+{
+	ft::filtered_map<Key, int> m;
+	for (int i = 0; i < KEYS; ++i)
+		m[key<Key>(i)] = i;
+	CHECK(findsAllKeys(m));
+	std::vector<char*> pads;
+	for (int pad = 0; pad < OFFSETS; ++pad)
+	{
+		pads.push_back(new char[pad * sizeof(unsigned long long) + 1]);
+		ft::filtered_map<Key, int> copy(m);
+		CHECK(findsAllKeys(copy));
+		ft::filtered_map<Key, int> assigned;
+		assigned = m;
+		CHECK(findsAllKeys(assigned));
+	}
+	for (size_t i = 0; i < pads.size(); ++i)
+		delete[] pads[i];
+}
+
+int main()
+{
+	copiedFilter<int>();
+	copiedFilter<std::string>();
+	copiedMap<int>();
+	copiedMap<std::string>();
+	return report("bloom_filter_test");
+}
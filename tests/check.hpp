@@ -0,0 +1,29 @@
+#ifndef TESTS_CHECK_H
+#define TESTS_CHECK_H
+
+#include <iostream>
+
+/*
+ * What every test under tests/ shares: CHECK reports a failed
+ * condition with its line and counts it, main returns
+ * report("name"), non-zero once a check failed.
+ */
+static int failures = 0;
+
+#define CHECK(cond) \
+	do { \
+		if (!(cond)) \
+		{ \
+			std::cerr << __FILE__ << ":" << __LINE__ << ": " << #cond << std::endl; \
+			++failures; \
+		} \
+	} while (0)
+
+static inline int report(const char* test)
+{
+	if (failures)
+		std::cerr << test << ": " << failures << " failure(s)" << std::endl;
+	return failures != 0;
+}
+
+#endif
@@ -0,0 +1,142 @@
+#include <new>
+#include <memory>
+#include <vector>
+#include <stdexcept>
+#include "check.hpp"
+#include "../containers/concurrent_stack.hpp"
+
+/*
+ * ft::concurrent_stack when a copy or the pool's allocation throws:
+ * the nodes taken go back to the freelist (the pool does not grow on
+ * the next pushes), the elements already built for a push_range are
+ * destroyed, and a failed grow leaves the lock free for the next one.
+ */
+static long budget = -1;
+static long live = 0;
+static bool failAllocations = false;
+
+struct element
+{
+	int value;
+
+	element(int v = 0) : value(v) { ++live; }
+	element(const element& x) : value(x.value) {
+		if (budget > 0 && --budget == 0)
+			throw std::runtime_error("copy");
+		++live;
+	}
+	element& operator=(const element& x) {
+		value = x.value;
+		return *this;
+	}
+	~element() { --live; }
+};
+
+template <class T>
+struct failing_allocator : std::allocator<T>
+{
+	template <class U> struct rebind { typedef failing_allocator<U> other; };
+
+	failing_allocator() {}
+	failing_allocator(const failing_allocator&) : std::allocator<T>() {}
+	template <class U> failing_allocator(const failing_allocator<U>&) {}
+
+	T* allocate(size_t n, const void* = 0) {
+		if (failAllocations)
+			throw std::bad_alloc();
+		return std::allocator<T>::allocate(n);
+	}
+};
+
+typedef ft::concurrent_stack<element, failing_allocator<element> > stack_type;
+
+// pushes n elements, pops them back, returns the pool's capacity in between
+static size_t fillAndDrain(stack_type& s, int n)
+{
+	for (int i = 0; i < n; ++i)
+		s.push(element(i));
+	size_t capacity = s.capacity();
+	element out;
+	int popped = 0;
+	while (s.try_pop(out))
+		++popped;
+	CHECK(popped == n);
+	return capacity;
+}
+
+static void throwingPush()
+{
+	stack_type s;
+	size_t capacity = fillAndDrain(s, 64);
+	for (int i = 0; i < 1000; ++i)
+	{
+		budget = 1;
+		try
+		{
+			s.push(element(i));
+			CHECK(false);
+		}
+		catch (std::runtime_error&) {}
+		budget = -1;
+	}
+	CHECK(s.empty());
+	CHECK(fillAndDrain(s, 64) == capacity);
+	CHECK(live == 0);
+}
+
+static void throwingPushRange()
+{
+	stack_type s;
+	size_t capacity = fillAndDrain(s, 64);
+	std::vector<element> range(10);
+	for (int i = 0; i < 200; ++i)
+	{
+		budget = 1 + i % 10;
+		try
+		{
+			s.push_range(range.begin(), range.end());
+			CHECK(false);
+		}
+		catch (std::runtime_error&) {}
+		budget = -1;
+		CHECK(s.empty());
+		CHECK(live == static_cast<long>(range.size()));
+	}
+	CHECK(fillAndDrain(s, 64) == capacity);
+	s.push_range(range.begin(), range.end());
+	element out;
+	int popped = 0;
+	while (s.try_pop(out))
+		++popped;
+	CHECK(popped == 10);
+}
+
+static void failedGrow()
+{
+	stack_type s;
+	failAllocations = true;
+	for (int i = 0; i < 2; ++i)
+	{
+		try
+		{
+			s.push(element(i));
+			CHECK(false);
+		}
+		catch (std::bad_alloc&) {}
+	}
+	failAllocations = false;
+	// deadlocks if the failed grow kept the lock
+	s.push(element(7));
+	element out;
+	CHECK(s.try_pop(out) && out.value == 7);
+	CHECK(s.empty());
+}
+
+int main()
+{
+	throwingPush();
+	throwingPushRange();
+	CHECK(live == 0);
+	failedGrow();
+	return report("concurrent_stack_test");
+}
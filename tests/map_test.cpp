@@ -0,0 +1,195 @@
+#include <map>
+#include <cstdlib>
+#include "check.hpp"
+#include "../containers/map.hpp"
+
+/*
+ * ft::map against std::map on random inserts and erases, with the
+ * copies, assignments and swaps between them: after every step the
+ * contents match and validate() holds (tree order, parent links, the
+ * next / prev chain and the end sentinel). Erase by iterator takes
+ * nodes with zero, one and two children, the first and the last.
+ */
+#define STEPS 20000
+#define KEYS 500
+
+typedef ft::map<int, int> ft_map;
+typedef std::map<int, int> std_map;
+
+static bool same(const ft_map& f, const std_map& s)
+{
+	const char* why = NULL;
+	if (!f.validate(&why))
+	{
+		std::cerr << "validate: " << (why ? why : "?") << std::endl;
+		return false;
+	}
+	if (f.size() != s.size())
+		return false;
+	ft_map::const_iterator fi = f.begin();
+	for (std_map::const_iterator si = s.begin(); si != s.end(); ++si, ++fi)
+		if (fi == f.end() || fi->first != si->first || fi->second != si->second)
+			return false;
+	if (fi != f.end())
+		return false;
+	// backwards through the prev links too
+	std_map::const_reverse_iterator sr = s.rbegin();
+	for (ft_map::const_reverse_iterator fr = f.rbegin(); fr != f.rend(); ++fr, ++sr)
+		if (sr == s.rend() || fr->first != sr->first)
+			return false;
+	return true;
+}
+
+static void step(ft_map& f, std_map& s, int r)
+{
+	int k = rand() % KEYS;
+	switch (r % 7)
+	{
+		case 0:
+		case 1:
+			f.insert(ft::make_pair(k, r));
+			s.insert(std::make_pair(k, r));
+			break;
+		case 2:
+			f[k] = r;
+			s[k] = r;
+			break;
+		case 3:
+			CHECK(f.erase(k) == s.erase(k));
+			break;
+		case 4:
+			if (!f.empty())
+			{
+				// the first, the last or a random node
+				int which = rand() % 3;
+				ft_map::iterator fit = f.begin();
+				std_map::iterator sit = s.begin();
+				if (which == 1)
+				{
+					fit = --f.end();
+					sit = --s.end();
+				}
+				else if (which == 2)
+				{
+					fit = f.lower_bound(k);
+					sit = s.lower_bound(k);
+					if (fit == f.end())
+						break;
+				}
+				f.erase(fit);
+				s.erase(sit);
+			}
+			break;
+		case 5:
+		{
+			ft_map::iterator ff = f.lower_bound(k);
+			ft_map::iterator fl = f.upper_bound(k + 20);
+			f.erase(ff, fl);
+			s.erase(s.lower_bound(k), s.upper_bound(k + 20));
+			break;
+		}
+		case 6:
+			CHECK((f.find(k) == f.end()) == (s.find(k) == s.end()));
+			CHECK(f.count(k) == s.count(k));
+			break;
+	}
+}
+
+static void randomOperations()
+{
+	ft_map f;
+	std_map s;
+	for (int r = 0; r < STEPS; ++r)
+	{
+		step(f, s, r);
+		if (!same(f, s))
+		{
+			CHECK(same(f, s));
+			return;
+		}
+	}
+}
+
+static void eraseDownToEmpty()
+{
+	ft_map f;
+	std_map s;
+	for (int i = 0; i < KEYS; ++i)
+	{
+		int k = rand();
+		f[k] = i;
+		s[k] = i;
+	}
+	while (!s.empty())
+	{
+		int k = s.begin()->first;
+		// alternate between the smallest, the largest and a middle key
+		if (s.size() % 3 == 1)
+			k = (--s.end())->first;
+		else if (s.size() % 3 == 2)
+		{
+			std_map::iterator mid = s.begin();
+			for (size_t i = 0; i < s.size() / 2; ++i)
+				++mid;
+			k = mid->first;
+		}
+		f.erase(f.find(k));
+		s.erase(k);
+		CHECK(same(f, s));
+	}
+	CHECK(f.empty() && f.begin() == f.end());
+	f[1] = 1;
+	s[1] = 1;
+	CHECK(same(f, s));
+}
+
+static void copyAssignSwap()
+{
+	for (int n = 0; n < 200; n += 7)
+	{
+		ft_map f;
+		std_map s;
+		for (int i = 0; i < n; ++i)
+		{
+			int k = rand() % (4 * n + 1);
+			f[k] = i;
+			s[k] = i;
+		}
+		ft_map copy(f);
+		CHECK(same(copy, s));
+		// the copy is a tree of its own: looked up, written and erased from
+		for (std_map::iterator it = s.begin(); it != s.end(); ++it)
+			CHECK(copy.find(it->first) != copy.end() && copy[it->first] == it->second);
+		std_map sCopy(s);
+		if (!s.empty())
+		{
+			copy.erase(copy.begin());
+			sCopy.erase(sCopy.begin());
+		}
+		copy[-1] = -1;
+		sCopy[-1] = -1;
+		CHECK(same(copy, sCopy));
+		CHECK(same(f, s));
+
+		ft_map assigned;
+		assigned[12345] = 1;
+		assigned = f;
+		CHECK(same(assigned, s));
+		const ft_map& self = assigned;
+		assigned = self;
+		CHECK(same(assigned, s));
+
+		f.swap(copy);
+		CHECK(same(f, sCopy));
+		CHECK(same(copy, s));
+	}
+}
+
+int main()
+{
+	srand(1);
+	randomOperations();
+	eraseDownToEmpty();
+	copyAssignSwap();
+	return report("map_test");
+}
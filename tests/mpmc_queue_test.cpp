@@ -0,0 +1,31 @@
+#include <string>
+#include "check.hpp"
+#include "../containers/mpmc_queue.hpp"
+
+/*
+ * ft::mpmc_queue at the smallest capacities: 0 and 1 get 2 slots, a
+ * push past them fails and nothing is overwritten.
+ */
+static void smallCapacity(size_t requested)
+{
+	ft::mpmc_queue<std::string> q(requested);
+	CHECK(q.capacity() == 2);
+	CHECK(q.try_push("a"));
+	CHECK(q.try_push("b"));
+	CHECK(!q.try_push("c"));
+	std::string out;
+	CHECK(q.try_pop(out) && out == "a");
+	CHECK(q.try_push("c"));
+	CHECK(q.try_pop(out) && out == "b");
+	CHECK(q.try_pop(out) && out == "c");
+	CHECK(!q.try_pop(out));
+	CHECK(q.empty());
+}
+
+int main()
+{
+	smallCapacity(0);
+	smallCapacity(1);
+	smallCapacity(2);
+	return report("mpmc_queue_test");
+}
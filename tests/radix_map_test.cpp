@@ -0,0 +1,187 @@
+#include <map>
+#include <string>
+#include <cstdlib>
+#include "check.hpp"
+#include "../containers/radix_map.hpp"
+
+/*
+ * ft::radix_map against std::map. String keys over a small alphabet,
+ * so many are prefixes of others and nodes split and collapse; keys
+ * fanning out over every byte value under long shared prefixes, so
+ * inner nodes grow up to node256 and shrink back; signed and unsigned
+ * integer keys, negative ones ordered before the others. After each
+ * round the iteration order, find, count and both bounds match, copies
+ * and swaps keep their own tree, and erasing everything leaves an
+ * empty map that takes new keys.
+ */
+#define STEPS 20000
+
+template <class Key>
+static bool same(const ft::radix_map<Key, int>& f, const std::map<Key, int>& s)
+{
+	if (f.size() != s.size() || f.empty() != s.empty())
+		return false;
+	typename ft::radix_map<Key, int>::const_iterator fi = f.begin();
+	for (typename std::map<Key, int>::const_iterator si = s.begin(); si != s.end(); ++si, ++fi)
+		if (fi == f.end() || !(fi->first == si->first) || fi->second != si->second)
+			return false;
+	if (fi != f.end())
+		return false;
+	// and back through the prev links
+	typename std::map<Key, int>::const_iterator si = s.end();
+	for (fi = f.end(); fi != f.begin(); )
+		if (!((--fi)->first == (--si)->first))
+			return false;
+	return true;
+}
+
+template <class Key>
+static bool sameLookups(const ft::radix_map<Key, int>& f, const std::map<Key, int>& s, const Key& k)
+{
+	typename ft::radix_map<Key, int>::const_iterator lower = f.lower_bound(k);
+	typename ft::radix_map<Key, int>::const_iterator upper = f.upper_bound(k);
+	typename std::map<Key, int>::const_iterator sLower = s.lower_bound(k);
+	typename std::map<Key, int>::const_iterator sUpper = s.upper_bound(k);
+	return f.count(k) == s.count(k)
+		&& (f.find(k) == f.end()) == (s.find(k) == s.end())
+		&& (lower == f.end() ? sLower == s.end() : sLower != s.end() && lower->first == sLower->first)
+		&& (upper == f.end() ? sUpper == s.end() : sUpper != s.end() && upper->first == sUpper->first);
+}
+
+// inserts, erases by key and by iterator, with a lookup of a random key after each
+template <class Key, class Generator>
+static void randomOperations(Generator next)
+{
+	ft::radix_map<Key, int> f;
+	std::map<Key, int> s;
+	for (int r = 0; r < STEPS; ++r)
+	{
+		Key k = next();
+		switch (r % 5)
+		{
+			case 0:
+			case 1:
+				CHECK(f.insert(ft::make_pair(k, r)).second == s.insert(std::make_pair(k, r)).second);
+				break;
+			case 2:
+				f[k] = r;
+				s[k] = r;
+				break;
+			case 3:
+				CHECK(f.erase(k) == s.erase(k));
+				break;
+			case 4:
+				if (f.find(k) != f.end())
+				{
+					f.erase(f.find(k));
+					s.erase(k);
+				}
+				break;
+		}
+		CHECK(sameLookups(f, s, next()));
+		if (r % 1000 == 0 && !same(f, s))
+		{
+			CHECK(same(f, s));
+			return;
+		}
+	}
+	CHECK(same(f, s));
+
+	ft::radix_map<Key, int> copy(f);
+	std::map<Key, int> sCopy(s);
+	CHECK(same(copy, s));
+	for (int i = 0; i < 200; ++i)
+	{
+		Key k = next();
+		copy[k] = -i;
+		sCopy[k] = -i;
+		Key e = next();
+		CHECK(copy.erase(e) == sCopy.erase(e));
+	}
+	CHECK(same(copy, sCopy));
+	CHECK(same(f, s));
+
+	ft::radix_map<Key, int> assigned;
+	assigned[next()] = 1;
+	assigned = f;
+	CHECK(same(assigned, s));
+	const ft::radix_map<Key, int>& self = assigned;
+	assigned = self;
+	CHECK(same(assigned, s));
+	assigned.swap(copy);
+	CHECK(same(assigned, sCopy));
+	CHECK(same(copy, s));
+
+	// erase down to empty, half by key, half by range
+	while (!s.empty())
+	{
+		Key k = s.begin()->first;
+		if (s.size() % 2)
+		{
+			typename std::map<Key, int>::iterator last = s.begin();
+			for (int i = 0; i < 5 && last != s.end(); ++i)
+				++last;
+			typename ft::radix_map<Key, int>::iterator fLast = last == s.end() ? f.end() : f.find(last->first);
+			f.erase(f.begin(), fLast);
+			s.erase(s.begin(), last);
+		}
+		else
+		{
+			CHECK(f.erase(k) == 1);
+			s.erase(k);
+		}
+		if (!same(f, s))
+		{
+			CHECK(same(f, s));
+			return;
+		}
+	}
+	CHECK(f.empty() && f.begin() == f.end());
+	Key k = next();
+	f[k] = 1;
+	s[k] = 1;
+	CHECK(same(f, s));
+	f.clear();
+	CHECK(f.empty() && f.begin() == f.end());
+}
+
+// short keys over "ab/": the empty key, "a", "ab", "a/b", "ab/a/"... many prefixes of others
+static std::string prefixKey()
+{
+	static const char alphabet[] = "ab/";
+	std::string k;
+	for (int n = rand() % 7; n > 0; --n)
+		k += alphabet[rand() % 3];
+	return k;
+}
+
+// a long shared prefix, then one of every byte value, then maybe more: node256 and back
+static std::string fanoutKey()
+{
+	std::string k(rand() % 2 ? "shared/prefix/longer/than/the/stored/part/" : "shared/");
+	k += static_cast<char>(rand() % 256);
+	if (rand() % 3 == 0)
+		k += static_cast<char>(rand() % 256);
+	return k;
+}
+
+static int signedKey() { return (rand() % 2001) - 1000; }
+static int wideSignedKey() { return static_cast<int>(static_cast<unsigned>(rand()) * 2654435761U); }
+static unsigned unsignedKey() { return static_cast<unsigned>(rand()) * 2654435761U; }
+static long long longKey() { return (static_cast<long long>(rand() % 512) - 256) << 40; }
+static unsigned char byteKey() { return static_cast<unsigned char>(rand()); }
+static signed char signedByteKey() { return static_cast<signed char>(rand()); }
+
+int main()
+{
+	srand(1);
+	randomOperations<std::string>(prefixKey);
+	randomOperations<std::string>(fanoutKey);
+	randomOperations<int>(signedKey);
+	randomOperations<int>(wideSignedKey);
+	randomOperations<unsigned>(unsignedKey);
+	randomOperations<long long>(longKey);
+	randomOperations<unsigned char>(byteKey);
+	randomOperations<signed char>(signedByteKey);
+	return report("radix_map_test");
+}
@@ -0,0 +1,188 @@
+#include <vector>
+#include <stdexcept>
+#include "check.hpp"
+#include "../containers/vector.hpp"
+#include "../containers/soa_vector.hpp"
+
+/*
+ * ft::vector and ft::soa_vector when a copy throws. Every copy
+ * constructor and assignment counts down a budget and throws when it
+ * runs out; after each throw, every element in the containers must be
+ * alive (constructed, not yet destroyed), each destroyed once, and the
+ * two soa_vector columns the same size. Without a throw, the vector
+ * matches std::vector.
+ */
+#define MAGIC 0x5AFE
+#define ROUNDS 400
+
+static long budget = -1;
+static long live = 0;
+static long badDestroys = 0;
+
+static void spend()
+{
+	if (budget > 0 && --budget == 0)
+		throw std::runtime_error("copy");
+}
+
+template <int Tag>
+struct element
+{
+	int value;
+	int alive;
+
+	element(int v = 0) : value(v), alive(MAGIC) { ++live; }
+	element(const element& x) : value(x.value), alive(MAGIC) {
+		spend();
+		++live;
+	}
+	element& operator=(const element& x) {
+		spend();
+		value = x.value;
+		return *this;
+	}
+	~element() {
+		if (alive != MAGIC)
+			++badDestroys;
+		alive = 0;
+		--live;
+	}
+	bool operator==(const element& x) const { return value == x.value; }
+	bool operator<(const element& x) const { return value < x.value; }
+};
+
+// shifted by assignment
+typedef element<0> copied;
+// shifted by memmove
+typedef element<1> relocated;
+
+namespace ft {
+template <> struct is_trivially_relocatable<relocated> { static const bool value = true; };
+}
+
+template <class V>
+static bool allAlive(const V& v)
+{
+	for (size_t i = 0; i < v.size(); ++i)
+		if (v[i].alive != MAGIC)
+			return false;
+	return true;
+}
+
+template <class V>
+static bool sameValues(const V& v, const std::vector<int>& ref)
+{
+	if (v.size() != ref.size())
+		return false;
+	for (size_t i = 0; i < ref.size(); ++i)
+		if (v[i].value != ref[i])
+			return false;
+	return true;
+}
+
+// one operation of round r on v and its reference, chosen and placed by r
+template <class V>
+static void vectorOp(V& v, std::vector<int>& ref, int r)
+{
+	typedef typename V::value_type T;
+	size_t at = v.empty() ? 0 : static_cast<size_t>(r * 7) % v.size();
+	T val(r);
+	switch (r % 6)
+	{
+		case 0: v.push_back(val); ref.push_back(r); break;
+		case 1: v.insert(v.begin() + at, val); ref.insert(ref.begin() + at, r); break;
+		case 2: v.insert(v.begin() + at, 3, val); ref.insert(ref.begin() + at, 3, r); break;
+		case 3: {
+			T range[5] = {T(r), T(r + 1), T(r + 2), T(r + 3), T(r + 4)};
+			int refRange[5] = {r, r + 1, r + 2, r + 3, r + 4};
+			v.insert(v.begin() + at, range, range + 5);
+			ref.insert(ref.begin() + at, refRange, refRange + 5);
+			break;
+		}
+		case 4: if (!v.empty()) { v.erase(v.begin() + at); ref.erase(ref.begin() + at); } break;
+		case 5: {
+			size_t end = std::min(v.size(), at + 4);
+			v.erase(v.begin() + at, v.begin() + end);
+			ref.erase(ref.begin() + at, ref.begin() + end);
+			break;
+		}
+	}
+}
+
+template <class T>
+static void vectorSurvivesThrows()
+{
+	ft::vector<T> v;
+	std::vector<int> ref;
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		budget = -1;
+		vectorOp(v, ref, r);
+		CHECK(sameValues(v, ref));
+	}
+	for (int r = 0; r < ROUNDS; ++r)
+	{
+		// after a throw the contents are unspecified: the reference only follows the size
+		ref.assign(v.size(), 0);
+		budget = 1 + r % 9;
+		try
+		{
+			vectorOp(v, ref, r);
+		}
+		catch (std::runtime_error&) {}
+		budget = -1;
+		CHECK(allAlive(v));
+		CHECK(live == static_cast<long>(v.size()));
+	}
+	v.clear();
+	CHECK(live == 0);
+	CHECK(badDestroys == 0);
+	badDestroys = 0;
+}
+
+template <class T>
+static void soaSurvivesThrows()
+{
+	typedef ft::soa_vector<ft::pair<T, T> > soa;
+	{
+		soa s;
+		for (int i = 0; i < 64; ++i)
+			s.push_back(ft::make_pair(T(i), T(i)));
+		for (int r = 0; r < ROUNDS; ++r)
+		{
+			size_t at = s.empty() ? 0 : static_cast<size_t>(r * 7) % s.size();
+			budget = 1 + r % 5;
+			try
+			{
+				switch (r % 5)
+				{
+					case 0: s.push_back(ft::make_pair(T(r), T(r))); break;
+					case 1: s.insert(s.begin() + at, ft::make_pair(T(r), T(r))); break;
+					case 2: if (!s.empty()) s.erase(s.begin() + at); break;
+					case 3: s.resize(s.size() + 3); break;
+					case 4: s.erase(s.begin() + at, s.begin() + std::min(s.size(), at + 3)); break;
+				}
+			}
+			catch (std::runtime_error&) {}
+			budget = -1;
+			// both columns take their length from size(): a shorter one shows as a dead or missing element
+			CHECK(allAlive(s.firsts()) && allAlive(s.seconds()));
+			CHECK(live == static_cast<long>(2 * s.size()));
+			if (s.size() < 16)
+				for (int i = 0; i < 64; ++i)
+					s.push_back(ft::make_pair(T(i), T(i)));
+		}
+	}
+	CHECK(live == 0);
+	CHECK(badDestroys == 0);
+	badDestroys = 0;
+}
+
+int main()
+{
+	vectorSurvivesThrows<copied>();
+	vectorSurvivesThrows<relocated>();
+	soaSurvivesThrows<copied>();
+	soaSurvivesThrows<relocated>();
+	return report("soa_vector_test");
+}
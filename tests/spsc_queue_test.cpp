@@ -0,0 +1,55 @@
+#include <pthread.h>
+#include "check.hpp"
+#include "../containers/spsc_queue.hpp"
+
+/*
+ * ft::spsc_queue::size and empty read from a third thread while the
+ * producer and the consumer run: always in [0, N], never a wrapped
+ * difference. Then, with both sides stopped, exact.
+ */
+#define ELEMENTS 200000
+#define SLOTS 64
+
+typedef ft::spsc_queue<int, SLOTS> queue_type;
+
+static queue_type queue;
+static volatile int done = 0;
+
+static void* produce(void*)
+{
+	for (int i = 0; i < ELEMENTS; ++i)
+		queue.push(i);
+	return NULL;
+}
+
+static void* consume(void*)
+{
+	int out;
+	for (int i = 0; i < ELEMENTS; ++i)
+	{
+		queue.pop(out);
+		CHECK(out == i);
+	}
+	done = 1;
+	return NULL;
+}
+
+int main()
+{
+	pthread_t producer;
+	pthread_t consumer;
+	pthread_create(&producer, NULL, produce, NULL);
+	pthread_create(&consumer, NULL, consume, NULL);
+	size_t outOfRange = 0;
+	while (!done)
+		if (queue.size() > SLOTS)
+			++outOfRange;
+	pthread_join(producer, NULL);
+	pthread_join(consumer, NULL);
+	CHECK(outOfRange == 0);
+	CHECK(queue.size() == 0 && queue.empty());
+	queue.push(1);
+	queue.push(2);
+	CHECK(queue.size() == 2 && !queue.empty());
+	return report("spsc_queue_test");
+}
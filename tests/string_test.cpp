@@ -0,0 +1,167 @@
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <cstring>
+#include "check.hpp"
+#include "../containers/string.hpp"
+#include "../containers/vector.hpp"
+
+/*
+ * ft::string against std::string. Random edits on lengths around the
+ * 23 char inline limit, so strings keep crossing between the small and
+ * the heap layout; appends, inserts and replaces whose source is the
+ * string itself; copies, assignments and swaps across both layouts;
+ * and ft::vector<ft::string> growing, inserting and erasing, where the
+ * strings are relocated with memcpy.
+ */
+#define STEPS 20000
+#define MAX_LENGTH 60
+
+static bool same(const ft::string& f, const std::string& s)
+{
+	return f.size() == s.size() && f.capacity() >= f.size() && f.c_str()[f.size()] == '\0'
+		&& !std::memcmp(f.data(), s.data(), s.size());
+}
+
+static std::string randomText(size_t n)
+{
+	std::string t;
+	for (size_t i = 0; i < n; ++i)
+		t += static_cast<char>('a' + rand() % 26);
+	return t;
+}
+
+// a position in [0, size]
+static size_t randomPos(size_t size) { return rand() % (size + 1); }
+
+static void edit(ft::string& f, std::string& s, int r)
+{
+	size_t pos = randomPos(s.size());
+	size_t len = rand() % 30;
+	std::string t = randomText(rand() % 30);
+	switch (r % 14)
+	{
+		case 0: f.append(t.c_str()); s.append(t); break;
+		case 1: f.push_back('x'); s.push_back('x'); break;
+		case 2: f.insert(pos, t.c_str()); s.insert(pos, t); break;
+		case 3: f.replace(pos, len, t.c_str()); s.replace(pos, len, t); break;
+		case 4: f.erase(pos, len); s.erase(pos, len); break;
+		case 5: f.resize(len, 'r'); s.resize(len, 'r'); break;
+		// the source is the string itself
+		case 6: f.append(f); s.append(std::string(s)); break;
+		case 7: f.append(f.data() + pos, s.size() - pos); s.append(std::string(s, pos)); break;
+		case 8: f.insert(pos, f); s.insert(pos, std::string(s)); break;
+		case 9: {
+			size_t n = std::min(len, s.size() - pos);
+			f.replace(0, len, f.data() + pos, n);
+			s.replace(0, len, std::string(s, pos, n));
+			break;
+		}
+		case 10: f += f.c_str() + pos; s += std::string(s, pos); break;
+		case 11: f.assign(f, pos, len); s = std::string(s, pos, len); break;
+		case 12: f.reserve(len * 3); s.reserve(len * 3); break;
+		case 13: f.append(len, 'c'); s.append(len, 'c'); break;
+	}
+	// keep the lengths around the inline limit
+	if (s.size() > MAX_LENGTH)
+	{
+		size_t keep = rand() % MAX_LENGTH;
+		f.erase(keep);
+		s.erase(keep);
+	}
+}
+
+static void randomEdits()
+{
+	ft::string f;
+	std::string s;
+	for (int r = 0; r < STEPS; ++r)
+	{
+		edit(f, s, r);
+		if (!same(f, s))
+		{
+			CHECK(same(f, s));
+			return;
+		}
+		std::string needle = s.size() > 3 ? s.substr(rand() % (s.size() - 2), 2) : "ab";
+		CHECK(f.find(needle.c_str()) == s.find(needle));
+		CHECK(f.rfind(needle.c_str()) == s.rfind(needle));
+		CHECK(f.find_first_of("aeiou") == s.find_first_of("aeiou"));
+		CHECK(f.find_last_of("aeiou") == s.find_last_of("aeiou"));
+	}
+}
+
+static void everyLength()
+{
+	for (size_t n = 0; n <= MAX_LENGTH; ++n)
+	{
+		std::string s = randomText(n);
+		ft::string f(s.c_str());
+		CHECK(same(f, s));
+		ft::string copy(f);
+		CHECK(same(copy, s));
+		// copies own their characters
+		if (n)
+		{
+			copy[0] = '#';
+			CHECK(same(f, s));
+		}
+		for (size_t m = 0; m <= MAX_LENGTH; m += 5)
+		{
+			std::string t = randomText(m);
+			ft::string g(t.c_str());
+			ft::string assigned(g);
+			assigned = f;
+			CHECK(same(assigned, s));
+			const ft::string& self = assigned;
+			assigned = self;
+			CHECK(same(assigned, s));
+			CHECK((f < g) == (s < t));
+			CHECK((f.compare(g) < 0) == (s.compare(t) < 0));
+			CHECK((f == g) == (s == t));
+			g.swap(assigned);
+			CHECK(same(g, s));
+			CHECK(same(assigned, t));
+		}
+	}
+}
+
+static void vectorOfStrings()
+{
+	ft::vector<ft::string> f;
+	std::vector<std::string> s;
+	for (int i = 0; i < 2000; ++i)
+	{
+		std::string t = randomText(rand() % 50);
+		f.push_back(ft::string(t.c_str()));
+		s.push_back(t);
+		if (i % 7 == 3)
+		{
+			size_t pos = randomPos(s.size());
+			f.insert(f.begin() + pos, ft::string(t.c_str()));
+			s.insert(s.begin() + pos, t);
+		}
+		if (i % 11 == 5)
+		{
+			size_t pos = rand() % s.size();
+			f.erase(f.begin() + pos);
+			s.erase(s.begin() + pos);
+		}
+	}
+	CHECK(f.size() == s.size());
+	for (size_t i = 0; i < s.size(); ++i)
+		CHECK(same(f[i], s[i]));
+	ft::vector<ft::string> copy(f);
+	f.clear();
+	for (size_t i = 0; i < s.size(); ++i)
+		CHECK(same(copy[i], s[i]));
+}
+
+int main()
+{
+	srand(1);
+	randomEdits();
+	everyLength();
+	vectorOfStrings();
+	return report("string_test");
+}
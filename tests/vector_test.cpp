@@ -0,0 +1,65 @@
+#include <stdexcept>
+#include "check.hpp"
+#include "../containers/vector.hpp"
+
+/*
+ * ft::vector::append_from: only the elements the writer says it wrote
+ * are kept, and none when it throws.
+ */
+struct countingWriter
+{
+	size_t count;
+
+	size_t operator()(int* tail, size_t maxCount) const {
+		for (size_t i = 0; i < count && i < maxCount; ++i)
+			tail[i] = static_cast<int>(100 + i);
+		return count;
+	}
+};
+
+struct throwingWriter
+{
+	size_t operator()(int* tail, size_t maxCount) const {
+		for (size_t i = 0; i < maxCount; ++i)
+			tail[i] = -1;
+		throw std::runtime_error("read");
+	}
+};
+
+static void keepsWhatWasWritten()
+{
+	ft::vector<int> v(3, 7);
+	countingWriter three = { 3 };
+	CHECK(v.append_from(10, three) == 3);
+	CHECK(v.size() == 6);
+	CHECK(v[2] == 7 && v[3] == 100 && v[5] == 102);
+	// a writer claiming more than it was offered is cut to maxCount
+	countingWriter tooMany = { 50 };
+	CHECK(v.append_from(4, tooMany) == 4);
+	CHECK(v.size() == 10 && v[9] == 103);
+}
+
+static void dropsAllOnThrow()
+{
+	ft::vector<int> v(3, 7);
+	bool thrown = false;
+	try
+	{
+		v.append_from(1000, throwingWriter());
+	}
+	catch (std::runtime_error&)
+	{
+		thrown = true;
+	}
+	CHECK(thrown);
+	CHECK(v.size() == 3);
+	CHECK(v[0] == 7 && v[2] == 7);
+	CHECK(v.capacity() >= 1003);
+}
+
+int main()
+{
+	keepsWhatWasWritten();
+	dropsAllOnThrow();
+	return report("vector_test");
+}
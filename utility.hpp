@@ -51,6 +51,58 @@ struct is_integral<unsigned long> { static const bool value = true; };
 template <>
 struct is_integral<unsigned long long> { static const bool value = true; };
 
+template <typename T>
+struct is_floating_point { static const bool value = false; };
+
+template <>
+struct is_floating_point<float> { static const bool value = true; };
+
+template <>
+struct is_floating_point<double> { static const bool value = true; };
+
+template <>
+struct is_floating_point<long double> { static const bool value = true; };
+
+template <typename T>
+struct is_arithmetic { static const bool value = is_integral<T>::value || is_floating_point<T>::value; };
+
+template <typename T>
+struct is_trivially_destructible {
+#if defined(__clang__)
+    static const bool value = __is_trivially_destructible(T);
+#elif defined(__GNUC__)
+    static const bool value = __has_trivial_destructor(T);
+#else
+    static const bool value = is_arithmetic<T>::value;
+#endif
+};
+
+// types whose bytes are their whole value: copied with memcpy, written to a file and read back
+template <typename T>
+struct is_trivially_copyable {
+#if defined(__clang__)
+    static const bool value = __is_trivially_copyable(T);
+#elif defined(__GNUC__)
+    static const bool value = __has_trivial_copy(T) && __has_trivial_assign(T) && __has_trivial_destructor(T);
+#else
+    static const bool value = is_arithmetic<T>::value;
+#endif
+};
+
+// types whose objects can be moved to new storage with memcpy, the old bytes then dropped
+// without running the destructor; containers that grow relocate them in bulk. Arithmetic
+// types and pointers are, a class opts in by specializing this (no pointer into itself)
+template <class T>
+struct is_trivially_relocatable { static const bool value = is_arithmetic<T>::value; };
+
+template <class T>
+struct is_trivially_relocatable<T*> { static const bool value = true; };
+
+// allocators whose deallocate is a no-op (memory is reclaimed in bulk) specialize this to true,
+// containers then skip per-element teardown of trivially destructible elements
+template <class Alloc>
+struct allocator_skips_teardown { static const bool value = false; };
+
 template <class T>
 struct iterator_traits
 {
@@ -71,6 +123,57 @@ struct iterator_traits<T*>
     typedef std::ptrdiff_t                  difference_type;
 };
 
+template <class InputIterator>
+typename iterator_traits<InputIterator>::difference_type
+    distanceByTag(InputIterator first, InputIterator last, std::input_iterator_tag)
+{
+    typename iterator_traits<InputIterator>::difference_type n = 0;
+    for (; first != last; ++first)
+        ++n;
+    return n;
+}
+
+template <class RandomAccessIterator>
+typename iterator_traits<RandomAccessIterator>::difference_type
+    distanceByTag(RandomAccessIterator first, RandomAccessIterator last, std::random_access_iterator_tag)
+{
+    return last - first;
+}
+
+template <class InputIterator>
+typename iterator_traits<InputIterator>::difference_type distance(InputIterator first, InputIterator last)
+{
+    return distanceByTag(first, last, typename iterator_traits<InputIterator>::iterator_category());
+}
+
+template <class InputIterator, class Distance>
+void advanceByTag(InputIterator& it, Distance n, std::input_iterator_tag)
+{
+    for (; n > 0; --n)
+        ++it;
+}
+
+template <class BidirectionalIterator, class Distance>
+void advanceByTag(BidirectionalIterator& it, Distance n, std::bidirectional_iterator_tag)
+{
+    for (; n > 0; --n)
+        ++it;
+    for (; n < 0; ++n)
+        --it;
+}
+
+template <class RandomAccessIterator, class Distance>
+void advanceByTag(RandomAccessIterator& it, Distance n, std::random_access_iterator_tag)
+{
+    it += n;
+}
+
+template <class InputIterator, class Distance>
+void advance(InputIterator& it, Distance n)
+{
+    advanceByTag(it, n, typename iterator_traits<InputIterator>::iterator_category());
+}
+
 template <class T1, class T2>
 struct pair
 {
@@ -89,7 +192,6 @@ struct pair
         template <typename U, typename V>
         pair(const pair<U, V>& copy) : first(copy.first), second(copy.second) {};
 
-        ~pair() {};
 
         pair& operator=(const pair & rhs) {
             
@@ -102,27 +204,27 @@ struct pair
         
 
         
-        bool operator== (const pair<T1,T2>& rhs)
+        bool operator== (const pair<T1,T2>& rhs) const
         { return this->first==rhs.first && this->second==rhs.second; }
 
         
-        bool operator!= (const pair<T1,T2>& rhs)
+        bool operator!= (const pair<T1,T2>& rhs) const
         { return !(*this==rhs); }
 
         
-        bool operator<  (const pair<T1,T2>& rhs)
+        bool operator<  (const pair<T1,T2>& rhs) const
         { return this->first<rhs.first || (!(rhs.first<this->first) && this->second<rhs.second); }
 
         
-        bool operator<= (const pair<T1,T2>& rhs)
+        bool operator<= (const pair<T1,T2>& rhs) const
         { return !(rhs<*this); }
 
         
-        bool operator>  (const pair<T1,T2>& rhs)
+        bool operator>  (const pair<T1,T2>& rhs) const
         { return rhs<*this; }
 
         
-        bool operator>= (const pair<T1,T2>& rhs)
+        bool operator>= (const pair<T1,T2>& rhs) const
         { return !(*this<rhs); }
 };
 
@@ -166,6 +268,24 @@ template <class T> struct less : std::binary_function <T,T,bool> {
 
   bool operator() (const T& x, const T& y) const {return x<y;}
 };
+
+template <class T> struct greater : std::binary_function <T,T,bool> {
+
+    typedef T       first_argument_type;
+    typedef T       second_argument_type;
+    typedef bool    result_type;
+
+  bool operator() (const T& x, const T& y) const {return x>y;}
+};
+
+template <class T> struct plus : std::binary_function <T,T,T> {
+
+    typedef T       first_argument_type;
+    typedef T       second_argument_type;
+    typedef T       result_type;
+
+  T operator() (const T& x, const T& y) const {return x+y;}
+};
 }
 
 #endif